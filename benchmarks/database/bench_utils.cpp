@@ -0,0 +1,219 @@
+#include "database/utils.hpp"
+#include "fixtures.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+/**
+ * @brief Compares a Food against an id in both directions for binary_find
+ */
+struct CompareId {
+  auto operator()(Food const &food, int id) const -> bool
+  {
+    return food.id() < id;
+  }
+
+  auto operator()(int id, Food const &food) const -> bool
+  {
+    return id < food.id();
+  }
+};
+
+auto random_id(size_t num_rows) -> int
+{
+  static std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(1,
+                                                  static_cast<int>(num_rows));
+  return distribution(generator);
+}
+
+} // namespace
+
+static void BM_Make(benchmark::State &state)
+{
+  fixtures::use_food_table(state.range(0), fixtures::backend(state));
+  Macronutrients const macros(Fat(1), Carbohydrate(2, Fiber(1)), Protein(3));
+
+  for (auto _ : state) {
+    auto &food = utils::make<Food>("benchmark", macros);
+
+    // Keep the table at the same size for the next iteration
+    state.PauseTiming();
+    utils::delete_storable(food);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_Make)->Apply(fixtures::table_sizes);
+
+static void BM_Update(benchmark::State &state)
+{
+  size_t const num_rows = state.range(0);
+  fixtures::use_food_table(num_rows, fixtures::backend(state));
+  auto &all_food = utils::retrieve_all<Food>();
+
+  for (auto _ : state) {
+    utils::update(all_food[random_id(num_rows) - 1]);
+  }
+}
+BENCHMARK(BM_Update)->Apply(fixtures::table_sizes);
+
+static void BM_DeleteStorable(benchmark::State &state)
+{
+  size_t const num_rows = state.range(0);
+  fixtures::use_food_table(num_rows, fixtures::backend(state));
+  auto &all_food = utils::retrieve_all<Food>();
+
+  for (auto _ : state) {
+    auto const &food = all_food[random_id(num_rows) - 1];
+    std::string const name(food.name());
+    auto const macros = food.macronutrients();
+
+    utils::delete_storable(food);
+
+    // make reuses the deleted id, keeping the table the same
+    state.PauseTiming();
+    utils::make<Food>(name, macros);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_DeleteStorable)->Apply(fixtures::table_sizes);
+
+static void BM_RetrieveAll(benchmark::State &state)
+{
+  fixtures::use_food_table(state.range(0), fixtures::backend(state));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    utils::clear_cache<Food>();
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(utils::retrieve_all<Food>());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RetrieveAll)->Apply(fixtures::table_sizes);
+
+static void BM_RetrieveAllParallel(benchmark::State &state)
+{
+  // Read connections only see a database on disk
+  fixtures::use_food_table(state.range(0), fixtures::Backend::DISK);
+  utils::set_load_threads(state.range(1));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    utils::clear_cache<Food>();
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(utils::retrieve_all<Food>());
+  }
+
+  utils::set_load_threads(1);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RetrieveAllParallel)
+    ->Apply([](benchmark::internal::Benchmark *benchmark) {
+      for (long rows : {100000, 1000000}) {
+        for (long threads : {1, 2, 4, 8, 16}) {
+          benchmark->Args({rows, threads});
+        }
+      }
+      benchmark->ArgNames({"rows", "threads"});
+    })
+    ->UseRealTime();
+
+static void BM_GetNewId(benchmark::State &state)
+{
+  fixtures::use_food_table(state.range(0), fixtures::backend(state));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::get_new_id<Food>());
+  }
+}
+BENCHMARK(BM_GetNewId)->Apply(fixtures::table_sizes);
+
+static void BM_BinaryFind(benchmark::State &state)
+{
+  size_t const num_rows = state.range(0);
+  fixtures::use_food_table(num_rows, fixtures::backend(state));
+  auto &all_food = utils::retrieve_all<Food>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::binary_find(begin(all_food),
+                                                end(all_food),
+                                                random_id(num_rows),
+                                                CompareId{}));
+  }
+}
+BENCHMARK(BM_BinaryFind)->Apply(fixtures::table_sizes);
+
+/**
+ * @brief Sorts cached foods by id, reading the id through a Base pointer.
+ *        With Base = Food the id is read inline, with Base = Storable every
+ *        comparison is a virtual call, as it was before Food was final.
+ */
+template <typename Base> static void BM_SortById(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+
+  std::vector<Base const *> shuffled;
+  shuffled.reserve(foods.size());
+  for (auto const &food : foods) {
+    shuffled.push_back(&food);
+  }
+  std::shuffle(begin(shuffled), end(shuffled), std::mt19937(42));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto sorted = shuffled;
+    state.ResumeTiming();
+
+    std::sort(begin(sorted), end(sorted), [](Base const *lhs, Base const *rhs) {
+      return lhs->id() < rhs->id();
+    });
+    benchmark::DoNotOptimize(sorted.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SortById, Food)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_SortById, database::Storable)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+/**
+ * @brief The lower_bound every lookup in the cache does, with the id read
+ *        through a Base reference like BM_SortById
+ */
+template <typename Base> static void BM_LowerBoundById(benchmark::State &state)
+{
+  size_t const num_foods = state.range(0);
+  auto const foods = fixtures::make_foods(num_foods);
+
+  auto const compare = [](Base const &food, int id) { return food.id() < id; };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::lower_bound(
+        begin(foods), end(foods), random_id(num_foods), compare));
+  }
+}
+BENCHMARK_TEMPLATE(BM_LowerBoundById, Food)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_LowerBoundById, database::Storable)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
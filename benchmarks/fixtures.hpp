@@ -0,0 +1,165 @@
+/**
+ * @file fixtures.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Shared setup for benchmarks that need a populated database
+ */
+
+#pragma once
+
+#include "database/Data.hpp"
+#include "database/Database.hpp"
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Setup shared by all benchmarks
+ */
+namespace fixtures {
+
+/**
+ * @brief Where the SQLite database the benchmark runs against lives
+ */
+enum class Backend { MEMORY, DISK };
+
+/**
+ * @return The backend the benchmark was registered with, see table_sizes
+ */
+inline auto backend(benchmark::State const &state) -> Backend
+{
+  return state.range(1) == 0 ? Backend::MEMORY : Backend::DISK;
+}
+
+/**
+ * @brief Registers every combination of 10^3 - 10^6 rows with an in memory and
+ *        an on disk database.
+ *
+ * Usage:
+ * @n BENCHMARK(BM_Something)->Apply(fixtures::table_sizes);
+ */
+inline void table_sizes(benchmark::internal::Benchmark *benchmark)
+{
+  for (auto const backend : {Backend::MEMORY, Backend::DISK}) {
+    for (long rows = 1000; rows <= 1000000; rows *= 10) {
+      benchmark->Args({rows, static_cast<long>(backend)});
+    }
+  }
+
+  benchmark->ArgNames({"rows", "disk"});
+}
+
+/**
+ * @brief Points the database connection to a Food table with exactly
+ *        num_rows rows and loads them into the cache.
+ *
+ * The table is only rebuilt when the number of rows or the backend differ
+ * from the last call, benchmarks that modify the table must restore it.
+ */
+inline void use_food_table(size_t num_rows, Backend backend)
+{
+  namespace utils = database::utils;
+
+  static size_t current_rows = 0;
+  static auto current_backend = Backend::MEMORY;
+  static bool connected = false;
+
+  if (connected && current_rows == num_rows && current_backend == backend) {
+    return;
+  }
+
+  utils::clear_cache<food::Food>();
+
+  if (!connected || current_backend != backend) {
+    database::Database::connect(backend == Backend::MEMORY
+                                    ? "db=:memory:"
+                                    : "db=tracker_benchmark.db timeout=2");
+  }
+
+  auto &sql_connection = database::Database::get_connection();
+  sql_connection << "DROP TABLE IF EXISTS Food";
+
+  // Same schema food::Food::get_data produces
+  using database::Constraint;
+  using database::DataType;
+  std::vector<database::ColumnProperties> const schema = {
+      {"Food_id", DataType::INTEGER, Constraint::PRIMARY_KEY},
+      {"name", DataType::TEXT, Constraint::NOT_NULL},
+      {"fat", DataType::REAL, Constraint::NOT_NULL},
+      {"carbohydrate", DataType::REAL, Constraint::NOT_NULL},
+      {"fiber", DataType::REAL, Constraint::NOT_NULL},
+      {"protein", DataType::REAL, Constraint::NOT_NULL}};
+
+  utils::create_table<food::Food>(schema);
+
+  // Bulk insert in chunks, making the rows one by one through utils::make
+  // would take longer than the benchmarks themselves
+  size_t const chunk_size = 10000;
+  std::vector<int> ids;
+  std::vector<std::string> names;
+  std::vector<double> quantities;
+
+  soci::transaction transaction(sql_connection);
+  for (size_t first = 0; first < num_rows; first += chunk_size) {
+    size_t const last = std::min(first + chunk_size, num_rows);
+
+    ids.clear();
+    names.clear();
+    quantities.clear();
+    for (size_t i = first; i < last; ++i) {
+      ids.push_back(static_cast<int>(i + 1));
+      names.push_back("food " + std::to_string(i + 1));
+      quantities.push_back(static_cast<double>(i % 100));
+    }
+
+    sql_connection << "INSERT INTO Food "
+                      "(Food_id, name, fat, carbohydrate, fiber, protein) "
+                      "VALUES (:id, :name, :fat, :carb, :fiber, :protein)",
+        soci::use(ids), soci::use(names), soci::use(quantities),
+        soci::use(quantities), soci::use(quantities), soci::use(quantities);
+  }
+  transaction.commit();
+
+  utils::clear_cache<food::Food>();
+  utils::retrieve_all<food::Food>();
+
+  current_rows = num_rows;
+  current_backend = backend;
+  connected = true;
+}
+
+/**
+ * @brief A vector of foods like the one the database cache holds
+ */
+using food_vector_t = std::vector<food::Food, food::Food::Allocator>;
+
+/**
+ * @brief Builds num_foods foods in memory the same way the database cache
+ *        does, without touching the database.
+ */
+inline auto make_foods(size_t num_foods) -> food_vector_t
+{
+  using namespace food;
+
+  food_vector_t foods;
+  foods.reserve(num_foods);
+
+  for (size_t i = 0; i < num_foods; ++i) {
+    double const quantity = i % 100;
+    Macronutrients const macros(Fat(quantity),
+                                Carbohydrate(quantity, Fiber(quantity)),
+                                Protein(quantity));
+
+    foods.emplace_back(static_cast<int>(i + 1),
+                       "food " + std::to_string(i + 1), macros);
+  }
+
+  return foods;
+}
+
+} // namespace fixtures
@@ -0,0 +1,120 @@
+#include "database/Data.hpp"
+#include "database/Interner.hpp"
+#include "fixtures.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+/**
+ * @brief Heap allocations made by the whole program so far
+ */
+std::atomic<size_t> num_allocations{0};
+
+} // namespace
+
+// Counts every heap allocation so benchmarks can report allocator traffic
+auto operator new(size_t size) -> void *
+{
+  ++num_allocations;
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) { return memory; }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+  std::free(memory);
+}
+
+static void BM_GetData(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+
+  for (auto _ : state) {
+    for (auto const &food : foods) {
+      benchmark::DoNotOptimize(food.get_data());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetData)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_SetData(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+
+  // The rows retrieve_all would hand to the Food constructor
+  std::vector<database::ColumnProperties> const schema =
+      foods.front().get_data().schema;
+  std::vector<database::Row> rows;
+  rows.reserve(foods.size());
+  for (auto const &food : foods) {
+    rows.emplace_back(food.get_data().rows.front());
+  }
+
+  size_t const allocations_before = num_allocations;
+
+  for (auto _ : state) {
+    fixtures::food_vector_t decoded;
+    decoded.reserve(rows.size());
+
+    // Constructing from a row goes through Food::set_data
+    for (auto const &row : rows) {
+      decoded.emplace_back(schema, row);
+    }
+
+    benchmark::DoNotOptimize(decoded.data());
+  }
+
+  // Decoding a row should not touch the heap beyond the cache itself, this
+  // stays close to zero unless set_data regresses
+  double const num_rows = state.iterations() * state.range(0);
+  state.counters["allocations_per_row"] =
+      (num_allocations - allocations_before) / num_rows;
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SetData)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_ScanFoods(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+
+  for (auto _ : state) {
+    double protein = 0;
+    size_t name_length = 0;
+    for (auto const &food : foods) {
+      protein += food.macronutrients().protein();
+      name_length += food.name().size();
+    }
+    benchmark::DoNotOptimize(protein);
+    benchmark::DoNotOptimize(name_length);
+  }
+
+  // Names are shared, so the interner is spread over every food. It also
+  // holds the names of earlier runs, which only overstates the cost.
+  double const num_foods = state.range(0);
+  state.counters["bytes_per_food"] =
+      sizeof(food::Food) + database::name_interner().bytes() / num_foods;
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanFoods)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
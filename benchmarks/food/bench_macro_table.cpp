@@ -0,0 +1,144 @@
+#include "fixtures.hpp"
+#include "food/Food.hpp"
+#include "food/MacroTable.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+/**
+ * @brief A portion of every food, in grams
+ */
+auto make_portions(size_t num_foods) -> std::vector<double>
+{
+  std::vector<double> grams(num_foods);
+  for (size_t i = 0; i < num_foods; ++i) {
+    grams[i] = 50 + i % 200;
+  }
+  return grams;
+}
+
+} // namespace
+
+static void BM_ScalarKcal(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+  std::vector<double> kcal(foods.size());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < foods.size(); ++i) {
+      kcal[i] = foods[i].macronutrients().kcal();
+    }
+    benchmark::DoNotOptimize(kcal.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarKcal)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_TableKcal(benchmark::State &state)
+{
+  auto const table = MacroTable::from(fixtures::make_foods(state.range(0)));
+  std::vector<double> kcal(table.size());
+
+  for (auto _ : state) {
+    table.kcal(kcal.data());
+    benchmark::DoNotOptimize(kcal.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableKcal)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_ScalarTotals(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+  auto const grams = make_portions(foods.size());
+
+  for (auto _ : state) {
+    double fat = 0;
+    double carbohydrate = 0;
+    double fiber = 0;
+    double protein = 0;
+
+    for (size_t i = 0; i < foods.size(); ++i) {
+      auto const &macros = foods[i].macronutrients();
+      fat += grams[i] * macros.fat();
+      carbohydrate += grams[i] * macros.carbohydrate();
+      fiber += grams[i] * macros.fiber();
+      protein += grams[i] * macros.protein();
+    }
+
+    benchmark::DoNotOptimize(fat);
+    benchmark::DoNotOptimize(carbohydrate);
+    benchmark::DoNotOptimize(fiber);
+    benchmark::DoNotOptimize(protein);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarTotals)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_TableTotals(benchmark::State &state)
+{
+  auto const table = MacroTable::from(fixtures::make_foods(state.range(0)));
+  auto const grams = make_portions(table.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.totals(grams));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableTotals)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_ScalarTotalKcal(benchmark::State &state)
+{
+  auto const foods = fixtures::make_foods(state.range(0));
+  auto const grams = make_portions(foods.size());
+
+  for (auto _ : state) {
+    double total = 0;
+    for (size_t i = 0; i < foods.size(); ++i) {
+      total += grams[i] * foods[i].macronutrients().kcal();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarTotalKcal)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_TableTotalKcal(benchmark::State &state)
+{
+  auto const table = MacroTable::from(fixtures::make_foods(state.range(0)));
+  auto const grams = make_portions(table.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.total_kcal(grams));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableTotalKcal)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_TableRatios(benchmark::State &state)
+{
+  auto const table = MacroTable::from(fixtures::make_foods(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.ratios());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TableRatios)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include "food/MacroTable.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/MealPlanner.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace food;
+
+namespace {
+
+/**
+ * @brief A catalogue of num_foods foods with random macronutrients, most of
+ *        them low in any one
+ */
+auto make_catalogue(size_t num_foods) -> MacroTable
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> random(0, 1);
+
+  MacroTable table;
+  table.reserve(num_foods);
+  for (size_t i = 0; i < num_foods; ++i) {
+    double const fat = 40 * random(generator) * random(generator);
+    double const carbohydrate = 80 * random(generator) * random(generator);
+    double const fiber = carbohydrate * 0.2 * random(generator);
+    double const protein = 30 * random(generator) * random(generator);
+
+    table.push_back(static_cast<int>(i + 1),
+                    Macronutrients(Fat(fat),
+                                   Carbohydrate(carbohydrate, Fiber(fiber)),
+                                   Protein(protein)));
+  }
+
+  return table;
+}
+
+/**
+ * @brief A dinner for someone eating 2400 kcal a day
+ */
+auto dinner() -> MacroTargets
+{
+  MacroTargets targets;
+  targets.kcal = 800;
+  targets.fat = 25;
+  targets.carbohydrate = 85;
+  targets.fiber = 10;
+  targets.protein = 55;
+  return targets;
+}
+
+/**
+ * @brief Registers 10^3 - 10^6 foods searched by 1 and 4 threads
+ */
+void sizes_and_threads(benchmark::internal::Benchmark *benchmark)
+{
+  for (long threads : {1, 4}) {
+    for (long foods = 1000; foods <= 1000000; foods *= 10) {
+      benchmark->Args({foods, threads});
+    }
+  }
+
+  benchmark->ArgNames({"foods", "threads"});
+}
+
+} // namespace
+
+static void BM_Candidates(benchmark::State &state)
+{
+  MealPlanner const planner(make_catalogue(state.range(0)));
+  auto const targets = dinner();
+  MealLimits const limits;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(planner.candidates(targets, limits));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Candidates)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_FirstWithinTolerance(benchmark::State &state)
+{
+  MealPlanner const planner(make_catalogue(state.range(0)));
+  auto const targets = dinner();
+
+  MealLimits limits;
+  limits.num_threads = state.range(1);
+
+  size_t nodes = 0;
+  for (auto _ : state) {
+    auto const plan = planner.plan(targets, limits);
+    nodes += plan.nodes;
+    benchmark::DoNotOptimize(plan.deviation);
+  }
+
+  state.counters["nodes"] = benchmark::Counter(
+      static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FirstWithinTolerance)
+    ->Apply(sizes_and_threads)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_Closest(benchmark::State &state)
+{
+  MealPlanner const planner(make_catalogue(state.range(0)));
+  auto const targets = dinner();
+
+  MealLimits limits;
+  limits.num_threads = state.range(1);
+  limits.first_within_tolerance = false;
+
+  size_t nodes = 0;
+  for (auto _ : state) {
+    auto const plan = planner.plan(targets, limits);
+    nodes += plan.nodes;
+    benchmark::DoNotOptimize(plan.deviation);
+  }
+
+  state.counters["nodes"] = benchmark::Counter(
+      static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Closest)->Apply(sizes_and_threads)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,188 @@
+#include "food/MicronutrientMatrix.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+/**
+ * @brief Vitamins, minerals and amino acids tracked
+ */
+size_t const num_nutrients = 150;
+
+/**
+ * @brief Foods in the day of the day benchmarks
+ */
+size_t const entries_per_day = 20;
+
+/**
+ * @brief The nutrients a food contains, about one in ten and a different mix
+ *        for every food
+ */
+auto make_amounts(size_t food) -> std::vector<NutrientAmount>
+{
+  std::vector<NutrientAmount> amounts;
+  for (uint32_t nutrient = food % 10; nutrient < num_nutrients;
+       nutrient += 10) {
+    amounts.push_back({nutrient, 0.5f + (food + nutrient) % 40});
+  }
+  return amounts;
+}
+
+auto make_matrix(size_t num_foods) -> MicronutrientMatrix
+{
+  MicronutrientMatrix matrix(num_nutrients);
+  matrix.reserve(num_foods, num_foods * num_nutrients / 10);
+
+  for (size_t food = 0; food < num_foods; ++food) {
+    matrix.push_back(static_cast<int>(food) + 1, make_amounts(food));
+  }
+  return matrix;
+}
+
+/**
+ * @brief The same amounts with every zero stored, row after row. Takes
+ *        600MB for a million foods.
+ */
+auto make_dense(size_t num_foods) -> std::vector<float>
+{
+  std::vector<float> dense(num_foods * num_nutrients);
+  for (size_t food = 0; food < num_foods; ++food) {
+    for (auto const &amount : make_amounts(food)) {
+      dense[food * num_nutrients + amount.nutrient] = amount.amount;
+    }
+  }
+  return dense;
+}
+
+/**
+ * @brief Adds grams of the dense row to totals, the dense counterpart of the
+ *        matrix kernel
+ */
+void accumulate_dense(float const *row, double grams, double *totals)
+{
+  double const scale = grams / 100;
+
+#pragma omp simd
+  for (size_t nutrient = 0; nutrient < num_nutrients; ++nutrient) {
+    totals[nutrient] += scale * row[nutrient];
+  }
+}
+
+/**
+ * @brief A portion of every food, in grams
+ */
+auto make_portions(size_t num_foods) -> std::vector<double>
+{
+  std::vector<double> grams(num_foods);
+  for (size_t i = 0; i < num_foods; ++i) {
+    grams[i] = 50 + i % 200;
+  }
+  return grams;
+}
+
+/**
+ * @brief The entries of a day, spread over the whole table
+ */
+auto make_day(size_t num_foods) -> std::vector<Portion>
+{
+  std::vector<Portion> day;
+  for (size_t i = 0; i < entries_per_day; ++i) {
+    int const food_id = static_cast<int>((i * 7919) % num_foods) + 1;
+    day.push_back({food_id, 50.0 + i * 10});
+  }
+  return day;
+}
+
+void food_counts(benchmark::internal::Benchmark *benchmark)
+{
+  for (long foods = 1000; foods <= 1000000; foods *= 10) {
+    benchmark->Arg(foods);
+  }
+  benchmark->ArgName("foods");
+}
+
+} // namespace
+
+static void BM_DenseTotals(benchmark::State &state)
+{
+  size_t const num_foods = state.range(0);
+  auto const dense = make_dense(num_foods);
+  auto const grams = make_portions(num_foods);
+
+  for (auto _ : state) {
+    std::vector<double> totals(num_nutrients);
+    for (size_t food = 0; food < num_foods; ++food) {
+      accumulate_dense(&dense[food * num_nutrients], grams[food],
+                       totals.data());
+    }
+    benchmark::DoNotOptimize(totals.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_foods);
+  state.counters["bytes"] = dense.size() * sizeof(float);
+}
+BENCHMARK(BM_DenseTotals)->Apply(food_counts);
+
+static void BM_SparseTotals(benchmark::State &state)
+{
+  size_t const num_foods = state.range(0);
+  auto const matrix = make_matrix(num_foods);
+  auto const grams = make_portions(num_foods);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.totals(grams));
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_foods);
+  state.counters["bytes"] =
+      matrix.num_amounts() * (sizeof(float) + sizeof(uint32_t)) +
+      matrix.size() * (sizeof(int) + sizeof(uint32_t));
+}
+BENCHMARK(BM_SparseTotals)->Apply(food_counts);
+
+static void BM_DenseDay(benchmark::State &state)
+{
+  size_t const num_foods = state.range(0);
+  auto const dense = make_dense(num_foods);
+  auto const day = make_day(num_foods);
+
+  std::vector<int> ids(num_foods);
+  for (size_t food = 0; food < num_foods; ++food) {
+    ids[food] = static_cast<int>(food) + 1;
+  }
+
+  for (auto _ : state) {
+    std::vector<double> totals(num_nutrients);
+    for (auto const &portion : day) {
+      auto const row =
+          std::lower_bound(begin(ids), end(ids), portion.food_id) - begin(ids);
+      accumulate_dense(&dense[row * num_nutrients], portion.grams,
+                       totals.data());
+    }
+    benchmark::DoNotOptimize(totals.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * entries_per_day);
+}
+BENCHMARK(BM_DenseDay)->Apply(food_counts);
+
+static void BM_SparseDay(benchmark::State &state)
+{
+  auto const matrix = make_matrix(state.range(0));
+  auto const day = make_day(matrix.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix.totals(day));
+  }
+
+  state.SetItemsProcessed(state.iterations() * entries_per_day);
+}
+BENCHMARK(BM_SparseDay)->Apply(food_counts);
+
+BENCHMARK_MAIN();
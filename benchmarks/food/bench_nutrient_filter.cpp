@@ -0,0 +1,157 @@
+#include "fixtures.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/NutrientIndex.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+/**
+ * @brief Foods with random macronutrients, so filters match some of them
+ */
+auto make_foods(size_t num_foods) -> fixtures::food_vector_t
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> random(0, 1);
+
+  fixtures::food_vector_t foods;
+  foods.reserve(num_foods);
+  for (size_t i = 0; i < num_foods; ++i) {
+    double const carbohydrate = 80 * random(generator);
+    Macronutrients const macros(
+        Fat(40 * random(generator)),
+        Carbohydrate(carbohydrate, Fiber(carbohydrate * random(generator) / 4)),
+        Protein(30 * random(generator)));
+
+    foods.emplace_back(static_cast<int>(i + 1),
+                       "food " + std::to_string(i + 1), macros);
+  }
+
+  return foods;
+}
+
+/**
+ * @brief The filters benchmarked, by the query argument
+ *
+ * 0: lean and high in protein and fiber, about 0.3% of the foods
+ * 1: not too fatty with some protein, about 33% of the foods
+ * 2: an energy range, about 8% of the foods
+ */
+auto query(long number) -> std::vector<NutrientRange>
+{
+  switch (number) {
+  case 0:
+    return {{Nutrient::PROTEIN, 25},
+            {Nutrient::FAT, 0, 5},
+            {Nutrient::FIBER, 3}};
+  case 1: return {{Nutrient::FAT, 0, 20}, {Nutrient::PROTEIN, 10}};
+  default: return {{Nutrient::KCAL, 200, 250}};
+  }
+}
+
+/**
+ * @brief Registers every query over 10^3 - 10^6 foods
+ */
+void sizes_and_queries(benchmark::internal::Benchmark *benchmark)
+{
+  for (long number : {0, 1, 2}) {
+    for (long foods = 1000; foods <= 1000000; foods *= 10) {
+      benchmark->Args({foods, number});
+    }
+  }
+
+  benchmark->ArgNames({"foods", "query"});
+}
+
+} // namespace
+
+static void BM_Scan(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto const ranges = query(state.range(1));
+
+  // What a filter over the Food cache has to do
+  for (auto _ : state) {
+    std::vector<int> food_ids;
+    for (auto const &food : foods) {
+      auto const macros = food.macronutrients();
+      bool const within =
+          std::all_of(begin(ranges), end(ranges), [&](auto const &range) {
+            double value = macros.kcal();
+            switch (range.nutrient) {
+            case Nutrient::FAT: value = macros.fat(); break;
+            case Nutrient::CARBOHYDRATE: value = macros.carbohydrate(); break;
+            case Nutrient::FIBER: value = macros.fiber(); break;
+            case Nutrient::PROTEIN: value = macros.protein(); break;
+            case Nutrient::KCAL: break;
+            }
+            return value >= range.min && value <= range.max;
+          });
+      if (within) { food_ids.push_back(food.id()); }
+    }
+
+    benchmark::DoNotOptimize(food_ids.data());
+  }
+}
+BENCHMARK(BM_Scan)->Apply(sizes_and_queries)->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexFilter(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto const ranges = query(state.range(1));
+  auto const index = NutrientIndex::from(foods);
+
+  size_t matches = 0;
+  for (auto _ : state) {
+    auto const food_ids = index.filter(ranges);
+    matches = food_ids.size();
+    benchmark::DoNotOptimize(food_ids.data());
+  }
+
+  state.counters["matches"] = static_cast<double>(matches);
+}
+BENCHMARK(BM_IndexFilter)
+    ->Apply(sizes_and_queries)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_IndexBuild(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(NutrientIndex::from(foods));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IndexBuild)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_IndexUpdate(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto index = NutrientIndex::from(foods);
+
+  // A food updated to the nutrients of another, merges included
+  size_t i = 0;
+  for (auto _ : state) {
+    int const food_id = static_cast<int>(i * 7919 % foods.size()) + 1;
+    index.insert(food_id, foods[i % foods.size()].macronutrients());
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexUpdate)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+#include "fixtures.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/ProfileTree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+constexpr size_t k = 10;
+
+/**
+ * @brief Foods with random macronutrients, fixtures::make_foods gives every
+ *        food the same profile
+ */
+auto make_foods(size_t num_foods) -> fixtures::food_vector_t
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> random(0, 1);
+
+  fixtures::food_vector_t foods;
+  foods.reserve(num_foods);
+  for (size_t i = 0; i < num_foods; ++i) {
+    double const carbohydrate = 80 * random(generator);
+    Macronutrients const macros(
+        Fat(40 * random(generator)),
+        Carbohydrate(carbohydrate, Fiber(carbohydrate * random(generator) / 4)),
+        Protein(30 * random(generator)));
+
+    foods.emplace_back(static_cast<int>(i + 1),
+                       "food " + std::to_string(i + 1), macros);
+  }
+
+  return foods;
+}
+
+/**
+ * @brief The profiles of the foods searched for, taken from the catalogue
+ */
+auto make_queries(fixtures::food_vector_t const &foods) -> std::vector<Profile>
+{
+  std::vector<Profile> queries;
+  for (size_t i = 0; i < 256; ++i) {
+    queries.push_back(profile(foods[i * 7919 % foods.size()].macronutrients()));
+  }
+  return queries;
+}
+
+} // namespace
+
+static void BM_BruteForce(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto const queries = make_queries(foods);
+
+  size_t query = 0;
+  for (auto _ : state) {
+    auto const &target = queries[query++ % queries.size()];
+
+    // What a search over the Food cache has to do for every keystroke
+    std::vector<std::pair<float, int>> heap;
+    for (auto const &food : foods) {
+      auto const other = profile(food.macronutrients());
+
+      float distance = 0;
+      for (size_t axis = 0; axis < other.size(); ++axis) {
+        distance += (other[axis] - target[axis]) * (other[axis] - target[axis]);
+      }
+
+      if (heap.size() == k && distance >= heap.front().first) { continue; }
+      heap.emplace_back(distance, food.id());
+      std::push_heap(begin(heap), end(heap));
+      if (heap.size() > k) {
+        std::pop_heap(begin(heap), end(heap));
+        heap.pop_back();
+      }
+    }
+
+    benchmark::DoNotOptimize(heap.data());
+  }
+}
+BENCHMARK(BM_BruteForce)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TreeNearest(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto const queries = make_queries(foods);
+  auto const tree = ProfileTree::from(foods);
+
+  size_t query = 0;
+  for (auto _ : state) {
+    auto const &target = queries[query++ % queries.size()];
+    benchmark::DoNotOptimize(tree.nearest(target, k));
+  }
+}
+BENCHMARK(BM_TreeNearest)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TreeBuild(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ProfileTree::from(foods));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TreeBuild)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_TreeMove(benchmark::State &state)
+{
+  auto const foods = make_foods(state.range(0));
+  auto const queries = make_queries(foods);
+  auto tree = ProfileTree::from(foods);
+
+  // A food updated to another profile, rebalancing included
+  size_t i = 0;
+  for (auto _ : state) {
+    int const food_id = static_cast<int>(i * 7919 % foods.size()) + 1;
+    tree.insert(food_id, queries[i % queries.size()]);
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TreeMove)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
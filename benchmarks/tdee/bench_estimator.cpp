@@ -0,0 +1,58 @@
+#include "tdee/Estimator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using namespace tdee;
+
+namespace {
+
+auto make_days(size_t num_days) -> std::vector<Day>
+{
+  std::mt19937 generator(7);
+  std::normal_distribution<double> intake(2300, 300);
+  std::normal_distribution<double> weight(80, 1);
+
+  std::vector<Day> days(num_days);
+  for (auto &day : days) {
+    day.intake = intake(generator);
+    day.weight = weight(generator);
+  }
+
+  return days;
+}
+
+} // namespace
+
+static void BM_Update(benchmark::State &state)
+{
+  auto const days = make_days(1024);
+  Estimator estimator;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    estimator.update(days[i++ % days.size()]);
+    benchmark::DoNotOptimize(estimator.estimate());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Update);
+
+// Years of daily data: 1, 10 and 100
+static void BM_Backfill(benchmark::State &state)
+{
+  auto const days = make_days(state.range(0));
+
+  for (auto _ : state) {
+    Estimator estimator;
+    benchmark::DoNotOptimize(estimator.backfill(days));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Backfill)->RangeMultiplier(10)->Range(365, 36500);
+
+BENCHMARK_MAIN();
@@ -20,6 +20,7 @@ class SociTestConan(ConanFile):
         "nameof/0.8.2@nameof/stable",
         "range-v3/0.5.0@ericniebler/stable",
         "gtest/1.8.1@bincrafters/stable",
+        "google-benchmark/1.5.0@mpusz/stable",
         "qt/5.12.0@bincrafters/stable",
     )
 
@@ -28,6 +29,7 @@ class SociTestConan(ConanFile):
     options = {
         "enable_documentation": [True, False],
         "enable_tests": [True, False],
+        "enable_benchmarks": [True, False],
         "fPIC": [True, False],
     }
 
@@ -39,6 +41,7 @@ class SociTestConan(ConanFile):
         "qt:qtquickcontrols2": True,
         "enable_documentation": False,
         "enable_tests": False,
+        "enable_benchmarks": False,
         "soci:fPIC": True,
         "fPIC": True,
     }
@@ -51,6 +54,7 @@ class SociTestConan(ConanFile):
             defs={
                 "ENABLE_DOCUMENTATION": self.options.enable_documentation,
                 "ENABLE_TESTS": self.options.enable_tests,
+                "ENABLE_BENCHMARKS": self.options.enable_benchmarks,
             })
 
         cmake.build()
@@ -60,6 +64,7 @@ class SociTestConan(ConanFile):
         self.copy("*soci*.so*", dst="lib/tracker", src="lib")
         self.copy("*gmock*.a", dst="lib", src="lib")
         self.copy("*gtest*.a", dst="lib", src="lib")
+        self.copy("*benchmark*.a", dst="lib", src="lib")
 
     def test(self):
         if not tools.cross_building(self.settings):
@@ -0,0 +1,56 @@
+/**
+ * @file Date.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Conversions between calendar dates and days since the epoch
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Organizes all body measurement related classes and utilities
+ */
+namespace body {
+
+/**
+ * @brief A date in the proleptic Gregorian calendar
+ */
+struct Date {
+  int year;
+
+  /**
+   * @brief 1 to 12
+   */
+  int month;
+
+  /**
+   * @brief 1 to 31
+   */
+  int day;
+};
+
+/**
+ * @return The days since 1970-01-01 of date, negative before it
+ */
+auto to_epoch_day(Date const &date) -> int;
+
+/**
+ * @return The date epoch_day days after 1970-01-01
+ */
+auto to_date(int epoch_day) -> Date;
+
+/**
+ * @return The date as YYYY-MM-DD
+ */
+auto to_string(Date const &date) -> std::string;
+
+/**
+ * @return The date in a YYYY-MM-DD string, nothing if it is not one
+ */
+auto parse_date(std::string_view text) -> std::optional<Date>;
+
+} // namespace body
@@ -0,0 +1,217 @@
+/**
+ * @file WeightEntry.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A single weigh-in
+ */
+
+#pragma once
+
+#include "database/Memory.hpp"
+#include "database/Storable.hpp"
+#include "database/utils.hpp"
+
+#include <soci.h>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Organizes all body measurement related classes and utilities
+ */
+namespace body {
+
+/**
+ * @brief A single weigh-in
+ *
+ * Only the day is kept, as days since the epoch and formatted as the name of
+ * the weigh-in, and the weight is a float.
+ * The day column is indexed together with the weight, so ranges of days are
+ * read from the index alone. See WeightRollups for week and month summaries.
+ */
+class WeightEntry final : public database::Storable {
+public:
+  WeightEntry(WeightEntry &&w) = default;
+
+  WeightEntry &operator=(WeightEntry const &w) = default;
+  WeightEntry &operator=(WeightEntry &&w) = default;
+
+  /**
+   * @brief All data will be retrieved from a storable object using this
+   *        function.
+   *
+   * @return A struct containing the name of the table to store this data,
+   *         a vector of column info and the indexes of the table. See
+   *         Data.hpp for more info.
+   */
+  auto get_data() const -> database::Data const override;
+
+  /**
+   *  @return The unique ID of this weigh-in in the database
+   */
+  auto id() const -> int override
+  {
+    return this->id_;
+  }
+
+  /**
+   * @return The day of the weigh-in as YYYY-MM-DD, valid until the day
+   *         changes
+   */
+  auto name() const -> std::string_view override;
+
+  /**
+   * @param name A new day for the weigh-in as YYYY-MM-DD
+   *
+   * Will throw a runtime error if name is not a date
+   */
+  void set_name(std::string_view name) override;
+
+  /**
+   * @return string representation of the name and data, the same way sqlite
+   *         displays table data
+   */
+  auto str() const -> std::string override;
+
+  /**
+   * @return The day of the weigh-in, in days since the epoch
+   */
+  auto day() const -> int;
+
+  /**
+   * @param day The day of the weigh-in, in days since the epoch
+   */
+  void set_day(int day);
+
+  /**
+   * @return The day before the last change, listeners of an update find the
+   *         day a weigh-in moved from here
+   */
+  auto previous_day() const -> int;
+
+  /**
+   * @return The weight in kg
+   */
+  auto kg() const -> float;
+
+  /**
+   * @param kg The weight in kg
+   */
+  void set_kg(float kg);
+
+  ~WeightEntry() override = default;
+
+  /**
+   * @brief Custom allocator that allows database utils to own a vector
+   *        of storable objects with private constructors. Allocates from
+   *        the pool shared by every cache, see database::cache_resource.
+   */
+  struct Allocator : std::pmr::polymorphic_allocator<WeightEntry> {
+    Allocator()
+        : std::pmr::polymorphic_allocator<WeightEntry>(
+              database::cache_resource())
+    {}
+
+    /**
+     * @brief Allocates from resource instead, e.g. for an object that is
+     *        released on its own rather than with its cache
+     */
+    explicit Allocator(std::pmr::memory_resource *resource)
+        : std::pmr::polymorphic_allocator<WeightEntry>(resource)
+    {}
+
+    /**
+     * @brief Copies of a cache allocate from the pool as well
+     */
+    auto select_on_container_copy_construction() const -> Allocator
+    {
+      return {};
+    }
+
+    template <class WeightEntry, typename... Args>
+    void construct(WeightEntry *buffer, Args &&... args)
+    {
+      /**
+       * @brief In place new construction of storable by memory pool that is
+       *        given
+       */
+      new (buffer) WeightEntry(std::forward<Args>(args)...);
+    }
+
+    template <class WeightEntry> struct rebind {
+      using other = Allocator;
+    };
+  };
+
+  friend struct Allocator;
+
+private:
+  WeightEntry() = default;
+  WeightEntry(WeightEntry const &w) = default;
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   */
+  explicit WeightEntry(int id);
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   * @param day The day of the weigh-in, in days since the epoch
+   * @param kg The weight in kg
+   */
+  WeightEntry(int id, int day, float kg);
+
+  /**
+   * @param A schema for this Storable object
+   * @param The row of data to construct the object
+   */
+  WeightEntry(std::vector<database::ColumnProperties> const &schema,
+              database::Row const &data);
+
+  /**
+   * @brief When creating new weigh-ins from data retrieved from the
+   *        database, this function will be used to set the data for the
+   *        Storable object.
+   *
+   * @param schema A vector containing the properties of each column that make
+   *               up a schema
+   *
+   * @param data A row of data to set the object data
+   */
+  void set_data(std::vector<database::ColumnProperties> const &schema,
+                database::Row const &data) override;
+
+  /**
+   * @brief Formats the day into name_
+   */
+  void name_day();
+
+  /**
+   *  @brief The unique ID of this weigh-in in the database
+   */
+  int id_ = 0;
+
+  /**
+   *  @brief The day of the weigh-in, in days since the epoch
+   */
+  int day_ = 0;
+
+  /**
+   *  @brief The day before the last change, in days since the epoch
+   */
+  int previous_day_ = 0;
+
+  /**
+   *  @brief The weight in kg
+   */
+  float kg_ = 0;
+
+  /**
+   *  @brief The day as YYYY-MM-DD, short enough to never allocate
+   */
+  std::string name_;
+};
+
+} // namespace body
@@ -0,0 +1,138 @@
+/**
+ * @file WeightRollups.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Week and month summaries of the weigh-ins, kept up to date as they
+ *        change
+ */
+
+#pragma once
+
+#include "body/WeightEntry.hpp"
+#include "database/utils.hpp"
+
+#include <map>
+#include <vector>
+
+/**
+ * @brief Organizes all body measurement related classes and utilities
+ */
+namespace body {
+
+/**
+ * @brief The length of time a summary covers
+ *
+ * Weeks start on Monday. Only days on or after 1970-01-01 are supported.
+ */
+enum class Resolution { WEEK, MONTH };
+
+/**
+ * @brief The weigh-ins of a single week or month
+ */
+struct WeightSummary {
+  /**
+   * @brief First and last day of the week or month, in days since the epoch
+   */
+  int first_day;
+  int last_day;
+
+  float min;
+  float max;
+  float mean;
+
+  /**
+   * @brief The number of weigh-ins summarized
+   */
+  int count;
+};
+
+/**
+ * @brief Week and month summaries of the weigh-ins, kept up to date as they
+ *        change
+ *
+ * The summaries are computed by SQLite with GROUP BY when constructed. Made
+ * weigh-ins are added to them directly. Summaries with updated or deleted
+ * weigh-ins are recomputed from the day index the next time they are read,
+ * since their min and max can't be undone. An updated weigh-in tells the day
+ * it moved from with previous_day.
+ *
+ * Not thread safe, changes must be made on the thread that reads summaries.
+ *
+ * Usage:
+ * @n body::WeightRollups rollups;
+ * @n for(auto const &month : rollups.summaries(body::Resolution::MONTH,
+ * @n                                           first_day, last_day)) {
+ * @n   // plot month.min, month.mean and month.max
+ * @n }
+ */
+class WeightRollups {
+public:
+  WeightRollups();
+
+  WeightRollups(WeightRollups const &) = delete;
+  WeightRollups &operator=(WeightRollups const &) = delete;
+
+  /**
+   * @return The summaries of the weeks or months that overlap first_day to
+   *         last_day and have weigh-ins, oldest first
+   */
+  auto summaries(Resolution resolution, int first_day, int last_day)
+      -> std::vector<WeightSummary>;
+
+  /**
+   * @brief Recomputes every summary, use after the weigh-ins were changed
+   *        without database::utils
+   */
+  void rebuild();
+
+  /**
+   * @return The number of the week or month day is in
+   */
+  static auto bucket_of(Resolution resolution, int day) -> int;
+
+  /**
+   * @return The first day of a week or month number
+   */
+  static auto first_day_of(Resolution resolution, int bucket) -> int;
+
+private:
+  struct Aggregate {
+    float min = 0;
+    float max = 0;
+    double sum = 0;
+    int count = 0;
+
+    /**
+     * @brief A weigh-in was updated or deleted, must be recomputed
+     */
+    bool stale = false;
+  };
+
+  using Buckets = std::map<int, Aggregate>;
+
+  auto buckets(Resolution resolution) -> Buckets &;
+
+  /**
+   * @brief Computes every summary of resolution with a single GROUP BY
+   */
+  void load(Resolution resolution);
+
+  /**
+   * @brief Recomputes a single summary from the day index
+   */
+  void refresh(Resolution resolution, int bucket, Aggregate &aggregate);
+
+  void on_weight(WeightEntry const &weight, database::utils::Change change);
+
+  /**
+   * @brief Marks the summaries day is in as stale
+   */
+  void invalidate(int day);
+
+  Buckets weeks_;
+  Buckets months_;
+
+  database::utils::Subscription<WeightEntry> listener_;
+};
+
+} // namespace body
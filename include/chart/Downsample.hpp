@@ -0,0 +1,138 @@
+/**
+ * @file Downsample.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Reduces time series to about one point per pixel while keeping their
+ *        visual shape
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Chart data processing, independent of the GUI
+ */
+namespace chart {
+
+/**
+ * @brief A point of a time series, x is usually days since the epoch
+ */
+struct Point {
+  double x;
+  double y;
+};
+
+/**
+ * @brief Largest-Triangle-Three-Buckets downsampling
+ * @param points The series, sorted by x
+ * @param size The number of points
+ * @param threshold The number of points to keep, at least 3
+ * @return threshold points of the series, or all of them if there are fewer
+ *
+ * Keeps the first and last point. The rest is split into threshold - 2
+ * buckets and from each the point forming the largest triangle with the point
+ * kept from the previous bucket and the average of the next bucket is kept.
+ *
+ * Source: Sveinn Steinarsson, Downsampling Time Series for Visual
+ *         Representation, 2013
+ *
+ * Usage:
+ * @n auto const shown = chart::lttb(series.data(), series.size(), 800);
+ */
+auto lttb(Point const *points, size_t size, size_t threshold)
+    -> std::vector<Point>;
+
+/**
+ * @brief Downsamples the visible part of a series to at most one point per
+ *        pixel, reusing work between pans and zooms
+ *
+ * Buckets are aligned to a grid of power of two widths instead of to the
+ * visible range. Panning keeps the same grid and zooming within a factor of
+ * two keeps the same width, so already chosen points are reused and only
+ * newly visible buckets are computed. Each bucket keeps the point forming the
+ * largest triangle with the averages of its neighbouring buckets, which only
+ * depends on the data so it can be cached.
+ *
+ * Usage:
+ * @n chart::Downsampler downsampler;
+ * @n downsampler.set_points(weights);
+ * @n auto const shown = downsampler.window(first_day, last_day, width);
+ */
+class Downsampler {
+public:
+  /**
+   * @param points The series, sorted by x
+   */
+  void set_points(std::vector<Point> points);
+
+  /**
+   * @brief Adds a point, keeping the series sorted. Only the cached buckets
+   *        around it are recomputed.
+   */
+  void insert(Point point);
+
+  /**
+   * @brief Sets the y of the point at point.x, inserting the point if there
+   *        is none. Only the cached buckets around it are recomputed.
+   */
+  void update(Point point);
+
+  /**
+   * @brief Removes the points at x, if any. Only the cached buckets around
+   *        them are recomputed.
+   */
+  void erase(double x);
+
+  /**
+   * @return The whole series
+   */
+  auto points() const -> std::vector<Point> const &;
+
+  /**
+   * @param x_min The left edge of the visible range
+   * @param x_max The right edge of the visible range
+   * @param pixels The width of the chart in pixels
+   * @return At most one point per pixel inside the visible range, plus the
+   *         closest point outside each edge so lines reach the edges
+   */
+  auto window(double x_min, double x_max, size_t pixels) -> std::vector<Point>;
+
+private:
+  /**
+   * @brief The points of a bucket, [first, last) of points_
+   */
+  struct Bucket {
+    size_t first;
+    size_t last;
+  };
+
+  /**
+   * @brief The chosen point of every computed bucket of a grid width, none
+   *        if the bucket is empty
+   */
+  using Level = std::unordered_map<long long, std::optional<Point>>;
+
+  /**
+   * @brief Drops the cached buckets that depend on the point at position
+   */
+  void invalidate(size_t position);
+
+  auto bucket(double width, long long index) const -> Bucket;
+
+  auto average(Bucket const &bucket) const -> Point;
+
+  auto select(int exponent, long long index) -> std::optional<Point>;
+
+  std::vector<Point> points_;
+
+  /**
+   * @brief Cached buckets by the exponent of their width
+   */
+  std::map<int, Level> levels_;
+};
+
+} // namespace chart
@@ -0,0 +1,411 @@
+/**
+ * @file BoundedCache.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A Storable cache that stays within a memory budget, for tables too
+ *        large to keep whole with retrieve_all
+ */
+
+#pragma once
+
+#include "database/Interner.hpp"
+#include "database/Storable.hpp"
+#include "database/utils.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Organizes all databasing related classes and functions
+ */
+namespace database {
+
+/**
+ * @brief Holds at most a memory budget worth of Storable objects, fetching
+ *        each by id the first time it is asked for
+ *
+ * Objects are evicted with the CLOCK algorithm: a hand sweeps the slots,
+ * giving a recently used object a second chance and evicting the first one
+ * that was not used since the hand last passed it. An object still held
+ * outside of the cache, e.g. by a GUI wrapper, is pinned and never evicted.
+ * The cache goes over budget rather than evict it, and gives the memory back
+ * once it is released.
+ *
+ * Each object is fetched along with its names, which are owned by the cache
+ * entry rather than interned in database::name_interner, and allocated from
+ * the heap rather than the pool of the caches, so an evicted object gives
+ * all of its memory back.
+ *
+ * Updated and deleted objects are dropped from the cache, holders keep the
+ * object as it was. Not thread safe, like database::utils.
+ *
+ * Usage:
+ * @n database::BoundedCache<food::Food> foods(4 * 1024 * 1024);
+ * @n if (auto const taco = foods.get(taco_id)) { show(taco->name()); }
+ */
+template <typename Storable> class BoundedCache {
+  static_assert(is_storable_v<Storable>,
+                "BoundedCache holds types that satisfy is_storable_v");
+
+  /**
+   * @brief An object along with the names it holds views of. Storables are
+   *        only constructed through their Allocator, each one is fetched
+   *        into a vector of its own.
+   */
+  struct Fetched {
+    OwnedNames names;
+    std::vector<Storable, typename Storable::Allocator> storables{
+        Fetched::allocator()};
+
+    /**
+     * @return An allocator from the heap if the Allocator of Storable can be
+     *         given a memory resource
+     */
+    static auto allocator() -> typename Storable::Allocator;
+  };
+
+public:
+  /**
+   * @brief Shares ownership of a cached object, pins it while held
+   */
+  using Handle = std::shared_ptr<Storable const>;
+
+  /**
+   * @brief Estimated bytes each cached object costs besides its names, the
+   *        object along with its slot, index entry and shared ownership
+   */
+  static constexpr size_t entry_bytes =
+      sizeof(Storable) + sizeof(Fetched) + sizeof(Handle) +
+      sizeof(std::pair<int const, size_t>) + 6 * sizeof(void *);
+
+  /**
+   * @param budget_bytes The memory the cached objects and their names may
+   *                     take, at least one object is always cached
+   */
+  explicit BoundedCache(size_t budget_bytes);
+
+  /**
+   * @return The object with id, fetched from the database if it is not
+   *         cached, or nullptr if there is no such object
+   */
+  auto get(int id) -> Handle;
+
+  /**
+   * @return true if the object with id is cached
+   */
+  auto contains(int id) const -> bool;
+
+  /**
+   * @brief Drops the object with id from the cache, the next get fetches it
+   *        again
+   */
+  void invalidate(int id);
+
+  /**
+   * @brief Changes the memory budget, evicting objects if it shrunk
+   */
+  void set_budget(size_t budget_bytes);
+
+  /**
+   * @return The number of objects without names the budget allows
+   */
+  auto capacity() const -> size_t;
+
+  /**
+   * @return The estimated bytes taken by the cached objects and their names
+   */
+  auto bytes() const -> size_t;
+
+  /**
+   * @return The number of objects cached
+   */
+  auto size() const -> size_t;
+
+  /**
+   * @return The number of calls to get answered from the cache
+   */
+  auto hits() const -> size_t;
+
+  /**
+   * @return The number of calls to get that had to query the database
+   */
+  auto misses() const -> size_t;
+
+  //! Deleted functions, the database listener refers to this cache
+  BoundedCache(BoundedCache const &) = delete;
+  BoundedCache(BoundedCache &&) = delete;
+  BoundedCache &operator=(BoundedCache const &) = delete;
+  BoundedCache &operator=(BoundedCache &&) = delete;
+
+private:
+  struct Slot {
+    int id = 0;
+    Handle storable;
+
+    /**
+     * @brief entry_bytes along with the bytes of the names of the object
+     */
+    size_t bytes = 0;
+
+    /**
+     * @brief Set when the object is used, cleared when the hand passes it
+     */
+    bool referenced = false;
+  };
+
+  /**
+   * @return The object with id from the database, or nullptr
+   * @param bytes Set to the bytes the object costs, see Slot::bytes
+   */
+  auto fetch(int id, size_t &bytes) -> Handle;
+
+  /**
+   * @return The index of an empty slot, evicting objects until one of bytes
+   *         fits or adding a slot if needed
+   */
+  auto free_slot(size_t bytes) -> size_t;
+
+  /**
+   * @brief Moves the hand until it finds an object that is neither pinned nor
+   *        recently used, and evicts it
+   * @return The index of the emptied slot, or slots_.size() if every object
+   *         is pinned
+   */
+  auto evict() -> size_t;
+
+  /**
+   * @brief Removes an empty slot, the last slot takes its place
+   */
+  void remove(size_t slot);
+
+  /**
+   * @brief Removes slots until the objects fit in the budget, or every object
+   *        left is pinned
+   */
+  void shrink();
+
+  size_t budget_bytes_;
+
+  /**
+   * @brief The sum of the bytes of every slot
+   */
+  size_t bytes_ = 0;
+
+  std::vector<Slot> slots_;
+
+  /**
+   * @brief The slot of each cached id
+   */
+  std::unordered_map<int, size_t> index_;
+
+  size_t hand_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  utils::Subscription<Storable> listener_;
+};
+
+} // namespace database
+
+///////////////////////////// Implementation Below /////////////////////////////
+
+template <typename Storable>
+database::BoundedCache<Storable>::BoundedCache(size_t budget_bytes)
+    : budget_bytes_{budget_bytes}
+{
+  listener_ = utils::Subscription<Storable>(
+      [this](Storable const &storable, utils::Change change) {
+        if (change != utils::Change::INSERTED) {
+          this->invalidate(storable.id());
+        }
+      });
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::get(int id) -> Handle
+{
+  auto const found = index_.find(id);
+  if (found != end(index_)) {
+    ++hits_;
+    auto &slot = slots_[found->second];
+    slot.referenced = true;
+    return slot.storable;
+  }
+
+  ++misses_;
+  size_t bytes = 0;
+  Handle storable = this->fetch(id, bytes);
+  if (!storable) { return nullptr; }
+
+  size_t const slot = this->free_slot(bytes);
+  slots_[slot] = Slot{id, storable, bytes, true};
+  index_[id] = slot;
+  bytes_ += bytes;
+
+  return storable;
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::contains(int id) const -> bool
+{
+  return index_.count(id) > 0;
+}
+
+template <typename Storable>
+void database::BoundedCache<Storable>::invalidate(int id)
+{
+  auto const found = index_.find(id);
+  if (found == end(index_)) { return; }
+
+  size_t const slot = found->second;
+  index_.erase(found);
+  bytes_ -= slots_[slot].bytes;
+  slots_[slot] = Slot{};
+  this->remove(slot);
+}
+
+template <typename Storable>
+void database::BoundedCache<Storable>::set_budget(size_t budget_bytes)
+{
+  budget_bytes_ = budget_bytes;
+  this->shrink();
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::capacity() const -> size_t
+{
+  return std::max<size_t>(budget_bytes_ / entry_bytes, 1);
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::bytes() const -> size_t
+{
+  return bytes_;
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::size() const -> size_t
+{
+  return slots_.size();
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::hits() const -> size_t
+{
+  return hits_;
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::misses() const -> size_t
+{
+  return misses_;
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::Fetched::allocator() ->
+    typename Storable::Allocator
+{
+  using Allocator = typename Storable::Allocator;
+  if constexpr (std::is_constructible_v<Allocator,
+                                        std::pmr::memory_resource *>) {
+    return Allocator(std::pmr::new_delete_resource());
+  } else {
+    return Allocator();
+  }
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::fetch(int id, size_t &bytes) -> Handle
+{
+  TRACKER_TRACE_SCOPE("database", "BoundedCache::fetch");
+
+  if (!utils::table_exists<Storable>()) { return nullptr; }
+
+  // The handle shares ownership of the object and its names
+  auto fetched = std::make_shared<Fetched>();
+  fetched->storables.reserve(1);
+  {
+    OwnedNames::Scope scope(fetched->names);
+    utils::detail::select_into(
+        utils::detail::statements<Storable>().select_one, {id},
+        fetched->storables);
+  }
+
+  if (fetched->storables.empty()) { return nullptr; }
+
+  bytes = entry_bytes + fetched->names.bytes();
+  return Handle(fetched, &fetched->storables.front());
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::free_slot(size_t bytes) -> size_t
+{
+  this->shrink();
+
+  // The last object evicted leaves the slot for the new one
+  while (bytes_ + bytes > budget_bytes_) {
+    size_t const slot = this->evict();
+    if (slot == slots_.size()) { break; }
+    if (bytes_ + bytes <= budget_bytes_) { return slot; }
+
+    this->remove(slot);
+  }
+
+  // Fits, or every object is pinned
+  slots_.emplace_back();
+  return slots_.size() - 1;
+}
+
+template <typename Storable>
+auto database::BoundedCache<Storable>::evict() -> size_t
+{
+  // Two turns of the hand clear every referenced bit on the way
+  for (size_t step = 0; step < 2 * slots_.size(); ++step) {
+    size_t const slot = hand_;
+    hand_ = (hand_ + 1) % slots_.size();
+
+    auto &candidate = slots_[slot];
+    bool const pinned = candidate.storable.use_count() > 1;
+    if (pinned) { continue; }
+
+    if (candidate.referenced) {
+      candidate.referenced = false;
+      continue;
+    }
+
+    index_.erase(candidate.id);
+    bytes_ -= candidate.bytes;
+    candidate = Slot{};
+    return slot;
+  }
+
+  return slots_.size();
+}
+
+template <typename Storable>
+void database::BoundedCache<Storable>::remove(size_t slot)
+{
+  if (slot != slots_.size() - 1) {
+    slots_[slot] = std::move(slots_.back());
+    index_[slots_[slot].id] = slot;
+  }
+
+  slots_.pop_back();
+  if (hand_ >= slots_.size()) { hand_ = 0; }
+}
+
+template <typename Storable>
+void database::BoundedCache<Storable>::shrink()
+{
+  while (bytes_ > budget_bytes_) {
+    size_t const slot = this->evict();
+    if (slot == slots_.size()) { return; }
+
+    this->remove(slot);
+  }
+}
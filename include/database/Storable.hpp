@@ -10,6 +10,10 @@
 #include "database/Data.hpp"
 
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Organizes all databasing related classes and functions
@@ -27,9 +31,10 @@ public:
   virtual auto id() const -> int = 0;
 
   /**
-   * @return The name of the storable
+   * @return The name of the storable, valid at least as long as the object
+   *         keeps it
    */
-  virtual auto name() const -> std::string const = 0;
+  virtual auto name() const -> std::string_view = 0;
 
   /**
    * @param A new name for the storable
@@ -66,4 +71,36 @@ public:
 
   virtual ~Storable() = default;
 };
+
+namespace detail {
+template <typename T, typename = void> struct is_storable : std::false_type {};
+
+template <typename T>
+using id_type = decltype(std::declval<T const &>().id());
+
+template <typename T>
+using get_data_type = decltype(std::declval<T const &>().get_data());
+
+template <typename T>
+struct is_storable<
+    T, std::void_t<id_type<T>, get_data_type<T>, typename T::Allocator>>
+    : std::bool_constant<std::is_convertible_v<id_type<T>, int> &&
+                         std::is_convertible_v<get_data_type<T>, Data> &&
+                         std::is_copy_assignable_v<T>> {};
+} // namespace detail
+
+/**
+ * @brief true if database::utils can store T: it has an int id(), a
+ *        get_data(), an Allocator for the cache and a copy assignment, which
+ *        update uses to bring the cached object up to date with a copy.
+ *        set_data is only called by T's own constructors.
+ *
+ * The utils only call these through T itself, never through Storable, so a
+ * final T with an inline id() has its id read directly in every sort and
+ * search over the cache. Deriving from Storable is only needed to handle
+ * storables of different types through one interface.
+ */
+template <typename T>
+inline constexpr bool is_storable_v = detail::is_storable<T>::value;
+
 } // namespace database
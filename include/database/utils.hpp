@@ -9,16 +9,28 @@
 
 #include "database/Data.hpp" // Data, Row, ColumnProperties
 #include "database/Database.hpp"
+#include "database/SlowQueryLog.hpp"
+#include "database/Statement.hpp"
 #include "database/Storable.hpp"
+#include "trace/Trace.hpp"
 
-#include <nameof.hpp>       // NAMEOF
-#include <range/v3/all.hpp> //ranges
+#include <nameof.hpp> // NAMEOF
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <iostream> // cerr
+#include <iterator>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
-#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 /**
@@ -31,6 +43,35 @@ namespace database {
  */
 namespace utils {
 
+/**
+ * @brief The kind of change made to a Storable through database::utils
+ */
+enum class Change { INSERTED, UPDATED, DELETED };
+
+/**
+ * @brief A function called with the Storable object that changed and how
+ */
+template <typename Storable>
+using Listener = std::function<void(Storable const &, Change)>;
+
+/**
+ * @brief Runs write in a single transaction, so every insert, update and
+ *        delete it makes through database::utils is committed at once
+ * @param write A function making the changes
+ *
+ * Outside of a batch every statement is a transaction of its own, each one
+ * synced to disk. Batches may nest, a nested batch is part of the outermost
+ * one. If write throws, the changes it made are rolled back in the database
+ * and in the caches, listeners are told about each change undone. Objects
+ * made in the batch leave the cache, references to them are invalidated.
+ *
+ * Usage:
+ * @n database::utils::batch([&] {
+ * @n   for (auto &food : foods) { food.set_macronutrients(macros); }
+ * @n });
+ */
+template <typename Function> void batch(Function &&write);
+
 /**
  * @brief Finds and returns the object if it exists in the stl container
  * @param first A forward iterator for the start of the search
@@ -59,9 +100,51 @@ template <class ForwardIt, class T, class Compare = std::less<>>
 auto binary_find(ForwardIt first, ForwardIt last, const T &value, Compare comp)
     -> ForwardIt;
 
+/**
+ * @brief Moves objects read with retrieve_chunk to the end of the cache
+ * @param Storable Any type that satisfies is_storable_v
+ * @param chunk The next objects of the table, sorted by id and with ids
+ *              greater than every cached object
+ *
+ * The cache counts as loaded from the first call, so retrieve_all returns
+ * what has been moved in so far instead of reading the whole table. Call it
+ * with an empty chunk before streaming the table in from another thread.
+ *
+ * Will throw a runtime error if the chunk would leave the cache unsorted
+ *
+ * Usage:
+ * @n database::utils::cache_chunk<food::Food>({});
+ * @n // on the loading thread
+ * @n auto chunk = database::utils::retrieve_chunk<food::Food>(last_id, 1000);
+ * @n // back on the thread that owns the cache
+ * @n database::utils::cache_chunk<food::Food>(std::move(chunk));
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+void cache_chunk(std::vector<Storable, struct Storable::Allocator> &&chunk);
+
+/**
+ * @brief Empties the cache of Storable objects so that the next call to
+ *        retrieve_all loads them from the database again
+ * @param Storable Any type that satisfies is_storable_v
+ *
+ * References to cached objects are invalidated. Use this after switching
+ * databases or after the table has been modified without database::utils.
+ *
+ * Usage:
+ * @n database::utils::clear_cache<food::Food>();
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+void clear_cache();
+
 /**
  * @brief Count the number of Storable type in the database
- * @param Storable Any type that is a base of Storable
+ * @param Storable Any type that satisfies is_storable_v
  * @return The number of rows in the table, 0 if table does not exist
  *
  * Creates the following SQLite3 command:
@@ -73,12 +156,12 @@ auto binary_find(ForwardIt first, ForwardIt last, const T &value, Compare comp)
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 auto count_rows() -> size_t;
 
 /**
  * @brief Create table of Storable if not exists
- * @param Storable Any type that is a base of Storable
+ * @param Storable Any type that satisfies is_storable_v
  * @param schema The schema to be used to create the table
  *
  * Creates the following SQLite3 command:
@@ -95,12 +178,33 @@ auto count_rows() -> size_t;
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 void create_table(std::vector<ColumnProperties> const &schema);
 
+/**
+ * @brief Create an index on the Storable table if not exists
+ * @param Storable Any type that satisfies is_storable_v
+ * @param index The name and columns of the index
+ *
+ * Creates the following SQLite3 command:
+ * @n CREATE INDEX IF NOT EXISTS index_name ON table_name (
+ * @n  column_1,
+ * @n  column_2,
+ * @n  ...
+ * @n  );
+ *
+ * Usage:
+ * @n database::utils::create_index<food::Entry>({"Entry_time", {"timestamp"}});
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+void create_index(Index const &index);
+
 /**
  * @brief Delete Storable object from datbase and cache of storables
- * @param storable Any type that is a base of Storable
+ * @param storable Any type that satisfies is_storable_v
  *
  * Creates the following SQLite3 command:
  * @n DELETE
@@ -117,12 +221,12 @@ void create_table(std::vector<ColumnProperties> const &schema);
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 void delete_storable(Storable const &storable);
 
 /**
  * @brief Deletes the Storable table from the database
- * @param Storable Any type that is a base of Storable
+ * @param Storable Any type that satisfies is_storable_v
  *
  * Creates the following SQLite3 command:
  * DROP TABLE table_name;
@@ -133,7 +237,7 @@ void delete_storable(Storable const &storable);
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 void drop_table();
 
 /**
@@ -149,11 +253,37 @@ void drop_table();
  */
 template <typename DataEnum,
           typename std::enable_if_t<std::is_enum_v<DataEnum>, int> = 0>
-auto enum_to_string(DataEnum const &data_enum) -> std::string_view;
+constexpr auto enum_to_string(DataEnum const &data_enum) -> std::string_view;
+
+/**
+ * @brief Executes a single SQL statement on the database connection. Every
+ *        statement issued by database::utils goes through here.
+ *
+ * @param sql_command The SQL statement, with :name placeholders for the
+ *                    parameters
+ * @param parameters Values bound to the placeholders, in order of appearance
+ * @param error_message The message of the runtime error thrown if the
+ *                      statement fails
+ * @param into soci::into targets that receive the first row of the result
+ *
+ * Statements slower than the SlowQueryLog threshold are recorded in the slow
+ * query log along with their query plan.
+ *
+ * Usage:
+ * @n size_t num_rows = 0;
+ * @n utils::execute("SELECT count(*) FROM Food WHERE fat > :fat", {10.0},
+ * @n                "Attempt to count fatty foods failed.",
+ * @n                soci::into(num_rows));
+ *
+ * Will throw a runtime error if the statement fails
+ */
+template <typename... Into>
+void execute(std::string const &sql_command, Parameters parameters,
+             std::string_view error_message, Into &&... into);
 
 /**
  * @brief Generates new unique ID for the type being asked for
- * @param Storable Any type that is a base of Storable
+ * @param Storable Any type that satisfies is_storable_v
  * @return A new id that is not being used by the database for this Storable
  *         type
  *
@@ -163,7 +293,7 @@ auto enum_to_string(DataEnum const &data_enum) -> std::string_view;
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 auto get_new_id() -> int;
 
 /**
@@ -179,8 +309,11 @@ auto get_new_id() -> int;
  * @n column2 ,..)
  * @n VALUES
  * @n (
- * @n value1,
- * @n value2 ,...);
+ * @n :column1,
+ * @n :column2 ,...);
+ *
+ * The values of the row are bound to the placeholders, they are never
+ * written into the statement.
  *
  * Usage:
  * @n food::Food taco("taco", macros);
@@ -189,9 +322,24 @@ auto get_new_id() -> int;
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 void insert(Storable const &storable);
 
+/**
+ * @param Storable Any type that satisfies is_storable_v
+ * @return true if retrieve_all returns the cache without reading the table
+ *
+ * Usage:
+ * @n if (!database::utils::is_cached<food::Food>()) {
+ * @n   // load the table in the background
+ * @n }
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+auto is_cached() -> bool;
+
 /**
  * @brief Generates a new Storable object stores it in the cache, inserts it
  *        into the database, and returns a reference to tht new object.
@@ -205,7 +353,7 @@ void insert(Storable const &storable);
 template <
     typename Storable, typename... Args,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 auto make(Args &&... args) -> Storable &;
 
 /**
@@ -231,12 +379,116 @@ auto make(Args &&... args) -> Storable &;
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 auto retrieve_all() -> std::vector<Storable, struct Storable::Allocator> &;
 
+/**
+ * @brief Retrieves the next limit database objects after the object with id
+ *        after_id, in order of id
+ * @param Storable The type of storable object being retrieved
+ * @param after_id Objects with this id or lower are skipped, 0 to start from
+ *                 the first object
+ * @param limit The largest number of objects to retrieve
+ * @return A new vector with the objects, empty past the end of the table
+ *
+ * Seeks the primary key, so reading a table chunk by chunk costs the same as
+ * reading it at once. The cache is neither used nor filled, which makes this
+ * safe to call from a thread that is not using the connection otherwise. See
+ * cache_chunk.
+ *
+ * Creates the following SQLite3 command:
+ * @n SELECT * FROM Storable
+ * @n WHERE Storable_id > :after_id
+ * @n ORDER BY Storable_id LIMIT :limit;
+ *
+ * Usage:
+ * @n int last_id = 0;
+ * @n auto chunk = database::utils::retrieve_chunk<food::Food>(last_id, 1000);
+ * @n while (!chunk.empty()) {
+ * @n   last_id = chunk.back().id();
+ * @n   // do something
+ * @n   chunk = database::utils::retrieve_chunk<food::Food>(last_id, 1000);
+ * @n }
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+auto retrieve_chunk(int after_id, size_t limit)
+    -> std::vector<Storable, struct Storable::Allocator>;
+
+/**
+ * @brief Retrieves the database objects whose column lies in [lower, upper)
+ * @param Storable The type of storable object being retrieved
+ * @param column The column to filter by, should be the first column of an
+ *               index so the query seeks instead of scanning the table
+ * @param lower The inclusive lower bound of the column
+ * @param upper The exclusive upper bound of the column
+ * @return A new vector with the matching objects sorted by column
+ *
+ * Unlike retrieve_all, only the matching rows are read and the cache is
+ * neither used nor filled. The objects returned are copies, updating one
+ * updates the cached object with its id as well, see update.
+ *
+ * Creates the following SQLite3 command:
+ * @n SELECT * FROM Storable
+ * @n WHERE column >= :lower AND column < :upper
+ * @n ORDER BY column;
+ *
+ * Will throw a runtime error if column is not a column of the table
+ *
+ * Usage:
+ * @n auto const lunch = database::utils::retrieve_range<food::Entry>(
+ * @n     "timestamp", noon, one_pm);
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+auto retrieve_range(std::string_view column, Row::row_data_t const &lower,
+                    Row::row_data_t const &upper)
+    -> std::vector<Storable, struct Storable::Allocator>;
+
+/**
+ * @brief Sets the number of threads retrieve_all loads a table with
+ *
+ * With more than one thread, the ids of a large table are split in ranges
+ * and every range is decoded on its own thread and read connection. The
+ * ranges are then merged into the cache in id order. Tables of an in memory
+ * database and small tables are always loaded on the calling thread.
+ *
+ * Usage:
+ * @n database::utils::set_load_threads(std::thread::hardware_concurrency());
+ */
+void set_load_threads(size_t num_threads);
+
+/**
+ * @brief Calls listener every time a Storable is inserted, updated or deleted
+ * @param Storable Any type that satisfies is_storable_v
+ * @param listener Called after the object is inserted or updated, and before
+ *                 it is deleted from the cache
+ * @return An id to unsubscribe the listener with
+ *
+ * Listeners are called on the thread that made the change. Objects changed
+ * with SQL that does not go through database::utils are not reported. See
+ * Subscription to unsubscribe when an object holding a listener goes away.
+ *
+ * Usage:
+ * @n auto const id = database::utils::subscribe<food::Food>(
+ * @n     [](food::Food const &food, database::utils::Change change) {
+ * @n       // do something
+ * @n     });
+ * @n database::utils::unsubscribe<food::Food>(id);
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+auto subscribe(Listener<Storable> listener) -> size_t;
+
 /**
  * @brief Check if Storable table exists in database
- * @param Storable Any type that is a base of Storable
+ * @param Storable Any type that satisfies is_storable_v
  * @return true if the table exists, false otherwise
  *
  * Creates the following SQLite3 command:
@@ -250,9 +502,18 @@ auto retrieve_all() -> std::vector<Storable, struct Storable::Allocator> &;
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 auto table_exists() -> bool;
 
+/**
+ * @brief The name of the table storing T, its type without the namespaces
+ *        (e.g. namespace::other_namespace::ClassName -> "ClassName")
+ *
+ * Usage:
+ * @n static_assert(database::utils::table_name<food::Food>() == "Food");
+ */
+template <typename T> constexpr auto table_name() -> std::string_view;
+
 /**
  * @brief Converts a type to a string and trims the namespaces off.
  *                 (e.g. namespace::other_namespace::ClassName -> "ClassName")
@@ -273,10 +534,10 @@ template <typename T> auto type_to_string() -> std::string;
  *
  * Creates the following SQLite3 command:
  * @n UPDATE Storable
- * @n SET column_1 = new_value_1,
- * @n     colimn_2 = new_value_2,
+ * @n SET column_1 = :column_1,
+ * @n     column_2 = :column_2,
  * @n     ...
- * @n WHERE Storable_id = Storable_id_value;
+ * @n WHERE Storable_id = :id;
  *
  * Usage:
  * @n auto all_food = database::utils::retrieve_all<food::Food>();
@@ -286,14 +547,69 @@ template <typename T> auto type_to_string() -> std::string;
  * @n   database::utils::update(my_food);
  * @n  }
  *
+ * If the table is cached and storable is a copy, e.g. from retrieve_range,
+ * the cached object with its id is updated as well.
+ *
  * Will throw a runtime error if food is not in the database!
  */
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int> = 0>
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
 void update(Storable const &storable);
 
+/**
+ * @brief Stops calling a listener added with subscribe
+ * @param Storable Any type that satisfies is_storable_v
+ * @param id The id subscribe returned
+ */
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int> = 0>
+void unsubscribe(size_t id);
+
+/**
+ * @brief A listener added with subscribe for as long as the subscription
+ *        lives
+ * @param Storable Any type that satisfies is_storable_v
+ *
+ * Move only, the listener is unsubscribed once by whichever subscription
+ * holds it when it is destroyed or reset.
+ *
+ * Usage:
+ * @n database::utils::Subscription<food::Food> const subscription(
+ * @n     [](food::Food const &food, database::utils::Change change) {
+ * @n       // do something
+ * @n     });
+ */
+template <typename Storable> class Subscription {
+  static_assert(database::is_storable_v<Storable>,
+                "Only Storable changes can be subscribed to");
+
+public:
+  Subscription() = default;
+
+  explicit Subscription(Listener<Storable> listener);
+
+  Subscription(Subscription &&subscription) noexcept;
+  Subscription &operator=(Subscription &&subscription) noexcept;
+
+  Subscription(Subscription const &) = delete;
+  Subscription &operator=(Subscription const &) = delete;
+
+  ~Subscription();
+
+  /**
+   * @brief Unsubscribes the listener, if there is one
+   */
+  void reset();
+
+private:
+  size_t id_ = 0;
+  bool subscribed_ = false;
+};
+
 /**
  * @brief Updates the Storable objects data within the database
  * @param handler A handler that will handle for the row_data_t once
@@ -322,14 +638,486 @@ void visit_row_data(Lambda const &handler, Row::row_data_t const &row_data);
 
 ///////////////////////////// Implementation Below /////////////////////////////
 
-namespace {
+namespace database::utils::detail {
 /*
  * @brief flag used to determine if data has been loaded into cache or not
+ *
+ * Inline so every translation unit shares the same flag as the cache in
+ * retrieve_all.
+ */
+template <typename Storable> inline bool data_is_loaded = false;
+
+template <typename Storable> inline bool table_exists_flag = false;
+
+/**
+ * @brief Set once the indexes of the table were made, see create_indexes
+ */
+template <typename Storable> inline bool indexes_exist = false;
+
+/**
+ * @brief Set while the outermost batch runs
+ */
+inline bool in_batch = false;
+
+/**
+ * @brief Undoes the changes the outermost batch made to the caches, called
+ *        in reverse order once its transaction was rolled back
+ */
+inline std::vector<std::function<void()>> batch_undo;
+
+/**
+ * @brief The text of the statements database::utils issues for a table.
+ *        Values are always bound to placeholders, so the text only depends
+ *        on the table and is made once, see statements.
+ */
+struct Statements {
+  std::string count_rows;
+  std::string delete_storable;
+  std::string drop_table;
+  std::string select_all;
+  std::string select_chunk;
+  std::string select_one;
+
+  /**
+   * @brief Counts the columns of the table with a name
+   */
+  std::string has_column;
+
+  /**
+   * @brief Columns retrieve_range found in the table, the only text it
+   *        writes into its statement that is not made here
+   */
+  std::unordered_set<std::string> range_columns;
+
+  /**
+   * @brief The smallest and largest id, and every row in a range of ids.
+   *        Used to load a table in partitions.
+   */
+  std::string id_range;
+  std::string select_ids;
+
+  /**
+   * @brief Made from the schema, empty until the first row is written
+   */
+  std::string insert;
+
+  /**
+   * @brief Every column but the id is set, the id finds the row. Placeholder
+   *        ?n is column n of the schema, counting from 1.
+   */
+  std::string update;
+};
+
+/**
+ * @return The statements of the table storing Storable
+ */
+template <typename Storable> auto statements() -> Statements &
+{
+  static Statements statements = [] {
+    std::string const table(utils::table_name<Storable>());
+    std::string const id_column = table + "_id";
+
+    Statements made;
+    made.count_rows = "SELECT count(*) FROM " + table;
+    made.delete_storable =
+        "DELETE FROM " + table + " WHERE " + id_column + " = :id";
+    made.drop_table = "DROP TABLE " + table;
+    made.select_all = "SELECT * FROM " + table;
+    made.select_chunk = "SELECT * FROM " + table + "\nWHERE " + id_column +
+                        " > :after_id\nORDER BY " + id_column +
+                        " LIMIT :limit";
+    made.select_one =
+        "SELECT * FROM " + table + " WHERE " + id_column + " = :id";
+    made.has_column = "SELECT count(*) FROM pragma_table_info('" + table +
+                      "') WHERE name = :column";
+    made.id_range =
+        "SELECT min(" + id_column + "), max(" + id_column + ") FROM " + table;
+    made.select_ids = "SELECT * FROM " + table + "\nWHERE " + id_column +
+                      " >= :lower AND " + id_column + " < :upper\nORDER BY " +
+                      id_column;
+    return made;
+  }();
+
+  return statements;
+}
+
+/**
+ * @return The statements of the table storing Storable, with insert and
+ *         update made from schema if they were not yet
+ */
+template <typename Storable>
+auto statements(std::vector<ColumnProperties> const &schema) -> Statements &
+{
+  auto &made = detail::statements<Storable>();
+  if (!made.insert.empty()) { return made; }
+
+  std::string const table(utils::table_name<Storable>());
+  std::string const id_column = table + "_id";
+
+  std::stringstream insert;
+  std::stringstream values;
+  std::stringstream update;
+  insert << "INSERT INTO " << table << " (";
+  values << ") VALUES (";
+  update << "UPDATE " << table << " SET ";
+
+  auto delimeter = "";
+  auto update_delimeter = "";
+  size_t id_placeholder = 0;
+  for (size_t i = 0; i < schema.size(); ++i) {
+    auto const &column = schema[i].name;
+    insert << delimeter << column;
+    values << delimeter << ':' << column;
+    delimeter = ", ";
+
+    if (column == id_column) {
+      id_placeholder = i + 1;
+      continue;
+    }
+
+    update << update_delimeter << column << " = ?" << i + 1;
+    update_delimeter = ", ";
+  }
+
+  values << ")";
+  update << " WHERE " << id_column << " = ?" << id_placeholder;
+
+  made.insert = insert.str() + values.str();
+  made.update = update.str();
+  return made;
+}
+
+/**
+ * @brief Makes the indexes of the table the first time it is used, tables
+ *        made before an index was added to Data::indexes get it as well
+ * @param storable Any object of the table, the indexes are read from it
+ */
+template <typename Storable> void create_indexes(Storable const &storable)
+{
+  if (indexes_exist<Storable>) { return; }
+  indexes_exist<Storable> = true;
+
+  for (auto const &index : storable.get_data().indexes) {
+    utils::create_index<Storable>(index);
+  }
+}
+
+/**
+ * @brief A listener added with subscribe
+ */
+template <typename Storable> struct Subscriber {
+  size_t id;
+  Listener<Storable> listener;
+
+  /**
+   * @brief Unsubscribed while listeners were being called, erased once they
+   *        are done
+   */
+  bool removed = false;
+};
+
+/**
+ * @brief Listeners added with subscribe, in order
+ */
+template <typename Storable>
+inline std::vector<Subscriber<Storable>> listeners;
+
+/**
+ * @brief Listeners added while listeners were being called, appended once
+ *        they are done
+ */
+template <typename Storable>
+inline std::vector<Subscriber<Storable>> added_listeners;
+
+template <typename Storable> inline size_t next_listener_id = 0;
+
+/**
+ * @brief The number of calls to notify in progress, a listener may change a
+ *        Storable itself
+ */
+template <typename Storable> inline size_t notifying = 0;
+
+/**
+ * @brief Erases the listeners removed and appends the listeners added while
+ *        listeners were being called
+ */
+template <typename Storable> void settle_listeners()
+{
+  auto &current = listeners<Storable>;
+  current.erase(std::remove_if(begin(current), end(current),
+                               [](Subscriber<Storable> const &subscriber) {
+                                 return subscriber.removed;
+                               }),
+                end(current));
+
+  auto &added = added_listeners<Storable>;
+  current.insert(end(current), std::make_move_iterator(begin(added)),
+                 std::make_move_iterator(end(added)));
+  added.clear();
+}
+
+/**
+ * @brief Calls every listener of Storable with the change made to storable
+ *
+ * The listeners are neither copied nor moved while they are called. One that
+ * is unsubscribed meanwhile is not called again, one that is subscribed is
+ * called from the next change on.
+ */
+template <typename Storable>
+void notify(Storable const &storable, Change change)
+{
+  auto &current = listeners<Storable>;
+  if (current.empty()) { return; }
+
+  ++notifying<Storable>;
+  try {
+    for (size_t i = 0; i < current.size(); ++i) {
+      if (!current[i].removed) { current[i].listener(storable, change); }
+    }
+  } catch (...) {
+    if (--notifying<Storable> == 0) { settle_listeners<Storable>(); }
+    throw;
+  }
+
+  if (--notifying<Storable> == 0) { settle_listeners<Storable>(); }
+}
+
+/**
+ * @brief Runs a SELECT statement and constructs a Storable from every row of
+ *        the result at the end of storables
+ * @param sql_command A SELECT statement returning every column of the table
+ * @param parameters Values bound to the placeholders, in order of appearance
+ * @param storables The vector the new objects are appended to
+ * @param sql_connection The connection the statement runs on
+ */
+template <typename Storable>
+void select_into(std::string const &sql_command, Parameters parameters,
+                 std::vector<Storable, struct Storable::Allocator> &storables,
+                 soci::session &sql_connection = Database::get_connection())
+{
+
+  // Not a single statement execution, rows are streamed with step below
+  auto const start = std::chrono::steady_clock::now();
+
+  try {
+    TRACKER_TRACE_SCOPE("sqlite", "execute");
+
+    Statement statement(sql_connection, sql_command);
+    statement.bind(parameters);
+
+    // Schema contains the column names to map the data correctly
+    std::vector<ColumnProperties> schema;
+
+    // One row is decoded at a time. Each storable is constructed while its
+    // row is current, BLOB columns are views of the row SQLite holds.
+    Row row;
+    while (statement.step()) {
+      int const num_columns = statement.column_count();
+      if (schema.empty()) {
+        schema.reserve(num_columns);
+        for (int i = 0; i < num_columns; ++i) {
+          ColumnProperties column_property;
+          column_property.name = statement.column_name(i);
+          schema.emplace_back(column_property);
+        }
+      }
+
+      row.row_data.clear();
+      for (int i = 0; i < num_columns; ++i) {
+        row.row_data.emplace_back(statement.column(i));
+      }
+
+      storables.emplace_back(schema, row);
+    }
+  } catch (std::runtime_error const &error) {
+    std::cerr << error.what() << std::endl;
+    std::cerr << sql_command << std::endl;
+    throw std::runtime_error(" Failed to retrieve storables from database");
+  }
+
+  SlowQueryLog::record(sql_command, parameters,
+                       std::chrono::steady_clock::now() - start,
+                       sql_connection);
+}
+
+/**
+ * @brief Threads retrieve_all loads a table with, see set_load_threads
+ */
+inline size_t load_threads = 1;
+
+/**
+ * @brief Tables are not split in partitions smaller than this, the threads
+ *        and connections would cost more than they save
+ */
+inline constexpr size_t min_partition_rows = 4096;
+
+/**
+ * @brief Loads every row of the table into the empty cache storables, a range
+ *        of ids per thread
+ * @param num_rows The number of rows in the table
+ * @return false if the table was not loaded, because it is small or in
+ *         memory, and should be loaded on this thread
+ */
+template <typename Storable>
+auto load_partitioned(
+    size_t num_rows,
+    std::vector<Storable, struct Storable::Allocator> &storables) -> bool
+{
+  size_t const num_partitions =
+      std::min(load_threads, num_rows / min_partition_rows);
+  if (num_partitions < 2) { return false; }
+
+  TRACKER_TRACE_SCOPE("database", "utils::load_partitioned");
+
+  // Opened up front, sessions are not opened concurrently
+  std::vector<std::unique_ptr<soci::session>> connections;
+  for (size_t i = 0; i < num_partitions; ++i) {
+    auto connection = Database::open_read_connection();
+    if (!connection) { return false; }
+    connections.push_back(std::move(connection));
+  }
+
+  int min_id = 0;
+  int max_id = 0;
+  utils::execute(statements<Storable>().id_range, {},
+                 "Attempt to read the range of ids failed.",
+                 soci::into(min_id), soci::into(max_id));
+
+  // Ids are split evenly, deleted rows leave some partitions smaller
+  long long const num_ids = static_cast<long long>(max_id) - min_id + 1;
+  auto const boundary = [&](size_t partition) {
+    long long const offset = num_ids * static_cast<long long>(partition) /
+                             static_cast<long long>(num_partitions);
+    return static_cast<int>(min_id + offset);
+  };
+
+  using Partition = std::vector<Storable, struct Storable::Allocator>;
+  std::vector<Partition> partitions(num_partitions);
+  std::vector<std::exception_ptr> errors(num_partitions);
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_partitions);
+  for (size_t i = 0; i < num_partitions; ++i) {
+    threads.emplace_back([&, i, lower = boundary(i), upper = boundary(i + 1)] {
+      try {
+        TRACKER_TRACE_SCOPE("database", "utils::load_partition");
+
+        partitions[i].reserve(num_rows / num_partitions);
+        select_into(statements<Storable>().select_ids, {lower, upper},
+                    partitions[i], *connections[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto const &error : errors) {
+    if (error) { std::rethrow_exception(error); }
+  }
+
+  // The ranges are disjoint and in order, appending them keeps ids sorted
+  storables.reserve(num_rows);
+  for (auto &partition : partitions) {
+    storables.insert(end(storables), std::make_move_iterator(begin(partition)),
+                     std::make_move_iterator(end(partition)));
+  }
+
+  return true;
+}
+
+/**
+ * @brief Removes an object made in a batch from the cache
+ */
+template <typename Storable> void undo_insert(int id)
+{
+  auto &storables = utils::retrieve_all<Storable>();
+  auto const compare = [](Storable const &lhs, int id) {
+    return lhs.id() < id;
+  };
+
+  auto found = std::lower_bound(begin(storables), end(storables), id, compare);
+  if (found == end(storables) || found->id() != id) { return; }
+
+  notify(*found, Change::DELETED);
+  storables.erase(found);
+}
+
+/**
+ * @brief Reads an object updated in a batch back from the rolled back table
  */
-template <typename Storable> static bool data_is_loaded = false;
+template <typename Storable> void undo_update(int id)
+{
+  auto &storables = utils::retrieve_all<Storable>();
+  auto const compare = [](Storable const &lhs, int id) {
+    return lhs.id() < id;
+  };
+
+  auto found = std::lower_bound(begin(storables), end(storables), id, compare);
+  if (found == end(storables) || found->id() != id) { return; }
+
+  // Made in the same batch, undone on its own
+  std::vector<Storable, struct Storable::Allocator> restored;
+  select_into(statements<Storable>().select_one, {id}, restored);
+  if (restored.empty()) { return; }
+
+  *found = std::move(restored.front());
+  notify(*found, Change::UPDATED);
+}
+
+/**
+ * @brief Puts an object deleted in a batch back into the cache
+ */
+template <typename Storable> void undo_delete(Storable storable)
+{
+  auto &storables = utils::retrieve_all<Storable>();
+  auto const compare = [](Storable const &lhs, int id) {
+    return lhs.id() < id;
+  };
+
+  auto const position = std::lower_bound(begin(storables), end(storables),
+                                         storable.id(), compare);
+  notify(*storables.insert(position, std::move(storable)), Change::INSERTED);
+}
 
-template <typename Storable> static bool table_exists_flag = false;
-} // namespace
+} // namespace database::utils::detail
+
+template <typename Function> void database::utils::batch(Function &&write)
+{
+  if (detail::in_batch) {
+    write();
+    return;
+  }
+
+  TRACKER_TRACE_SCOPE("database", "utils::batch");
+
+  // Rolled back when destroyed before the commit
+  soci::transaction transaction(Database::get_connection());
+
+  detail::in_batch = true;
+  try {
+    write();
+    transaction.commit();
+  } catch (...) {
+    detail::in_batch = false;
+
+    // The caches are read back from the rolled back tables
+    auto undo = std::move(detail::batch_undo);
+    detail::batch_undo.clear();
+    transaction.rollback();
+
+    for (auto change = rbegin(undo); change != rend(undo); ++change) {
+      (*change)();
+    }
+    throw;
+  }
+
+  detail::in_batch = false;
+  detail::batch_undo.clear();
+}
 
 template <class ForwardIt, class T, class Compare>
 auto database::utils::binary_find(ForwardIt first, ForwardIt last,
@@ -342,41 +1130,76 @@ auto database::utils::binary_find(ForwardIt first, ForwardIt last,
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
-inline auto database::utils::count_rows() -> size_t
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+inline void database::utils::cache_chunk(
+    std::vector<Storable, struct Storable::Allocator> &&chunk)
 {
-  if (!utils::table_exists<Storable>()) { return 0; }
+  TRACKER_TRACE_SCOPE("database", "utils::cache_chunk");
 
-  auto &sql_connection = Database::get_connection();
-  auto const table_name = utils::type_to_string<Storable>();
+  // Marked first, retrieve_all must not read the table while it streams in
+  detail::data_is_loaded<Storable> = true;
+  auto &storables = utils::retrieve_all<Storable>();
 
-  std::stringstream sql_command;
-  sql_command << "SELECT count(*) from " << table_name << ";\n";
+  if (chunk.empty()) { return; }
 
-  size_t num_rows = 0;
-  try {
-    sql_connection << sql_command.str(), soci::into(num_rows);
-  } catch (soci::sqlite3_soci_error const &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error(
-        "Attempt to count the number of rows in table failed.");
+  if (!storables.empty() && chunk.front().id() <= storables.back().id()) {
+    std::cerr << "Chunk starting at id " << chunk.front().id()
+              << " overlaps the cache ending at id " << storables.back().id()
+              << std::endl;
+    throw std::runtime_error("Chunks must be cached in order of id");
   }
 
+  storables.reserve(storables.size() + chunk.size());
+  storables.insert(end(storables), std::make_move_iterator(begin(chunk)),
+                   std::make_move_iterator(end(chunk)));
+}
+
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+inline void database::utils::clear_cache()
+{
+  // Nothing has been cached, calling retrieve_all would load the table
+  if (detail::data_is_loaded<Storable>) {
+    utils::retrieve_all<Storable>().clear();
+  }
+
+  detail::data_is_loaded<Storable> = false;
+  detail::table_exists_flag<Storable> = false;
+  detail::indexes_exist<Storable> = false;
+}
+
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+inline auto database::utils::count_rows() -> size_t
+{
+  TRACKER_TRACE_SCOPE("database", "utils::count_rows");
+
+  if (!utils::table_exists<Storable>()) { return 0; }
+
+  size_t num_rows = 0;
+  utils::execute(detail::statements<Storable>().count_rows, {},
+                 "Attempt to count the number of rows in table failed.",
+                 soci::into(num_rows));
+
   return num_rows;
 }
 
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 inline void
 database::utils::create_table(std::vector<ColumnProperties> const &schema)
 {
-  auto const table_name = utils::type_to_string<Storable>();
+  TRACKER_TRACE_SCOPE("database", "utils::create_table");
 
   std::stringstream sql_command;
-  sql_command << "CREATE TABLE IF NOT EXISTS " << table_name << " (\n";
+  sql_command << "CREATE TABLE IF NOT EXISTS " << utils::table_name<Storable>()
+              << " (\n";
 
   auto delimeter = "";
   for (auto const &[name, data_type, constraint] : schema) {
@@ -388,25 +1211,42 @@ database::utils::create_table(std::vector<ColumnProperties> const &schema)
 
   sql_command << ");\n";
 
-  auto &sql_connection = Database::get_connection();
+  utils::execute(sql_command.str(), {}, "Attempt to create table failed!");
 
-  try {
-    sql_connection << sql_command.str();
-  } catch (soci::sqlite3_soci_error const &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error("Attempt to create table failed!");
+  detail::table_exists_flag<Storable> = true;
+}
+
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+inline void database::utils::create_index(Index const &index)
+{
+  TRACKER_TRACE_SCOPE("database", "utils::create_index");
+
+  std::stringstream sql_command;
+  sql_command << "CREATE INDEX IF NOT EXISTS " << index.name << " ON "
+              << utils::table_name<Storable>() << " (\n";
+
+  auto delimeter = "";
+  for (auto const &column : index.columns) {
+    sql_command << delimeter << column;
+    delimeter = ",\n";
   }
 
-  table_exists_flag<Storable> = true;
+  sql_command << ");\n";
+
+  utils::execute(sql_command.str(), {}, "Attempt to create index failed!");
 }
 
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 void database::utils::delete_storable(Storable const &storable)
 {
+  TRACKER_TRACE_SCOPE("database", "utils::delete_storable");
+
   auto &storables = utils::retrieve_all<Storable>();
 
   auto const compare = [](Storable const &lhs, Storable const &rhs) {
@@ -421,22 +1261,20 @@ void database::utils::delete_storable(Storable const &storable)
     throw std::runtime_error("Impossible to delete an id that doesn't exist");
   }
 
-  auto &sql_connection = Database::get_connection();
-  auto const table_name = utils::type_to_string<Storable>();
-
   // Need to delete from database first, otherwise if we delete from
   // the vector of storables first, the references to the storable we're
   // referring to changes to a different ID.
-  std::stringstream sql_command;
-  sql_command << "DELETE FROM " << table_name << " WHERE " << table_name
-              << "_id = " << storable.id();
+  utils::execute(detail::statements<Storable>().delete_storable,
+                 {storable.id()},
+                 "Attempt to delete object failed!");
 
-  try {
-    sql_connection << sql_command.str();
-  } catch (soci::sqlite3_soci_error const &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error("Attempt to delete object failed!");
+  // Listeners get the cached object, storable may refer to it
+  detail::notify(*found, Change::DELETED);
+
+  if (detail::in_batch) {
+    auto deleted = std::make_shared<Storable>(std::move(*found));
+    detail::batch_undo.emplace_back(
+        [deleted] { detail::undo_delete<Storable>(std::move(*deleted)); });
   }
 
   storables.erase(found);
@@ -445,63 +1283,122 @@ void database::utils::delete_storable(Storable const &storable)
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 inline void database::utils::drop_table()
 {
+  TRACKER_TRACE_SCOPE("database", "utils::drop_table");
+
   // Table doesn't exist, already 'dropped'
   if (!utils::table_exists<Storable>()) { return; }
 
   auto &all_storables = utils::retrieve_all<Storable>();
   all_storables.clear();
 
-  auto &sql_connection = Database::get_connection();
-  auto const table_name = utils::type_to_string<Storable>();
-
-  std::stringstream sql_command;
-  sql_command << "DROP TABLE " << table_name << "\n";
+  utils::execute(detail::statements<Storable>().drop_table, {},
+                 "Attempt to drop table failed!");
 
-  try {
-    sql_connection << sql_command.str();
-  } catch (soci::sqlite3_soci_error const &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error("Attempt to drop table failed!");
-  }
-
-  table_exists_flag<Storable> = false;
+  detail::table_exists_flag<Storable> = false;
+  detail::indexes_exist<Storable> = false;
 }
 
 template <typename DataEnum,
           typename std::enable_if_t<std::is_enum_v<DataEnum>, int>>
-inline auto database::utils::enum_to_string(DataEnum const &data_enum)
+constexpr auto database::utils::enum_to_string(DataEnum const &data_enum)
     -> std::string_view
 {
   if constexpr (std::is_same_v<DataEnum, DataType>) {
-    static std::unordered_map<DataType, std::string_view> type_strings{
-        {DataType::REAL, "REAL"},
-        {DataType::INTEGER, "INTEGER"},
-        {DataType::TEXT, "TEXT"},
-        {DataType::NULL_, "NULL"},
-        {DataType::BLOB, "BLOB"}};
-
-    return type_strings[data_enum];
+    switch (data_enum) {
+    case DataType::REAL:
+      return "REAL";
+    case DataType::INTEGER:
+      return "INTEGER";
+    case DataType::BIGINT:
+      return "BIGINT";
+    case DataType::TEXT:
+      return "TEXT";
+    case DataType::NULL_:
+      return "NULL";
+    case DataType::BLOB:
+      return "BLOB";
+    case DataType::TIMESTAMP:
+      return "TIMESTAMP";
+    }
   } else { // Constraint Enum
-    static std::unordered_map<Constraint, std::string_view> type_strings{
-        {Constraint::PRIMARY_KEY, "PRIMARY KEY"},
-        {Constraint::UNIQUE, "UNIQUE"},
-        {Constraint::NOT_NULL, "NOT NULL"},
-        {Constraint::CHECK, "CHECK"}};
+    switch (data_enum) {
+    case Constraint::PRIMARY_KEY:
+      return "PRIMARY KEY";
+    case Constraint::UNIQUE:
+      return "UNIQUE";
+    case Constraint::NOT_NULL:
+      return "NOT NULL";
+    case Constraint::CHECK:
+      return "CHECK";
+    }
+  }
+
+  return "";
+}
+
+template <typename... Into>
+void database::utils::execute(std::string const &sql_command,
+                              Parameters parameters,
+                              std::string_view error_message, Into &&... into)
+{
+  TRACKER_TRACE_SCOPE("sqlite", "execute");
+
+  auto &sql_connection = Database::get_connection();
+  auto const start = std::chrono::steady_clock::now();
 
-    return type_strings[data_enum];
+  try {
+    if constexpr (sizeof...(Into) == 0) {
+      // BLOB parameters are bound in place
+      Statement statement(sql_connection, sql_command);
+      statement.bind(parameters);
+      while (statement.step()) {}
+    } else {
+      soci::statement statement(sql_connection);
+      (statement.exchange(std::forward<Into>(into)), ...);
+
+      for (auto const &parameter : parameters) {
+        std::visit(
+            [&statement](auto const &value) {
+              using T = std::decay_t<decltype(value)>;
+              if constexpr (std::is_same_v<T, ByteView>) {
+                throw std::runtime_error("BLOB parameters can not be bound to "
+                                         "a statement with results");
+              } else if constexpr (std::is_same_v<T, Timestamp>) {
+                statement.exchange(soci::use(value.seconds));
+              } else {
+                statement.exchange(soci::use(value));
+              }
+            },
+            parameter);
+      }
+
+      statement.alloc();
+      statement.prepare(sql_command);
+      statement.define_and_bind();
+      statement.execute(true);
+    }
+  } catch (std::runtime_error const &error) {
+    std::cerr << error.what() << std::endl;
+    std::cerr << sql_command << std::endl;
+    throw std::runtime_error(std::string(error_message));
   }
+
+  SlowQueryLog::record(sql_command, parameters,
+                       std::chrono::steady_clock::now() - start,
+                       sql_connection);
 }
 
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 auto database::utils::get_new_id() -> int
 {
+  TRACKER_TRACE_SCOPE("database", "utils::get_new_id");
+
   auto &storables = utils::retrieve_all<Storable>();
 
   int new_id = 0;
@@ -536,9 +1433,11 @@ auto database::utils::get_new_id() -> int
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 inline void database::utils::insert(Storable const &storable)
 {
+  TRACKER_TRACE_SCOPE("database", "utils::insert");
+
   auto &storables = utils::retrieve_all<Storable>();
   auto const compare = [](Storable const &lhs, Storable const &rhs) {
     return lhs.id() < rhs.id();
@@ -556,55 +1455,47 @@ inline void database::utils::insert(Storable const &storable)
 
   if (!utils::table_exists<Storable>()) {
     utils::create_table<Storable>(data.schema);
-    data_is_loaded<Storable> = true;
-  }
-
-  std::stringstream sql_command;
-  sql_command << "INSERT INTO " << data.table_name << "(\n";
+    detail::data_is_loaded<Storable> = true;
 
-  std::stringstream column_names;
-  std::stringstream column_values;
-  column_values << "VALUES\n(\n";
+    if (detail::in_batch) {
+      detail::batch_undo.emplace_back([] {
+        detail::table_exists_flag<Storable> = false;
+        detail::indexes_exist<Storable> = false;
+      });
+    }
+  }
+  detail::create_indexes(storable);
 
   // The row will be of length one because it
   // comes from a single Storable object
-  auto delimeter = "";
-  for (auto const &[column, row_data] :
-       ranges::view::zip(data.schema, data.rows[0].row_data)) {
-    column_names << delimeter << column.name;
-    column_values << delimeter;
-
-    // Prevent dangling reference with capture init
-    auto const visitor = [&col_vals = column_values](auto const &row_data) {
-      col_vals << row_data;
-    };
-
-    utils::visit_row_data(visitor, row_data);
+  utils::execute(detail::statements<Storable>(data.schema).insert,
+                 data.rows[0].row_data, "Attempt to insert storabled failed!");
 
-    delimeter = ",\n";
+  if (detail::in_batch) {
+    detail::batch_undo.emplace_back(
+        [id = storable.id()] { detail::undo_insert<Storable>(id); });
   }
 
-  column_names << ")\n";
-  column_values << ")\n";
-
-  sql_command << column_names.str() << column_values.str();
-  auto &sql_connection = Database::get_connection();
+  detail::notify(storable, Change::INSERTED);
+}
 
-  try {
-    sql_connection << sql_command.str();
-  } catch (const soci::sqlite3_soci_error &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error("Attempt to insert storabled failed!");
-  }
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+inline auto database::utils::is_cached() -> bool
+{
+  return detail::data_is_loaded<Storable>;
 }
 
 template <
     typename Storable, typename... Args,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 auto database::utils::make(Args &&... args) -> Storable &
 {
+  TRACKER_TRACE_SCOPE("database", "utils::make");
+
   int const id = utils::get_new_id<Storable>();
   auto &storables = database::utils::retrieve_all<Storable>();
 
@@ -625,183 +1516,268 @@ auto database::utils::make(Args &&... args) -> Storable &
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 inline auto database::utils::retrieve_all()
     -> std::vector<Storable, struct Storable::Allocator> &
 {
   static std::vector<Storable, struct Storable::Allocator> storables;
 
-  if (!data_is_loaded<Storable>) {
-    data_is_loaded<Storable> = true;
-    auto const table_name = utils::type_to_string<Storable>();
+  if (!detail::data_is_loaded<Storable>) {
+    TRACKER_TRACE_SCOPE("database", "utils::retrieve_all");
+
+    detail::data_is_loaded<Storable> = true;
 
-    auto &sql_connection = Database::get_connection();
     size_t num_rows = utils::count_rows<Storable>();
     if (num_rows == 0) return storables;
 
-    std::stringstream sql_command;
-    sql_command << "SELECT * from " << table_name;
-
-    soci::row from_row;
-    soci::statement statement =
-        (sql_connection.prepare << sql_command.str(), soci::into(from_row));
-    try {
-      statement.execute();
-    } catch (soci::sqlite3_soci_error const &error) {
-      std::cerr << error.what() << std::endl;
-      std::cerr << sql_command.str() << std::endl;
-      throw std::runtime_error(
-          " Failed to retrieve all storables from database");
+    storables.reserve(num_rows);
+    if (!detail::load_partitioned(num_rows, storables)) {
+      detail::select_into(detail::statements<Storable>().select_all, {},
+                          storables);
     }
 
-    // Schema contains the column names to map the data correctly
-    std::vector<ColumnProperties> schema;
-    schema.reserve(from_row.size());
+    if (!storables.empty()) { detail::create_indexes(storables.front()); }
+  }
 
-    std::vector<Row> to_rows;
-    to_rows.reserve(num_rows);
+  return storables;
+}
 
-    while (statement.fetch()) {
-      // Getting data from soci row to tracker row
-      Row to_row;
-      to_row.row_data.reserve(from_row.size());
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+auto database::utils::retrieve_chunk(int after_id, size_t limit)
+    -> std::vector<Storable, struct Storable::Allocator>
+{
+  TRACKER_TRACE_SCOPE("database", "utils::retrieve_chunk");
 
-      for (size_t i = 0; i < from_row.size(); ++i) {
-        soci::column_properties const &props = from_row.get_properties(i);
+  std::vector<Storable, struct Storable::Allocator> storables;
+  if (!utils::table_exists<Storable>()) { return storables; }
 
-        if (schema.size() < from_row.size()) {
-          ColumnProperties column_property;
-          column_property.name = props.get_name();
-          schema.emplace_back(column_property);
-        }
+  storables.reserve(limit);
+  detail::select_into(detail::statements<Storable>().select_chunk,
+                      {after_id, static_cast<long long>(limit)}, storables);
 
-        switch (props.get_data_type()) {
-        case soci::dt_double:
-          to_row.row_data.emplace_back(from_row.get<double>(i));
-          break;
-        case soci::dt_string:
-          to_row.row_data.emplace_back(from_row.get<std::string>(i));
-          break;
-        case soci::dt_integer:
-          to_row.row_data.emplace_back(from_row.get<int>(i));
-          break;
-        case soci::dt_long_long:
-          to_row.row_data.emplace_back(from_row.get<long long>(i));
-          break;
-        case soci::dt_unsigned_long_long:
-          to_row.row_data.emplace_back(from_row.get<unsigned long long>(i));
-          break;
-        case soci::dt_date:
-          to_row.row_data.emplace_back(from_row.get<std::tm>(i));
-          break;
-        default:
-          throw std::runtime_error("Invalid variant type get!");
-        }
-      }
+  return storables;
+}
 
-      to_rows.emplace_back(to_row);
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+auto database::utils::retrieve_range(std::string_view column,
+                                     Row::row_data_t const &lower,
+                                     Row::row_data_t const &upper)
+    -> std::vector<Storable, struct Storable::Allocator>
+{
+  TRACKER_TRACE_SCOPE("database", "utils::retrieve_range");
+
+  std::vector<Storable, struct Storable::Allocator> storables;
+  if (!utils::table_exists<Storable>()) { return storables; }
+
+  // The column is written into the statement, it must name a column
+  auto &statements = detail::statements<Storable>();
+  std::string checked(column);
+  if (statements.range_columns.count(checked) == 0) {
+    size_t found = 0;
+    utils::execute(statements.has_column, {checked},
+                   "Attempt to find the column to retrieve by failed.",
+                   soci::into(found));
+
+    if (found == 0) {
+      std::cerr << "No column " << column << " in table "
+                << utils::table_name<Storable>() << std::endl;
+      throw std::runtime_error("Storables can only be retrieved by a column");
     }
 
-    // This is done after fetching the data from the rows
-    // because while(statement.fetch()) goes into an infinite
-    // loop if this is done inside the loop because we insert/update
-    // storable data as they're constructed
-    storables.reserve(num_rows);
-    for (auto const &row : to_rows) {
-      storables.emplace_back(schema, row);
-    }
+    statements.range_columns.emplace(std::move(checked));
   }
 
+  // The column varies between calls, unlike the statements made once
+  std::stringstream sql_command;
+  sql_command << "SELECT * FROM " << utils::table_name<Storable>() << "\n";
+  sql_command << "WHERE " << column << " >= :lower AND " << column
+              << " < :upper\n";
+  sql_command << "ORDER BY " << column;
+
+  detail::select_into(sql_command.str(), {lower, upper}, storables);
+
+  // Read without an object to take the indexes from, the next range has them
+  if (!storables.empty()) { detail::create_indexes(storables.front()); }
+
   return storables;
 }
 
+inline void database::utils::set_load_threads(size_t num_threads)
+{
+  detail::load_threads = std::max<size_t>(num_threads, 1);
+}
+
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+auto database::utils::subscribe(Listener<Storable> listener) -> size_t
+{
+  size_t const id = detail::next_listener_id<Storable>++;
+
+  // The listeners being called must not move
+  auto &listeners = detail::notifying<Storable> == 0
+                        ? detail::listeners<Storable>
+                        : detail::added_listeners<Storable>;
+  listeners.push_back({id, std::move(listener)});
+  return id;
+}
+
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 auto database::utils::table_exists() -> bool
 {
-  if (!table_exists_flag<Storable>) {
-    auto &sql_connection = Database::get_connection();
-    auto const table_name = utils::type_to_string<Storable>();
+  if (!detail::table_exists_flag<Storable>) {
+    TRACKER_TRACE_SCOPE("database", "utils::table_exists");
 
-    std::stringstream sql_command;
-    sql_command
-        << "SELECT name FROM sqlite_master WHERE type='table' AND name='"
-        << table_name << "';\n";
+    std::string const sql_command =
+        "SELECT name FROM sqlite_master WHERE type='table' AND name = :name;";
 
     std::string exists;
-    try {
-      sql_connection << sql_command.str(), soci::into(exists);
-    } catch (soci::sqlite3_soci_error const &error) {
-      std::cerr << error.what() << std::endl;
-      std::cerr << sql_command.str() << std::endl;
-      throw std::runtime_error("Attempt to check if table exists failed.");
-    }
+    utils::execute(sql_command,
+                   {std::string(utils::table_name<Storable>())},
+                   "Attempt to check if table exists failed.",
+                   soci::into(exists));
 
-    table_exists_flag<Storable> = !exists.empty();
+    detail::table_exists_flag<Storable> = !exists.empty();
   }
 
-  return table_exists_flag<Storable>;
+  return detail::table_exists_flag<Storable>;
 }
 
 template <typename T>
-inline auto database::utils::type_to_string() -> std::string
+constexpr auto database::utils::table_name() -> std::string_view
 {
-  constexpr auto type_string = nameof::nameof_type<std::decay_t<T>>();
+  constexpr std::string_view type_string =
+      nameof::nameof_type<std::decay_t<T>>();
 
   // namespace::Class -> Class
   // "Class" is the table name
-  std::string const table_name = type_string | ranges::view::reverse |
-                                 ranges::view::delimit(':') |
-                                 ranges::view::reverse;
-  return table_name;
+  constexpr size_t last_colon = type_string.rfind(':');
+  if constexpr (last_colon == std::string_view::npos) {
+    return type_string;
+  } else {
+    return type_string.substr(last_colon + 1);
+  }
+}
+
+template <typename T>
+inline auto database::utils::type_to_string() -> std::string
+{
+  return std::string(utils::table_name<T>());
 }
 
 template <
     typename Storable,
     typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
+        database::is_storable_v<std::decay_t<Storable>>, int>>
 void database::utils::update(Storable const &storable)
 {
-  auto &sql_connection = Database::get_connection();
+  TRACKER_TRACE_SCOPE("database", "utils::update");
+
+  detail::create_indexes(storable);
 
   // Data contains all of the table information
   // (e.g. table_name, schema and row(s) of data)
   Data const &data = storable.get_data();
 
-  std::stringstream sql_command;
-  sql_command << "UPDATE " << data.table_name << "\n";
-  sql_command << "SET ";
+  // The placeholders of update are numbered by column, the row is bound as is
+  utils::execute(detail::statements<Storable>(data.schema).update,
+                 data.rows[0].row_data, "Attempt to update food failed.");
 
-  auto delimeter = "\n";
-  // build this part of the SQL command: column_name = column_data,
-  for (auto const &[column, row_data] :
-       ranges::view::zip(data.schema, data.rows[0].row_data)) {
-    // We need the food id to find the object
-    // in the database.
-    if (column.name == data.table_name + "_id") { continue; }
+  // A copy must not leave the cached object behind
+  if (utils::is_cached<Storable>()) {
+    auto &storables = utils::retrieve_all<Storable>();
+    auto const compare = [](Storable const &lhs, Storable const &rhs) {
+      return lhs.id() < rhs.id();
+    };
+    auto found =
+        utils::binary_find(begin(storables), end(storables), storable, compare);
 
-    sql_command << delimeter << column.name << " = ";
+    // Copied as is, the cached object shares what the copy owns
+    if (found != end(storables) && &*found != &storable) { *found = storable; }
+  }
 
-    utils::visit_row_data(
-        [&sql_command = sql_command](auto const &row_data) {
-          sql_command << row_data;
-        },
-        row_data);
+  if (detail::in_batch) {
+    detail::batch_undo.emplace_back(
+        [id = storable.id()] { detail::undo_update<Storable>(id); });
+  }
 
-    delimeter = ",\n";
+  detail::notify(storable, Change::UPDATED);
+}
+
+template <
+    typename Storable,
+    typename std::enable_if_t<
+        database::is_storable_v<std::decay_t<Storable>>, int>>
+void database::utils::unsubscribe(size_t id)
+{
+  auto const has_id = [id](detail::Subscriber<Storable> const &subscriber) {
+    return subscriber.id == id;
+  };
+
+  auto &added = detail::added_listeners<Storable>;
+  added.erase(std::remove_if(begin(added), end(added), has_id), end(added));
+
+  auto &listeners = detail::listeners<Storable>;
+  if (detail::notifying<Storable> == 0) {
+    listeners.erase(std::remove_if(begin(listeners), end(listeners), has_id),
+                    end(listeners));
+    return;
   }
 
-  sql_command << "\nWHERE " << data.table_name << "_id = " << storable.id();
+  // Marked rather than erased, the listener may be running
+  auto const found = std::find_if(begin(listeners), end(listeners), has_id);
+  if (found != end(listeners)) { found->removed = true; }
+}
 
-  try {
-    sql_connection << sql_command.str();
-  } catch (soci::sqlite3_soci_error const &error) {
-    std::cerr << error.what() << std::endl;
-    std::cerr << sql_command.str() << std::endl;
-    throw std::runtime_error("Attempt to update food failed.");
+template <typename Storable>
+database::utils::Subscription<Storable>::Subscription(
+    Listener<Storable> listener)
+    : id_{utils::subscribe<Storable>(std::move(listener))}, subscribed_{true}
+{}
+
+template <typename Storable>
+database::utils::Subscription<Storable>::Subscription(
+    Subscription &&subscription) noexcept
+    : id_{subscription.id_}, subscribed_{subscription.subscribed_}
+{
+  subscription.subscribed_ = false;
+}
+
+template <typename Storable>
+auto database::utils::Subscription<Storable>::operator=(
+    Subscription &&subscription) noexcept -> Subscription &
+{
+  if (this != &subscription) {
+    this->reset();
+    id_ = subscription.id_;
+    subscribed_ = subscription.subscribed_;
+    subscription.subscribed_ = false;
   }
+
+  return *this;
+}
+
+template <typename Storable>
+database::utils::Subscription<Storable>::~Subscription()
+{
+  this->reset();
+}
+
+template <typename Storable>
+void database::utils::Subscription<Storable>::reset()
+{
+  if (subscribed_) { utils::unsubscribe<Storable>(id_); }
+  subscribed_ = false;
 }
 
 template <typename Lambda>
@@ -830,8 +1806,10 @@ void database::utils::visit_row_data(Lambda const &handler,
     handler(std::get<unsigned long long>(row_data));
     break;
   case soci::dt_date:
-    char buffer[50];
-    handler(asctime_r(&std::get<std::tm>(row_data), buffer));
+    handler(std::get<Timestamp>(row_data).seconds);
+    break;
+  case soci::dt_blob:
+    handler(std::get<ByteView>(row_data));
     break;
   default:
     throw std::runtime_error("Invalid variant type get!");
@@ -0,0 +1,111 @@
+/**
+ * @file DailyTotals.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Macronutrients eaten per day, with the total of any range of days in
+ *        O(log n)
+ */
+
+#pragma once
+
+#include "food/Macronutrients.hpp"
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Macronutrients eaten per day, with the total of any range of days in
+ *        O(log n)
+ *
+ * Days are numbered consecutively (e.g. days since the epoch) and stored in a
+ * Fenwick tree, so adding to a day and summing a range of days are both
+ * O(log n) in the number of days covered. The covered days grow by doubling
+ * as days outside of them are added, up to max_covered_days. A day too far
+ * from the covered ones to be covered, e.g. from a mistyped year, is kept
+ * on its own and summed one by one.
+ *
+ * Usage:
+ * @n food::DailyTotals totals;
+ * @n totals.add(day, breakfast);
+ * @n totals.add(day + 1, lunch);
+ * @n auto const week = totals.total(day, day + 6);
+ */
+class DailyTotals {
+public:
+  /**
+   * @brief The most days covered at once, about 90 years
+   */
+  static constexpr size_t max_covered_days = 1 << 15;
+
+  /**
+   * @brief Adds macros to the total of day
+   */
+  void add(long long day, Macronutrients const &macros);
+
+  /**
+   * @brief Subtracts macros from the total of day
+   */
+  void subtract(long long day, Macronutrients const &macros);
+
+  /**
+   * @return The macronutrients eaten from first_day to last_day, both
+   *         inclusive. Days never added count as nothing eaten.
+   */
+  auto total(long long first_day, long long last_day) const -> Macronutrients;
+
+  /**
+   * @return The macronutrients eaten on day
+   */
+  auto day(long long day) const -> Macronutrients;
+
+  /**
+   * @brief Forgets every day
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Grows the covered days to include day, unless that would cover
+   *        more than max_covered_days
+   * @return false if day is not covered
+   */
+  auto cover(long long day) -> bool;
+
+  /**
+   * @brief Builds the tree from days_ in O(n)
+   */
+  void rebuild();
+
+  /**
+   * @return The sum of the first count covered days
+   */
+  auto prefix(size_t count) const -> Macronutrients;
+
+  /**
+   * @brief The day days_[0] holds
+   */
+  long long first_day_ = 0;
+
+  /**
+   * @brief The total of each covered day
+   */
+  std::vector<Macronutrients> days_;
+
+  /**
+   * @brief The Fenwick tree over days_, 1 based
+   */
+  std::vector<Macronutrients> tree_;
+
+  /**
+   * @brief The total of each day that is not covered
+   */
+  std::map<long long, Macronutrients> far_days_;
+};
+
+} // namespace food
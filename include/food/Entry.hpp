@@ -0,0 +1,249 @@
+/**
+ * @file Entry.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief An entry in the food diary, a portion of a food eaten at some time
+ */
+
+#pragma once
+
+#include "database/Memory.hpp"
+#include "database/Storable.hpp"
+#include "database/utils.hpp"
+
+#include <soci.h>
+
+#include <ctime>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The meal an entry was eaten at
+ */
+enum class Meal { BREAKFAST, LUNCH, DINNER, SNACK };
+
+/**
+ * @brief An entry in the food diary, a portion of a food eaten at some time
+ *
+ * The timestamp is stored as seconds since the epoch in a column with a
+ * covering index, so the entries of any time range can be read without
+ * loading the whole diary. See entries_between.
+ */
+class Entry final : public database::Storable {
+public:
+  Entry(Entry &&e) = default;
+
+  Entry &operator=(Entry const &e) = default;
+  Entry &operator=(Entry &&e) = default;
+
+  /**
+   * @brief All data will be retrieved from a storable object using this
+   *        function.
+   *
+   * @return A struct containing the name of the table to store this data,
+   *         a vector of column info and the indexes of the table. See
+   *         Data.hpp for more info.
+   */
+  auto get_data() const -> database::Data const override;
+
+  /**
+   *  @return The unique ID of this entry in the database
+   */
+  auto id() const -> int override
+  {
+    return this->id_;
+  }
+
+  /**
+   * @return The name of the food eaten, empty if the food no longer exists
+   */
+  auto name() const -> std::string_view override;
+
+  /**
+   * @brief Changes the food eaten to the food with this name
+   *
+   * Will throw a runtime error if no food has this name
+   */
+  void set_name(std::string_view name) override;
+
+  /**
+   * @return string representation of the name and data, the same way sqlite
+   *         displays table data
+   */
+  auto str() const -> std::string override;
+
+  /**
+   * @return The id of the food eaten
+   */
+  auto food_id() const -> int;
+
+  /**
+   * @param food_id The id of the food eaten
+   */
+  void set_food_id(int food_id);
+
+  /**
+   * @return The grams of food eaten
+   */
+  auto grams() const -> double;
+
+  /**
+   * @param grams The grams of food eaten
+   */
+  void set_grams(double grams);
+
+  /**
+   * @return When the food was eaten, in seconds since the epoch
+   */
+  auto timestamp() const -> std::time_t;
+
+  /**
+   * @param timestamp When the food was eaten, in seconds since the epoch
+   */
+  void set_timestamp(std::time_t timestamp);
+
+  /**
+   * @return The meal the food was eaten at
+   */
+  auto meal() const -> Meal;
+
+  /**
+   * @param meal The meal the food was eaten at
+   */
+  void set_meal(Meal meal);
+
+  ~Entry() override = default;
+
+  /**
+   * @brief Custom allocator that allows database utils to own a vector
+   *        of storable objects with private constructors. Allocates from
+   *        the pool shared by every cache, see database::cache_resource.
+   */
+  struct Allocator : std::pmr::polymorphic_allocator<Entry> {
+    Allocator()
+        : std::pmr::polymorphic_allocator<Entry>(database::cache_resource())
+    {}
+
+    /**
+     * @brief Allocates from resource instead, e.g. for an object that is
+     *        released on its own rather than with its cache
+     */
+    explicit Allocator(std::pmr::memory_resource *resource)
+        : std::pmr::polymorphic_allocator<Entry>(resource)
+    {}
+
+    /**
+     * @brief Copies of a cache allocate from the pool as well
+     */
+    auto select_on_container_copy_construction() const -> Allocator
+    {
+      return {};
+    }
+
+    template <class Entry, typename... Args>
+    void construct(Entry *buffer, Args &&... args)
+    {
+      /**
+       * @brief In place new construction of storable by memory pool that is
+       *        given
+       */
+      new (buffer) Entry(std::forward<Args>(args)...);
+    }
+
+    template <class Entry> struct rebind {
+      using other = Allocator;
+    };
+  };
+
+  friend struct Allocator;
+
+private:
+  Entry() = default;
+  Entry(Entry const &e) = default;
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   */
+  explicit Entry(int id);
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   * @param food_id The id of the food eaten
+   * @param grams The grams of food eaten
+   * @param timestamp When the food was eaten, in seconds since the epoch
+   * @param meal The meal the food was eaten at
+   */
+  Entry(int id, int food_id, double grams, std::time_t timestamp, Meal meal);
+
+  /**
+   * @param A schema for this Storable object
+   * @param The row of data to construct the object
+   */
+  Entry(std::vector<database::ColumnProperties> const &schema,
+        database::Row const &data);
+
+  /**
+   * @brief When creating new entry objects from data retrieved from the
+   *        database, this function will be used to set the data for the
+   *        Storable object.
+   *
+   * @param schema A vector containing the properties of each column that make
+   *               up a schema
+   *
+   * @param data A row of data to set the object data
+   */
+  void set_data(std::vector<database::ColumnProperties> const &schema,
+                database::Row const &data) override;
+
+  /**
+   *  @brief The unique ID of this entry in the database
+   */
+  int id_ = 0;
+
+  /**
+   *  @brief The id of the food eaten
+   */
+  int food_id_ = 0;
+
+  /**
+   *  @brief The grams of food eaten
+   */
+  double grams_ = 0;
+
+  /**
+   *  @brief When the food was eaten, in seconds since the epoch
+   */
+  std::time_t timestamp_ = 0;
+
+  /**
+   *  @brief The meal the food was eaten at
+   */
+  Meal meal_ = Meal::SNACK;
+};
+
+/**
+ * @brief Retrieves the diary entries eaten in [begin, end)
+ * @param begin The inclusive start of the range, in seconds since the epoch
+ * @param end The exclusive end of the range, in seconds since the epoch
+ * @return The entries sorted by timestamp
+ *
+ * Seeks the timestamp index, only the entries in range are read from the
+ * database.
+ *
+ * Usage:
+ * @n auto const today = food::entries_between(midnight, midnight + 86400);
+ * @n for(auto const &entry: today) {
+ * @n   // do something
+ * @n }
+ */
+auto entries_between(std::time_t begin, std::time_t end)
+    -> std::vector<Entry, Entry::Allocator>;
+
+} // namespace food
@@ -8,12 +8,15 @@
 
 #pragma once
 
+#include "database/Memory.hpp"
 #include "database/Storable.hpp"
 #include "database/utils.hpp"
 #include "food/Macronutrients.hpp"
 
 #include <soci.h>
 
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 
@@ -22,11 +25,29 @@
  */
 namespace food {
 
+/**
+ * @brief The type nutrient quantities are kept in by Food
+ *
+ * float when built with COMPACT_NUTRIENTS, which halves the nutrients of
+ * every cached food at the cost of keeping about 7 significant digits.
+ * Values written back to the database are rounded the same way.
+ */
+#ifdef TRACKER_COMPACT_NUTRIENTS
+using nutrient_t = float;
+#else
+using nutrient_t = double;
+#endif
+
 /**
  * @brief The food class stores all macronutrient and micronutrient data for any
  *        food
+ *
+ * Kept small since every food is cached, the name is a view into
+ * database::name_interner and the nutrients are stored as nutrient_t. A
+ * renamed food owns its new name instead, shared with its copies, so names
+ * typed by the user are freed along with the food.
  */
-class Food : public database::Storable {
+class Food final : public database::Storable {
 public:
   Food(Food &&f) = default;
 
@@ -46,12 +67,15 @@ public:
   /**
    *  @return The unique ID of this food in the database
    */
-  auto id() const -> int override;
+  auto id() const -> int override
+  {
+    return this->id_;
+  }
 
   /**
-   * @return The name of the food
+   * @return The name of the food, valid for the lifetime of the program
    */
-  auto name() const -> std::string const override;
+  auto name() const -> std::string_view override;
 
   /**
    * @return The name of the food
@@ -78,9 +102,30 @@ public:
 
   /**
    * @brief Custom allocator that allows database utils to own a vector
-   *        of storable objects with private constructors
+   *        of storable objects with private constructors. Allocates from
+   *        the pool shared by every cache, see database::cache_resource.
    */
-  struct Allocator : std::allocator<Food> {
+  struct Allocator : std::pmr::polymorphic_allocator<Food> {
+    Allocator()
+        : std::pmr::polymorphic_allocator<Food>(database::cache_resource())
+    {}
+
+    /**
+     * @brief Allocates from resource instead, e.g. for an object that is
+     *        released on its own rather than with its cache
+     */
+    explicit Allocator(std::pmr::memory_resource *resource)
+        : std::pmr::polymorphic_allocator<Food>(resource)
+    {}
+
+    /**
+     * @brief Copies of a cache allocate from the pool as well
+     */
+    auto select_on_container_copy_construction() const -> Allocator
+    {
+      return {};
+    }
+
     template <class Food, typename... Args>
     void construct(Food *buffer, Args &&... args)
     {
@@ -112,7 +157,7 @@ private:
    * @param macros The macronutrients the food contains
    * @param food_name The name of the food
    */
-  Food(int id, std::string food_name, Macronutrients macros);
+  Food(int id, std::string_view food_name, Macronutrients const &macros);
 
   /**
    * @param A schema for this Storable object
@@ -135,20 +180,34 @@ private:
   void set_data(std::vector<database::ColumnProperties> const &schema,
                 database::Row const &data) override;
 
+  /**
+   * @brief Stores macros in the members, rounded to nutrient_t
+   */
+  void store(Macronutrients const &macros);
+
   /**
    *  @brief The unique ID of this food in the database
    */
-  int id_;
+  int id_ = 0;
+
+  /**
+   *  @brief The name of the food, interned with database::intern_name or
+   *         a view of renamed_
+   */
+  std::string_view name_;
 
   /**
-   *  @brief The name of the food
+   *  @brief The name given by set_name, if any
    */
-  std::string name_;
+  std::shared_ptr<std::string const> renamed_;
 
   /**
    *  @brief The macronutrients of the food
    */
-  Macronutrients macronutrients_;
+  nutrient_t fat_ = 0;
+  nutrient_t carbohydrate_ = 0;
+  nutrient_t fiber_ = 0;
+  nutrient_t protein_ = 0;
 };
 
 } // namespace food
@@ -0,0 +1,154 @@
+/**
+ * @file IntakeRollup.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps the macronutrients eaten per day up to date with the food diary
+ */
+
+#pragma once
+
+#include "database/utils.hpp"
+#include "food/DailyTotals.hpp"
+#include "food/Entry.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <ctime>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Keeps the macronutrients eaten per day up to date with the food diary
+ *
+ * Built once from every Entry, then updated incrementally as entries are
+ * made, updated or deleted and as the foods they refer to change, through
+ * database::utils::subscribe. Totals of any range of days are O(log n). The
+ * days each change touches are passed on to a listener, see set_listener.
+ *
+ * Not thread safe, changes must be made on the thread that reads totals.
+ *
+ * Usage:
+ * @n food::IntakeRollup rollup;
+ * @n auto const today = rollup.day_of(std::time(nullptr));
+ * @n auto const last_week = rollup.total(today - 6, today);
+ */
+class IntakeRollup {
+public:
+  /**
+   * @brief Called with the days whose totals changed, sorted
+   */
+  using Listener = std::function<void(std::vector<long long> const &days)>;
+
+  /**
+   * @param utc_offset Seconds added to UTC timestamps to get the local time
+   *                   days start at
+   */
+  explicit IntakeRollup(std::time_t utc_offset = 0);
+
+  IntakeRollup(IntakeRollup const &) = delete;
+  IntakeRollup &operator=(IntakeRollup const &) = delete;
+
+  /**
+   * @return The day timestamp falls on, in days since the epoch
+   */
+  auto day_of(std::time_t timestamp) const -> long long;
+
+  /**
+   * @return The macronutrients eaten from first_day to last_day, both
+   *         inclusive, see day_of
+   */
+  auto total(long long first_day, long long last_day) const -> Macronutrients;
+
+  /**
+   * @return The days with at least one entry, sorted
+   */
+  auto days() const -> std::vector<long long>;
+
+  /**
+   * @return true if at least one entry was eaten on day
+   */
+  auto has_entries(long long day) const -> bool;
+
+  /**
+   * @brief Calls listener after every change of an entry or of a food that
+   *        was eaten, not on rebuild
+   */
+  void set_listener(Listener listener);
+
+  /**
+   * @brief Reads every entry again, use after the diary was changed without
+   *        database::utils
+   */
+  void rebuild();
+
+private:
+  /**
+   * @brief What a single entry adds to its day
+   */
+  struct Contribution {
+    int food_id;
+    double grams;
+    long long day;
+    Macronutrients macros;
+  };
+
+  void on_entry(Entry const &entry, database::utils::Change change);
+
+  void on_food(Food const &food, database::utils::Change change);
+
+  /**
+   * @return What entry adds to its day
+   */
+  auto contribution_of(Entry const &entry) const -> Contribution;
+
+  /**
+   * @brief Adds an entry that has no contribution yet
+   */
+  void add(int entry_id, Contribution contribution);
+
+  /**
+   * @brief Removes the contribution of an entry, if any
+   * @return The day the entry was on, if it had a contribution
+   */
+  auto remove(int entry_id) -> std::optional<long long>;
+
+  /**
+   * @return The macronutrients in grams of the food, nothing if the food
+   *         does not exist
+   */
+  static auto portion(int food_id, double grams) -> Macronutrients;
+
+  std::time_t utc_offset_;
+
+  DailyTotals totals_;
+
+  /**
+   * @brief Contribution of every entry by entry id
+   */
+  std::unordered_map<int, Contribution> contributions_;
+
+  /**
+   * @brief The ids of the entries that refer to each food
+   */
+  std::unordered_map<int, std::vector<int>> entries_by_food_;
+
+  /**
+   * @brief The number of entries on each day with any
+   */
+  std::map<long long, size_t> entries_per_day_;
+
+  Listener listener_;
+
+  database::utils::Subscription<Entry> entry_listener_;
+  database::utils::Subscription<Food> food_listener_;
+};
+
+} // namespace food
@@ -0,0 +1,156 @@
+/**
+ * @file MacroTable.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Macronutrients of many foods stored column by column so energy and
+ *        totals can be computed with SIMD loops
+ */
+
+#pragma once
+
+#include "food/Macronutrients.hpp"
+
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Fraction of the energy of each food that comes from each
+ *        macronutrient. All three are 0 for foods without energy.
+ */
+struct MacroRatios {
+  std::vector<double> fat;
+  std::vector<double> carbohydrate;
+  std::vector<double> protein;
+};
+
+/**
+ * @brief Macronutrients of many foods in struct of arrays form
+ *
+ * Row i of every column belongs to the same food. The kernels run over the
+ * contiguous columns instead of over Food objects, so they vectorize.
+ *
+ * Usage:
+ * @n auto const &all_food = database::utils::retrieve_all<food::Food>();
+ * @n auto const table = food::MacroTable::from(all_food);
+ * @n std::vector<double> const kcal = table.kcal();
+ */
+class MacroTable {
+public:
+  MacroTable() = default;
+
+  /**
+   * @brief Builds a table from any range of objects with id() and
+   *        macronutrients(), such as the Food cache
+   */
+  template <typename Foods> static auto from(Foods const &foods) -> MacroTable;
+
+  /**
+   * @brief Adds a food at the end of the table
+   * @param id The id of the food
+   * @param macros The macronutrients of the food in grams per 100g
+   */
+  void push_back(int id, Macronutrients const &macros);
+
+  /**
+   * @brief Reserves room for num_foods foods in every column
+   */
+  void reserve(size_t num_foods);
+
+  /**
+   * @return The number of foods in the table
+   */
+  auto size() const -> size_t;
+
+  /**
+   * @return The macronutrients of the food in row
+   */
+  auto macronutrients(size_t row) const -> Macronutrients;
+
+  /**
+   * @return The food ids, in row order
+   */
+  auto ids() const -> std::vector<int> const &;
+
+  /**
+   * @return The fat column in grams per 100g
+   */
+  auto fat() const -> std::vector<double> const &;
+
+  /**
+   * @return The carbohydrate column in grams per 100g, including fiber
+   */
+  auto carbohydrate() const -> std::vector<double> const &;
+
+  /**
+   * @return The fiber column in grams per 100g
+   */
+  auto fiber() const -> std::vector<double> const &;
+
+  /**
+   * @return The protein column in grams per 100g
+   */
+  auto protein() const -> std::vector<double> const &;
+
+  /**
+   * @brief The energy of every food in kcal per 100g
+   *
+   * kcal = 9 * fat + 4 * (carbohydrate - fiber) + 2 * fiber + 4 * protein
+   */
+  auto kcal() const -> std::vector<double>;
+
+  /**
+   * @brief Writes the energy of every food in kcal per 100g to out, which
+   *        must have room for size() values
+   */
+  void kcal(double *out) const;
+
+  /**
+   * @brief Sums the macronutrients of a portion of every food
+   * @param grams The grams eaten of each food, in row order, must have size()
+   *              values
+   * @return The total grams of each macronutrient eaten
+   */
+  auto totals(std::vector<double> const &grams) const -> Macronutrients;
+
+  /**
+   * @brief Sums the energy of a portion of every food
+   * @param grams The grams eaten of each food, in row order, must have size()
+   *              values
+   * @return The total kcal eaten
+   */
+  auto total_kcal(std::vector<double> const &grams) const -> double;
+
+  /**
+   * @return The fraction of energy each macronutrient contributes to every
+   *         food
+   */
+  auto ratios() const -> MacroRatios;
+
+private:
+  std::vector<int> ids_;
+  std::vector<double> fat_;
+  std::vector<double> carbohydrate_;
+  std::vector<double> fiber_;
+  std::vector<double> protein_;
+};
+
+} // namespace food
+
+// template implementation
+
+template <typename Foods>
+auto food::MacroTable::from(Foods const &foods) -> MacroTable
+{
+  MacroTable table;
+  table.reserve(foods.size());
+
+  for (auto const &food : foods) {
+    table.push_back(food.id(), food.macronutrients());
+  }
+
+  return table;
+}
@@ -16,6 +16,19 @@
  */
 namespace food {
 
+/**
+ * @brief Energy density of each macronutrient in kcal per gram
+ *
+ * Carbohydrate is stored including fiber, the fiber part only contributes
+ * FIBER kcal per gram instead of CARBOHYDRATE.
+ */
+namespace energy {
+constexpr double FAT = 9.0;
+constexpr double CARBOHYDRATE = 4.0;
+constexpr double FIBER = 2.0;
+constexpr double PROTEIN = 4.0;
+} // namespace energy
+
 /**
  * @brief Stores the fat content of a food
  */
@@ -182,6 +195,27 @@ public:
    */
   void set_protein(double protein);
 
+  /**
+   * @return The energy in kcal per 100g of food, see food::energy
+   */
+  auto kcal() const -> double;
+
+  /**
+   * @brief Adds every macronutrient of macros to this one
+   */
+  auto operator+=(Macronutrients const &macros) -> Macronutrients &;
+
+  /**
+   * @brief Subtracts every macronutrient of macros from this one
+   */
+  auto operator-=(Macronutrients const &macros) -> Macronutrients &;
+
+  /**
+   * @brief Scales every macronutrient, e.g. by grams / 100 to get the
+   *        macronutrients of a portion
+   */
+  auto operator*=(double scale) -> Macronutrients &;
+
   ~Macronutrients() = default;
 
 private:
@@ -0,0 +1,184 @@
+/**
+ * @file MealPlanner.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Picks foods and amounts from the catalogue that hit macronutrient
+ *        targets
+ */
+
+#pragma once
+
+#include "food/MacroTable.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/MicronutrientMatrix.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief What a meal plan should add up to. A target of 0 is left out.
+ */
+struct MacroTargets {
+  double kcal = 0;
+  double fat = 0;
+
+  /**
+   * @brief Grams of carbohydrate, including fiber
+   */
+  double carbohydrate = 0;
+  double fiber = 0;
+  double protein = 0;
+
+  /**
+   * @brief How far each total may be from its target, as a fraction of it
+   */
+  double tolerance = 0.05;
+};
+
+/**
+ * @brief What the user allows in a meal plan
+ */
+struct MealLimits {
+  /**
+   * @brief The most foods a plan may have
+   */
+  size_t max_foods = 5;
+
+  /**
+   * @brief The least and most grams of a food in the plan
+   */
+  double min_grams = 20;
+  double max_grams = 400;
+
+  /**
+   * @brief Ids of foods that must not be in the plan
+   */
+  std::vector<int> excluded_foods;
+
+  /**
+   * @brief How many foods of the catalogue the plan is picked from, see
+   *        MealPlanner
+   */
+  size_t num_candidates = 48;
+
+  /**
+   * @brief Threads searching for the plan, 0 for one per core
+   */
+  size_t num_threads = 0;
+
+  /**
+   * @brief The search stops with the best plan so far once either limit is
+   *        reached
+   */
+  size_t max_nodes = 200000;
+  std::chrono::milliseconds time_limit{80};
+
+  /**
+   * @brief Stops at the first plan within the tolerance of every target
+   *        instead of searching for the closest one
+   */
+  bool first_within_tolerance = true;
+};
+
+/**
+ * @brief The foods picked and what they add up to
+ */
+struct MealPlan {
+  /**
+   * @brief Grams of every food in the plan, by increasing food id
+   */
+  std::vector<Portion> portions;
+
+  Macronutrients macronutrients;
+  double kcal = 0;
+
+  /**
+   * @brief The distance of every total from its target as a fraction of it,
+   *        added up. What the planner minimizes.
+   */
+  double deviation = 0;
+
+  /**
+   * @brief true if every total is within the tolerance of its target
+   */
+  bool within_tolerance = false;
+
+  /**
+   * @brief true if the whole search ran, so no plan deviates less
+   */
+  bool optimal = false;
+
+  /**
+   * @brief The number of branch and bound nodes solved
+   */
+  size_t nodes = 0;
+};
+
+/**
+ * @brief Picks at most MealLimits::max_foods foods, each between the least
+ *        and most grams allowed, whose totals are as close to the targets as
+ *        possible
+ *
+ * This is a small mixed integer program. The continuous relaxation is a
+ * linear program with one row per target, each with a slack on either side
+ * that measures the deviation, and one row bounding the number of foods.
+ * It is solved by a bounded primal simplex that keeps the inverse of the
+ * 6x6 basis.
+ *
+ * Only a few dozen foods of the catalogue take part. The planner first
+ * scores every food of the table against the targets in one pass over the
+ * columns: foods whose macronutrients come in the proportions of the
+ * targets, and the purest source of each macronutrient to correct the
+ * totals with. With that few columns, a simplex iteration is a handful of
+ * dot products.
+ *
+ * Branch and bound then fixes a food out of the plan or into it with at
+ * least the least grams. Each node starts the simplex from the basis its
+ * parent ended with, so it usually takes a few pivots. Nodes are shared by
+ * all threads and taken best bound first, the best plan found is shared as
+ * well and prunes nodes that can not improve on it.
+ *
+ * Usage:
+ * @n auto const &all_food = database::utils::retrieve_all<food::Food>();
+ * @n food::MealPlanner planner(food::MacroTable::from(all_food));
+ * @n auto const plan = planner.plan({2000, 70, 250, 30, 150});
+ */
+class MealPlanner {
+public:
+  explicit MealPlanner(MacroTable table);
+
+  /**
+   * @return The foods of the table that best hit the targets within the
+   *         limits. The plan is empty if no food can be picked.
+   */
+  auto plan(MacroTargets const &targets, MealLimits const &limits = {}) const
+      -> MealPlan;
+
+  /**
+   * @return The rows of the table the plan would be picked from, see
+   *         MealLimits::num_candidates
+   */
+  auto candidates(MacroTargets const &targets, MealLimits const &limits) const
+      -> std::vector<size_t>;
+
+  /**
+   * @return The foods the plans are picked from
+   */
+  auto table() const -> MacroTable const &;
+
+private:
+  MacroTable table_;
+
+  /**
+   * @brief The energy of every food in kcal per 100g
+   */
+  std::vector<double> kcal_;
+};
+
+} // namespace food
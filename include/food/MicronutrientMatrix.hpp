@@ -0,0 +1,185 @@
+/**
+ * @file MicronutrientMatrix.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Vitamins, minerals and amino acids of many foods stored as a sparse
+ *        matrix, with the totals of a day computed in one product
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The amount of one micronutrient in a food
+ */
+struct NutrientAmount {
+  /**
+   * @brief The column of the nutrient, e.g. its index in the nutrient list of
+   *        the food database the amounts come from
+   */
+  uint32_t nutrient = 0;
+
+  /**
+   * @brief The amount per 100g of food, in the unit of the nutrient
+   */
+  float amount = 0;
+};
+
+/**
+ * @brief The grams eaten of a food
+ */
+struct Portion {
+  int food_id = 0;
+  double grams = 0;
+};
+
+/**
+ * @brief Micronutrients of many foods as a compressed sparse row matrix
+ *
+ * Row i holds the food with the i-th smallest id, column j the j-th
+ * nutrient. A food only contains a handful of the ~150 nutrients tracked, so
+ * only the nonzero amounts are stored: the nutrients and amounts of every
+ * row one after the other, and where each row starts. Amounts are floats,
+ * nutrient databases do not list more than a few significant digits.
+ *
+ * The totals of a portion vector are the product of the transposed matrix
+ * with it. Every row adds its amounts, scaled by its portion, to the totals
+ * of its nutrients in a SIMD loop. A row holds each nutrient at most once,
+ * so the lanes never add to the same total.
+ *
+ * Usage:
+ * @n food::MicronutrientMatrix matrix(num_nutrients);
+ * @n matrix.push_back(taco.id(), {{vitamin_c, 2.5f}, {iron, 1.1f}});
+ * @n auto const today = matrix.totals_of(entries_of_today);
+ */
+class MicronutrientMatrix {
+public:
+  /**
+   * @param num_nutrients The number of columns, nutrients are numbered from 0
+   */
+  explicit MicronutrientMatrix(size_t num_nutrients);
+
+  /**
+   * @brief Adds a food after the last row
+   * @param id The id of the food, greater than every id in the matrix
+   * @param amounts The nutrients of the food in any order. Amounts of the
+   *                same nutrient are added, zero amounts are not stored.
+   *
+   * Will throw a runtime error if the id or a nutrient is out of range
+   */
+  void push_back(int id, std::vector<NutrientAmount> amounts);
+
+  /**
+   * @brief Reserves room for num_foods rows with num_amounts nonzero amounts
+   *        in total
+   */
+  void reserve(size_t num_foods, size_t num_amounts);
+
+  /**
+   * @return The number of foods in the matrix
+   */
+  auto size() const -> size_t;
+
+  /**
+   * @return The number of nutrients in the matrix
+   */
+  auto num_nutrients() const -> size_t;
+
+  /**
+   * @return The number of nonzero amounts stored
+   */
+  auto num_amounts() const -> size_t;
+
+  /**
+   * @return The row of the food with id, or size() if there is none
+   */
+  auto row(int id) const -> size_t;
+
+  /**
+   * @return The amount of nutrient per 100g of the food with id, 0 if the
+   *         food is not in the matrix
+   */
+  auto amount(int id, uint32_t nutrient) const -> float;
+
+  /**
+   * @return The food ids, in row order
+   */
+  auto ids() const -> std::vector<int> const &;
+
+  /**
+   * @return Where each row starts in nutrients() and amounts(), with a last
+   *         element one past the end of the last row
+   */
+  auto row_offsets() const -> std::vector<uint32_t> const &;
+
+  /**
+   * @return The nutrient of every nonzero amount, row after row
+   */
+  auto nutrients() const -> std::vector<uint32_t> const &;
+
+  /**
+   * @return Every nonzero amount, row after row
+   */
+  auto amounts() const -> std::vector<float> const &;
+
+  /**
+   * @brief Sums the micronutrients of a portion of every food
+   * @param grams The grams eaten of each food, in row order, must have size()
+   *              values. Foods with 0 grams are skipped.
+   * @return The total eaten of each nutrient
+   */
+  auto totals(std::vector<double> const &grams) const -> std::vector<double>;
+
+  /**
+   * @brief Sums the micronutrients of the portions
+   * @return The total eaten of each nutrient, foods not in the matrix
+   *         contribute nothing
+   */
+  auto totals(std::vector<Portion> const &portions) const
+      -> std::vector<double>;
+
+  /**
+   * @brief Sums the micronutrients of any range of objects with food_id()
+   *        and grams(), such as the entries of a day
+   */
+  template <typename Entries>
+  auto totals_of(Entries const &entries) const -> std::vector<double>;
+
+private:
+  /**
+   * @brief Adds grams of the food in row to totals
+   */
+  void accumulate(size_t row, double grams, double *totals) const;
+
+  size_t num_nutrients_;
+  std::vector<int> ids_;
+  std::vector<uint32_t> row_offsets_{0};
+  std::vector<uint32_t> nutrients_;
+  std::vector<float> amounts_;
+};
+
+} // namespace food
+
+// template implementation
+
+template <typename Entries>
+auto food::MicronutrientMatrix::totals_of(Entries const &entries) const
+    -> std::vector<double>
+{
+  std::vector<Portion> portions;
+  portions.reserve(entries.size());
+
+  for (auto const &entry : entries) {
+    portions.push_back(Portion{entry.food_id(), entry.grams()});
+  }
+
+  return this->totals(portions);
+}
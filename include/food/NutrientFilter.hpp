@@ -0,0 +1,65 @@
+/**
+ * @file NutrientFilter.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Filters the foods by nutrient ranges, kept up to date with the food
+ *        table
+ */
+
+#pragma once
+
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/NutrientIndex.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Finds the foods within nutrient ranges, for the filters of the food
+ *        list
+ *
+ * Built once from every Food into a NutrientIndex, then updated as foods are
+ * made, updated or deleted through database::utils::subscribe, so a filter
+ * never looks at the Food cache.
+ *
+ * Not thread safe, changes must be made on the thread that filters.
+ *
+ * Usage:
+ * @n food::NutrientFilter filter;
+ * @n auto const food_ids = filter.filter({{food::Nutrient::PROTEIN, 25},
+ * @n                                      {food::Nutrient::FAT, 0, 5}});
+ */
+class NutrientFilter {
+public:
+  NutrientFilter();
+
+  NutrientFilter(NutrientFilter const &) = delete;
+  NutrientFilter &operator=(NutrientFilter const &) = delete;
+
+  /**
+   * @return The ids of the foods within every range, by increasing id
+   */
+  auto filter(std::vector<NutrientRange> const &ranges) const
+      -> std::vector<int>;
+
+  /**
+   * @brief Reads every food again, use after foods were changed without
+   *        database::utils
+   */
+  void rebuild();
+
+private:
+  void on_food(Food const &food, database::utils::Change change);
+
+  NutrientIndex index_;
+
+  database::utils::Subscription<Food> food_listener_;
+};
+
+} // namespace food
@@ -0,0 +1,233 @@
+/**
+ * @file NutrientIndex.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Finds the foods whose nutrients fall in ranges, e.g. protein of at
+ *        least 25g and fat of at most 5g per 100g
+ */
+
+#pragma once
+
+#include "food/Macronutrients.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The nutrients a food can be filtered by, in grams per 100g except
+ *        KCAL, which is kcal per 100g
+ */
+enum class Nutrient { FAT, CARBOHYDRATE, FIBER, PROTEIN, KCAL };
+
+/**
+ * @brief Foods with a nutrient between min and max, both included
+ *
+ * Usage:
+ * @n food::NutrientRange const lean{food::Nutrient::FAT, 0, 5};
+ */
+struct NutrientRange {
+  Nutrient nutrient = Nutrient::FAT;
+  double min = -std::numeric_limits<double>::infinity();
+  double max = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief The nutrients of many foods, indexed for range filters
+ *
+ * The values of every nutrient are split into up to 256 bins at quantiles,
+ * and every bin lists the rows of its foods in increasing order. A range
+ * covers whole bins, whose rows are taken as they are, and at most two bins
+ * on its edges, whose rows are checked. Since the rows of a bin are in
+ * order, turning them into a bitmap of rows is a sweep over it.
+ *
+ * A filter starts from the range that covers the fewest rows. If they are
+ * few, they are checked against the other ranges one by one. Otherwise they
+ * are turned into a bitmap, which is ANDed with the bitmaps of the other
+ * ranges that are cheaper to build than checking the rows left, and the
+ * rest are checked row by row.
+ *
+ * An inserted or changed food gets a new row, which is appended to its
+ * bins, so the bins stay in order. The row it had before is marked dead.
+ * The index is built again without dead rows, and with new quantiles, once
+ * half of the rows are dead or it has twice the rows it was built with.
+ *
+ * Usage:
+ * @n auto const &all_food = database::utils::retrieve_all<food::Food>();
+ * @n auto const index = food::NutrientIndex::from(all_food);
+ * @n auto const food_ids = index.filter({{food::Nutrient::PROTEIN, 25},
+ * @n                                     {food::Nutrient::FAT, 0, 5},
+ * @n                                     {food::Nutrient::FIBER, 3}});
+ */
+class NutrientIndex {
+public:
+  NutrientIndex() = default;
+
+  /**
+   * @brief Builds an index from any range of objects with id() and
+   *        macronutrients(), such as the Food cache
+   */
+  template <typename Foods>
+  static auto from(Foods const &foods) -> NutrientIndex;
+
+  /**
+   * @brief Builds an index over foods, replacing the contents. The ids must
+   *        be unique.
+   * @param food_ids The id of every food
+   * @param macros The macronutrients of every food in grams per 100g
+   */
+  void build(std::vector<int> const &food_ids,
+             std::vector<Macronutrients> const &macros);
+
+  /**
+   * @brief Adds a food, or changes its nutrients if it is already indexed
+   */
+  void insert(int food_id, Macronutrients const &macros);
+
+  /**
+   * @brief Removes a food
+   * @return false if the food was not indexed
+   */
+  auto erase(int food_id) -> bool;
+
+  /**
+   * @return The ids of the foods within every range, in no particular order.
+   *         Every food if there are no ranges.
+   */
+  auto filter(std::vector<NutrientRange> const &ranges) const
+      -> std::vector<int>;
+
+  /**
+   * @return The number of foods indexed
+   */
+  auto size() const -> size_t;
+
+  void clear();
+
+private:
+  static constexpr size_t num_nutrients = 5;
+
+  using Bitmap = std::vector<uint64_t>;
+
+  /**
+   * @brief The rows of one nutrient with a value from the lowest of a bin up
+   *        to the lowest of the next one
+   */
+  struct Bins {
+    /**
+     * @brief The lowest value of every bin, the first one is -infinity
+     */
+    std::vector<double> lowest;
+    std::vector<std::vector<uint32_t>> rows;
+  };
+
+  /**
+   * @brief How a range covers the bins of its nutrient
+   */
+  struct Cover {
+    NutrientRange range;
+
+    /**
+     * @brief The first and last bin with rows that may be within the range
+     */
+    size_t first;
+    size_t last;
+
+    /**
+     * @brief The rows of those bins, dead rows included
+     */
+    size_t num_rows;
+  };
+
+  /**
+   * @brief Appends a row for a food to the columns and its bins
+   */
+  void append(int food_id, Macronutrients const &macros);
+
+  /**
+   * @brief Marks the row of a food dead
+   */
+  void kill(uint32_t row);
+
+  /**
+   * @brief Builds the index again from the rows that are not dead
+   */
+  void rebuild();
+
+  auto cover(NutrientRange const &range) const -> Cover;
+
+  /**
+   * @return true if every value the bin can hold is within the range of
+   *         cover
+   */
+  auto covers(Cover const &cover, size_t bin) const -> bool;
+
+  /**
+   * @return true if the value of the row is within the range
+   */
+  auto within(uint32_t row, NutrientRange const &range) const -> bool;
+
+  /**
+   * @brief Sets the bits of the rows within the range of cover, or of every
+   *        row not within it if complement is true. Dead rows may be set.
+   */
+  void mark(Cover const &cover, bool complement, Bitmap &rows) const;
+
+  /**
+   * @brief The food of every row, dead rows included
+   */
+  std::vector<int> food_ids_;
+
+  /**
+   * @brief The value of every row, one column per nutrient
+   */
+  std::array<std::vector<double>, num_nutrients> columns_;
+
+  std::array<Bins, num_nutrients> bins_;
+
+  /**
+   * @brief A set bit for every row that is not dead
+   */
+  Bitmap alive_;
+  size_t num_dead_ = 0;
+
+  /**
+   * @brief The number of rows when the quantiles were taken
+   */
+  size_t num_built_ = 0;
+
+  /**
+   * @brief The current row of every food
+   */
+  std::unordered_map<int, uint32_t> rows_;
+};
+
+} // namespace food
+
+// template implementation
+
+template <typename Foods>
+auto food::NutrientIndex::from(Foods const &foods) -> NutrientIndex
+{
+  std::vector<int> food_ids;
+  std::vector<Macronutrients> macros;
+  food_ids.reserve(foods.size());
+  macros.reserve(foods.size());
+
+  for (auto const &food : foods) {
+    food_ids.push_back(food.id());
+    macros.push_back(food.macronutrients());
+  }
+
+  NutrientIndex index;
+  index.build(food_ids, macros);
+  return index;
+}
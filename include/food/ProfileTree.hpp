@@ -0,0 +1,230 @@
+/**
+ * @file ProfileTree.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A k-d tree over the macronutrient profiles of foods, for finding
+ *        the foods most alike
+ */
+
+#pragma once
+
+#include "food/Macronutrients.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The fractions of a food's macronutrient grams that are fat,
+ *        carbohydrate other than fiber, fiber and protein, in that order.
+ *        All 0 for a food without macronutrients.
+ */
+using Profile = std::array<float, 4>;
+
+/**
+ * @return The profile of a food with macros
+ */
+auto profile(Macronutrients const &macros) -> Profile;
+
+/**
+ * @brief A food found by a nearest neighbour search
+ */
+struct Neighbour {
+  int food_id = 0;
+
+  /**
+   * @brief The euclidean distance between the profiles
+   */
+  float distance = 0;
+};
+
+/**
+ * @brief Food profiles in a k-d tree, with insertion and removal
+ *
+ * Every leaf holds a bucket of up to 64 profiles, one column per
+ * macronutrient, and distances to a whole bucket are computed in a SIMD
+ * loop. A search visits the leaf the query falls in first and then only
+ * the subtrees whose splitting plane is closer than the k-th best profile
+ * found so far.
+ *
+ * An insertion goes to the leaf its profile falls in, which splits at the
+ * median of its widest macronutrient once it is full. A removal takes the
+ * profile out of its bucket directly. The tree is rebuilt balanced once it
+ * had as many insertions and removals as it holds profiles, so the cost of
+ * rebuilding is spread over them. Profiles that are all the same can not be
+ * split and stay in one bucket.
+ *
+ * Usage:
+ * @n auto const &all_food = database::utils::retrieve_all<food::Food>();
+ * @n auto tree = food::ProfileTree::from(all_food);
+ * @n auto const alike = tree.nearest(food::profile(taco.macronutrients()), 10);
+ */
+class ProfileTree {
+public:
+  ProfileTree() = default;
+
+  /**
+   * @brief Builds a balanced tree from any range of objects with id() and
+   *        macronutrients(), such as the Food cache
+   */
+  template <typename Foods>
+  static auto from(Foods const &foods) -> ProfileTree;
+
+  /**
+   * @brief Builds a balanced tree from ids and their profiles, replacing
+   *        the contents. The ids must be unique.
+   */
+  void build(std::vector<int> const &food_ids,
+             std::vector<Profile> const &profiles);
+
+  /**
+   * @brief Adds a food, or moves it if it is already in the tree
+   */
+  void insert(int food_id, Profile const &profile);
+
+  /**
+   * @brief Removes a food
+   * @return false if the food was not in the tree
+   */
+  auto erase(int food_id) -> bool;
+
+  /**
+   * @return The profile of the food, nothing if it is not in the tree
+   */
+  auto find(int food_id) const -> std::optional<Profile>;
+
+  /**
+   * @return The k foods with the closest profiles, closest first. Ties are
+   *         broken by the smaller food id.
+   * @param excluded_food_id A food left out of the results, e.g. the one the
+   *                         profile is from, 0 for none
+   */
+  auto nearest(Profile const &profile, size_t k,
+               int excluded_food_id = 0) const -> std::vector<Neighbour>;
+
+  /**
+   * @return The number of foods in the tree
+   */
+  auto size() const -> size_t;
+
+  void clear();
+
+private:
+  /**
+   * @brief An inner node splits on one macronutrient, profiles less than
+   *        split go left. A leaf points to its bucket.
+   */
+  struct Node {
+    int axis = 0;
+    float split = 0;
+    int left = -1;
+    int right = -1;
+    int bucket = -1;
+  };
+
+  /**
+   * @brief The profiles of a leaf, one column per macronutrient
+   */
+  struct Bucket {
+    std::vector<int> food_ids;
+    std::array<std::vector<float>, 4> columns;
+  };
+
+  /**
+   * @brief Where a food is stored
+   */
+  struct Location {
+    int bucket;
+    int slot;
+  };
+
+  /**
+   * @brief A found food in the order of the results
+   */
+  struct Candidate {
+    float distance_squared;
+    int food_id;
+
+    auto operator<(Candidate const &other) const -> bool
+    {
+      if (distance_squared != other.distance_squared) {
+        return distance_squared < other.distance_squared;
+      }
+      return food_id < other.food_id;
+    }
+  };
+
+  /**
+   * @brief Builds the subtree holding the profiles of entries in
+   *        [first, last)
+   * @return The index of its root node
+   */
+  auto build(std::vector<std::pair<int, Profile>> &entries, size_t first,
+             size_t last) -> int;
+
+  /**
+   * @brief Makes a leaf with an empty bucket
+   * @return The index of the leaf node
+   */
+  auto make_leaf() -> int;
+
+  void append(int bucket, int food_id, Profile const &profile);
+
+  /**
+   * @brief Removes a food from its bucket, the last profile of the bucket
+   *        takes its slot
+   */
+  void take_out(std::unordered_map<int, Location>::iterator found);
+
+  /**
+   * @brief Splits the leaf in two if its profiles differ
+   */
+  void split(int node);
+
+  /**
+   * @brief Builds the tree again from the profiles it holds
+   */
+  void rebalance();
+
+  void search(int node, Profile const &profile, size_t k,
+              int excluded_food_id, std::vector<Candidate> &heap,
+              std::vector<float> &distances) const;
+
+  std::vector<Node> nodes_;
+  std::vector<Bucket> buckets_;
+  std::unordered_map<int, Location> locations_;
+
+  /**
+   * @brief Insertions and removals since the tree was last balanced
+   */
+  size_t changes_ = 0;
+};
+
+} // namespace food
+
+// template implementation
+
+template <typename Foods>
+auto food::ProfileTree::from(Foods const &foods) -> ProfileTree
+{
+  std::vector<int> food_ids;
+  std::vector<Profile> profiles;
+  food_ids.reserve(foods.size());
+  profiles.reserve(foods.size());
+
+  for (auto const &food : foods) {
+    food_ids.push_back(food.id());
+    profiles.push_back(food::profile(food.macronutrients()));
+  }
+
+  ProfileTree tree;
+  tree.build(food_ids, profiles);
+  return tree;
+}
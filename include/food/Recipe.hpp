@@ -0,0 +1,238 @@
+/**
+ * @file Recipe.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A food made of other foods, with macronutrients derived from its
+ *        ingredients
+ */
+
+#pragma once
+
+#include "database/Memory.hpp"
+#include "database/Storable.hpp"
+#include "database/utils.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <soci.h>
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The grams of a food that go into a recipe
+ */
+struct Ingredient {
+  int food_id = 0;
+  float grams = 0;
+};
+
+// Stored as the bytes of a vector, there must be no padding to write out
+static_assert(sizeof(Ingredient) == sizeof(int) + sizeof(float));
+
+/**
+ * @brief A food made of other foods, e.g. a dish cooked from ingredients
+ *
+ * Every recipe is backed by a Food of its own, so it is searched, logged in
+ * the diary and used as an ingredient of other recipes like any food. The
+ * macronutrients of that food are derived from the ingredients, per 100g of
+ * the recipe, whenever the ingredients are set. A RecipeGraph keeps them up
+ * to date as the ingredients themselves change.
+ *
+ * The ingredients are stored in a single BLOB column.
+ *
+ * Usage:
+ * @n auto &chili = food::make_recipe(
+ * @n     "chili", {{beans.id(), 400}, {beef.id(), 500}, {salsa.id(), 150}});
+ * @n auto &entry = utils::make<food::Entry>(chili.food_id(), 350.0, now,
+ * @n                                        food::Meal::DINNER);
+ */
+class Recipe final : public database::Storable {
+public:
+  Recipe(Recipe &&r) = default;
+
+  Recipe &operator=(Recipe const &r) = default;
+  Recipe &operator=(Recipe &&r) = default;
+
+  /**
+   * @brief All data will be retrieved from a storable object using this
+   *        function.
+   *
+   * @return A struct containing the name of the table to store this data
+   *         and a vector of column info. See Data.hpp for more info.
+   */
+  auto get_data() const -> database::Data const override;
+
+  /**
+   *  @return The unique ID of this recipe in the database
+   */
+  auto id() const -> int override
+  {
+    return this->id_;
+  }
+
+  /**
+   * @return The name of the food backing the recipe, empty if it no longer
+   *         exists
+   */
+  auto name() const -> std::string_view override;
+
+  /**
+   * @brief Renames the food backing the recipe
+   */
+  void set_name(std::string_view name) override;
+
+  /**
+   * @return string representation of the name and data, the same way sqlite
+   *         displays table data
+   */
+  auto str() const -> std::string override;
+
+  /**
+   * @return The id of the food backing the recipe
+   */
+  auto food_id() const -> int;
+
+  /**
+   * @return The foods the recipe is made of
+   */
+  auto ingredients() const -> std::vector<Ingredient> const &;
+
+  /**
+   * @brief Replaces the ingredients and derives the macronutrients of the
+   *        recipe's food from them, in one batch
+   *
+   * Will throw a runtime error if an ingredient is not a food, or is made
+   * from this recipe
+   */
+  void set_ingredients(std::vector<Ingredient> ingredients);
+
+  /**
+   * @return The grams of every ingredient added up
+   */
+  auto grams() const -> double;
+
+  ~Recipe() override = default;
+
+  /**
+   * @brief Custom allocator that allows database utils to own a vector
+   *        of storable objects with private constructors. Allocates from
+   *        the pool shared by every cache, see database::cache_resource.
+   */
+  struct Allocator : std::pmr::polymorphic_allocator<Recipe> {
+    Allocator()
+        : std::pmr::polymorphic_allocator<Recipe>(database::cache_resource())
+    {}
+
+    /**
+     * @brief Allocates from resource instead, e.g. for an object that is
+     *        released on its own rather than with its cache
+     */
+    explicit Allocator(std::pmr::memory_resource *resource)
+        : std::pmr::polymorphic_allocator<Recipe>(resource)
+    {}
+
+    /**
+     * @brief Copies of a cache allocate from the pool as well
+     */
+    auto select_on_container_copy_construction() const -> Allocator
+    {
+      return {};
+    }
+
+    template <class Recipe, typename... Args>
+    void construct(Recipe *buffer, Args &&... args)
+    {
+      /**
+       * @brief In place new construction of storable by memory pool that is
+       *        given
+       */
+      new (buffer) Recipe(std::forward<Args>(args)...);
+    }
+
+    template <class Recipe> struct rebind {
+      using other = Allocator;
+    };
+  };
+
+  friend struct Allocator;
+
+private:
+  Recipe() = default;
+  Recipe(Recipe const &r) = default;
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   */
+  explicit Recipe(int id);
+
+  /**
+   * @param id a uniquely generated ID given by database utils
+   * @param food_id The id of the food backing the recipe
+   * @param ingredients The foods the recipe is made of
+   */
+  Recipe(int id, int food_id, std::vector<Ingredient> ingredients);
+
+  /**
+   * @param A schema for this Storable object
+   * @param The row of data to construct the object
+   */
+  Recipe(std::vector<database::ColumnProperties> const &schema,
+         database::Row const &data);
+
+  /**
+   * @brief When creating new recipe objects from data retrieved from the
+   *        database, this function will be used to set the data for the
+   *        Storable object.
+   *
+   * @param schema A vector containing the properties of each column that make
+   *               up a schema
+   *
+   * @param data A row of data to set the object data
+   */
+  void set_data(std::vector<database::ColumnProperties> const &schema,
+                database::Row const &data) override;
+
+  /**
+   *  @brief The unique ID of this recipe in the database
+   */
+  int id_ = 0;
+
+  /**
+   *  @brief The id of the food backing the recipe
+   */
+  int food_id_ = 0;
+
+  /**
+   *  @brief The foods the recipe is made of
+   */
+  std::vector<Ingredient> ingredients_;
+};
+
+/**
+ * @brief Makes a recipe along with the food backing it
+ * @param name The name of the recipe's food
+ * @param ingredients The foods the recipe is made of
+ * @return A reference to the new recipe in the cache
+ *
+ * Will throw a runtime error if an ingredient is not a food
+ */
+auto make_recipe(std::string_view name, std::vector<Ingredient> ingredients)
+    -> Recipe &;
+
+/**
+ * @return The macronutrients per 100g of a food made of the ingredients, as
+ *         they are now. Ingredients that are not foods count as nothing.
+ * @param missing_food_id A food that also counts as nothing, e.g. one being
+ *                        deleted, 0 for none
+ */
+auto recipe_macronutrients(std::vector<Ingredient> const &ingredients,
+                           int missing_food_id = 0) -> Macronutrients;
+
+} // namespace food
@@ -0,0 +1,128 @@
+/**
+ * @file RecipeGraph.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps the macronutrients of recipes up to date as their ingredients
+ *        change
+ */
+
+#pragma once
+
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/Recipe.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Keeps the macronutrients of recipes up to date as their ingredients
+ *        change
+ *
+ * Holds the reverse of the ingredient lists: for every food, the recipes
+ * that use it. When a food changes, only the recipes reachable from it are
+ * recomputed, each one after the recipes it is made of, and their foods are
+ * written back in one database::utils::batch. Recipes unrelated to the food
+ * are never looked at.
+ *
+ * Built once from every Recipe, then updated through database::utils
+ * subscribe like IntakeRollup. Not thread safe.
+ *
+ * Usage:
+ * @n food::RecipeGraph recipes;
+ * @n beans.set_macronutrients(corrected);  // chili and its dependents follow
+ */
+class RecipeGraph {
+public:
+  RecipeGraph();
+
+  RecipeGraph(RecipeGraph const &) = delete;
+  RecipeGraph &operator=(RecipeGraph const &) = delete;
+
+  /**
+   * @return The ids of the recipes that use the food with food_id as an
+   *         ingredient directly
+   */
+  auto dependents(int food_id) const -> std::vector<int>;
+
+  /**
+   * @brief Recomputes every recipe made from the food with food_id, directly
+   *        or through other recipes, and writes them back in one batch
+   * @return The number of recipes recomputed
+   */
+  auto recompute(int food_id) -> size_t;
+
+  /**
+   * @return The number of recipes recomputed since the graph was built
+   */
+  auto recomputations() const -> size_t;
+
+  /**
+   * @brief Reads every recipe again, use after recipes were changed without
+   *        database::utils
+   */
+  void rebuild();
+
+private:
+  /**
+   * @brief What the graph keeps of a recipe
+   */
+  struct Node {
+    int food_id;
+
+    /**
+     * @brief The foods of the ingredients, each one once
+     */
+    std::vector<int> ingredients;
+  };
+
+  void on_recipe(Recipe const &recipe, database::utils::Change change);
+
+  void on_food(Food const &food, database::utils::Change change);
+
+  /**
+   * @brief Recomputes the recipes made from the food with food_id
+   * @param missing_food_id A food the recipes are computed without, 0 for
+   *                        none
+   */
+  auto propagate(int food_id, int missing_food_id) -> size_t;
+
+  /**
+   * @brief Removes the edges of a recipe, if any
+   */
+  void remove(int recipe_id);
+
+  /**
+   * @return The ids of the recipes made from the food with food_id, each one
+   *         after every recipe it is made of
+   */
+  auto affected(int food_id) const -> std::vector<int>;
+
+  /**
+   * @brief Every recipe by recipe id
+   */
+  std::unordered_map<int, Node> nodes_;
+
+  /**
+   * @brief The ids of the recipes that use each food directly
+   */
+  std::unordered_map<int, std::vector<int>> dependents_;
+
+  /**
+   * @brief Set while recomputed recipes are written back, the changes they
+   *        cause are already accounted for
+   */
+  bool writing_ = false;
+
+  size_t recomputations_ = 0;
+
+  database::utils::Subscription<Recipe> recipe_listener_;
+  database::utils::Subscription<Food> food_listener_;
+};
+
+} // namespace food
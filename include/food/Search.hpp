@@ -0,0 +1,75 @@
+/**
+ * @file Search.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Type-ahead search over food names that refines the previous result
+ *        when the query grows
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief The foods matching a query
+ */
+struct SearchResult {
+  /**
+   * @brief The query, case folded
+   */
+  std::string query;
+
+  /**
+   * @brief Indexes of the matching names in ascending order
+   */
+  std::vector<size_t> matches;
+};
+
+/**
+ * @return text with every ASCII letter in lower case
+ */
+auto fold_case(std::string_view text) -> std::string;
+
+/**
+ * @brief Finds every name that contains every word of query
+ *
+ * @param names The names to search, case folded with fold_case
+ * @param query Whitespace separated words, matched case insensitively
+ * @param previous The result of an earlier query over the same names, or
+ *                 nullptr. If query extends it (e.g. "chick" after "chi"),
+ *                 only its matches are searched.
+ * @param is_cancelled Polled while searching, the search is abandoned once
+ *                     it returns true
+ * @return The matches, or std::nullopt if the search was cancelled
+ *
+ * Usage:
+ * @n auto const result = food::search(names, "chick", &last, [&] {
+ * @n   return generation != current_generation;
+ * @n });
+ */
+auto search(std::vector<std::string> const &names, std::string_view query,
+            SearchResult const *previous,
+            std::function<bool()> const &is_cancelled)
+    -> std::optional<SearchResult>;
+
+/**
+ * @brief Orders matches for display, names that start with the first word of
+ *        the query come first. Ties keep their order.
+ *
+ * @param names The names that were searched, case folded with fold_case
+ * @param result A result of search over names
+ * @return The indexes of the matching names in display order
+ */
+auto rank(std::vector<std::string> const &names, SearchResult const &result)
+    -> std::vector<size_t>;
+
+} // namespace food
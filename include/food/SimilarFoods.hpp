@@ -0,0 +1,73 @@
+/**
+ * @file SimilarFoods.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Finds the foods most alike a food, kept up to date with the food
+ *        table
+ */
+
+#pragma once
+
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/ProfileTree.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Organizes all food related classes and utilities
+ */
+namespace food {
+
+/**
+ * @brief Finds the foods whose macronutrient profiles are closest to a
+ *        food's, e.g. to suggest what to eat instead
+ *
+ * Built once from every Food into a ProfileTree, then updated as foods are
+ * made, updated or deleted through database::utils::subscribe. A search is
+ * a k-d tree query, it does not look at the Food cache.
+ *
+ * Not thread safe, changes must be made on the thread that searches.
+ *
+ * Usage:
+ * @n food::SimilarFoods similar;
+ * @n for (auto const &[food_id, distance] : similar.similar(taco.id(), 10)) {
+ * @n   ...
+ * @n }
+ */
+class SimilarFoods {
+public:
+  SimilarFoods();
+
+  SimilarFoods(SimilarFoods const &) = delete;
+  SimilarFoods &operator=(SimilarFoods const &) = delete;
+
+  /**
+   * @return The k foods most alike the food with food_id, closest first and
+   *         without the food itself. Empty if there is no such food.
+   */
+  auto similar(int food_id, size_t k) const -> std::vector<Neighbour>;
+
+  /**
+   * @return The k foods most alike a food with macros, closest first
+   */
+  auto similar(Macronutrients const &macros, size_t k) const
+      -> std::vector<Neighbour>;
+
+  /**
+   * @brief Reads every food again, use after foods were changed without
+   *        database::utils
+   */
+  void rebuild();
+
+private:
+  void on_food(Food const &food, database::utils::Change change);
+
+  ProfileTree tree_;
+
+  database::utils::Subscription<Food> food_listener_;
+};
+
+} // namespace food
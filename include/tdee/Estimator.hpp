@@ -0,0 +1,171 @@
+/**
+ * @file Estimator.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Estimates total daily energy expenditure (TDEE) from daily intake and
+ *        weight, one day at a time
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Estimation of total daily energy expenditure (TDEE)
+ */
+namespace tdee {
+
+/**
+ * @brief Tuning of the estimator, the defaults suit daily weigh-ins
+ */
+struct Settings {
+  /**
+   * @brief Weight of each new weigh-in in the trend weight, between 0 and 1.
+   *        Lower values smooth out more water weight but react slower.
+   */
+  double smoothing = 0.1;
+
+  /**
+   * @brief The TDEE assumed before any data, in kcal
+   */
+  double initial_tdee = 2000;
+
+  /**
+   * @brief How unsure the initial TDEE is, as a variance in kcal^2
+   */
+  double initial_variance = 500 * 500;
+
+  /**
+   * @brief How much the real TDEE may drift each day, as a variance in kcal^2
+   */
+  double process_variance = 10 * 10;
+
+  /**
+   * @brief How noisy the TDEE implied by a single day is, as a variance in
+   *        kcal^2. Dominated by logging errors and water weight.
+   */
+  double measurement_variance = 600 * 600;
+
+  /**
+   * @brief Energy stored in a kilogram of body weight, in kcal
+   */
+  double kcal_per_kg = 7700;
+};
+
+/**
+ * @brief What is known about a single day. Either may be missing.
+ */
+struct Day {
+  /**
+   * @brief Energy eaten in kcal, missing if the day was not logged
+   */
+  std::optional<double> intake;
+
+  /**
+   * @brief Weight in kg, missing if there was no weigh-in
+   */
+  std::optional<double> weight;
+};
+
+/**
+ * @brief The state of the estimator after a day
+ */
+struct Estimate {
+  /**
+   * @brief Exponentially smoothed weight in kg, 0 before the first weigh-in
+   */
+  double trend_weight;
+
+  /**
+   * @brief Estimated TDEE in kcal
+   */
+  double tdee;
+
+  /**
+   * @brief Variance of the TDEE in kcal^2
+   */
+  double variance;
+};
+
+/**
+ * @brief Estimates TDEE with a scalar Kalman filter
+ *
+ * Weigh-ins are smoothed into a trend weight with an exponential moving
+ * average. Between two weigh-ins the energy balance gives the TDEE implied by
+ * the data:
+ *
+ * @n implied = (intake - kcal_per_kg * change in trend weight) / days
+ *
+ * which the filter blends with its running estimate, modelled as a random
+ * walk. Every day is O(1), nothing is refitted. Days that were not logged
+ * break the energy balance, the interval they are in is skipped.
+ *
+ * Usage:
+ * @n tdee::Estimator estimator;
+ * @n estimator.update({2400.0, 80.2});
+ * @n estimator.update({2100.0, std::nullopt});
+ * @n double const maintenance = estimator.estimate().tdee;
+ */
+class Estimator {
+public:
+  explicit Estimator(Settings settings = Settings());
+
+  /**
+   * @brief Adds the next day, O(1)
+   */
+  void update(Day const &day);
+
+  /**
+   * @brief Adds days in order, as update would
+   * @return The estimate after each day
+   *
+   * Usage:
+   * @n auto const history = tdee::Estimator().backfill(days);
+   */
+  auto backfill(std::vector<Day> const &days) -> std::vector<Estimate>;
+
+  /**
+   * @return The estimate after the last day added
+   */
+  auto estimate() const -> Estimate;
+
+  /**
+   * @return The number of days added
+   */
+  auto days() const -> size_t;
+
+  /**
+   * @return The settings the estimator was created with
+   */
+  auto settings() const -> Settings const &;
+
+private:
+  Settings settings_;
+
+  size_t days_ = 0;
+
+  double trend_weight_ = 0;
+  bool has_weight_ = false;
+
+  double tdee_;
+  double variance_;
+
+  /**
+   * @brief Trend weight at the start of the current interval
+   */
+  double interval_weight_ = 0;
+
+  /**
+   * @brief Intake and days logged since interval_weight_
+   */
+  double interval_intake_ = 0;
+  size_t interval_days_ = 0;
+
+  /**
+   * @brief A day of the current interval was not logged
+   */
+  bool interval_broken_ = true;
+};
+
+} // namespace tdee
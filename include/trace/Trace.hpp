@@ -0,0 +1,171 @@
+/**
+ * @file Trace.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Lightweight span recorder that writes Chrome Trace Event json
+ *
+ * Every thread records begin/end spans into its own ring buffer, so recording
+ * never contends with other threads. Recording is off by default and costs a
+ * single atomic load per scope while off. Set the TRACKER_TRACE environment
+ * variable to a file path to record from startup, then open the flushed file
+ * in chrome://tracing or https://ui.perfetto.dev
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records spans of execution and writes them out as a timeline
+ */
+namespace trace {
+
+/**
+ * @brief A span of execution on a single thread
+ */
+struct Span {
+  /**
+   * @brief The module the span belongs to (e.g. "database", "food", "gui")
+   *        Must be a string literal.
+   */
+  char const *category;
+
+  /**
+   * @brief What was executing (e.g. "utils::update"). Must be a string
+   *        literal.
+   */
+  char const *name;
+
+  /**
+   * @brief Nanoseconds since the recorder started
+   */
+  std::int64_t begin;
+
+  /**
+   * @brief Nanoseconds since the recorder started
+   */
+  std::int64_t end;
+};
+
+/**
+ * @return true if spans are currently being recorded
+ */
+auto is_enabled() -> bool;
+
+/**
+ * @brief Turns recording on or off at runtime
+ * @param enabled Record spans from now on if true
+ */
+void set_enabled(bool enabled);
+
+/**
+ * @return Nanoseconds since the recorder started
+ */
+auto now() -> std::int64_t;
+
+/**
+ * @brief Stores a finished span in the ring buffer of the calling thread. The
+ *        oldest span is overwritten once the buffer is full.
+ */
+void record(Span const &span);
+
+/**
+ * @brief Records a span from the start of the recorder to now, for one off
+ *        points in time such as the first frame of the app
+ *
+ * @param category The module the milestone belongs to, must be a string
+ *                 literal
+ * @param name What was reached, must be a string literal
+ * @return Milliseconds since the recorder started, measured even while
+ *         recording is off so the milestone can always be logged
+ *
+ * The recorder starts with the first call to now(), call it first thing in
+ * main to measure milestones from startup.
+ *
+ * Usage:
+ * @n trace::now();
+ * @n // start up
+ * @n std::clog << trace::milestone("gui", "first_frame") << " ms\n";
+ */
+auto milestone(char const *category, char const *name) -> double;
+
+/**
+ * @brief Writes every recorded span of every thread as Chrome Trace Event json
+ *        and empties the buffers.
+ *
+ * @param path The file to write, overwritten if it exists
+ *
+ * Will throw a runtime error if the file can not be written
+ */
+void flush(std::string const &path);
+
+/**
+ * @brief Writes the recorded spans to the path in the TRACKER_TRACE
+ *        environment variable, or tracker_trace.json if it is not set.
+ *
+ * Usage:
+ * @n trace::set_enabled(true);
+ * @n // do work
+ * @n trace::flush();
+ */
+void flush();
+
+/**
+ * @brief Records a span from construction to destruction
+ *
+ * Prefer the TRACKER_TRACE_SCOPE macro, it can be compiled out.
+ */
+class Scope {
+public:
+  /**
+   * @param category The module the span belongs to, must be a string literal
+   * @param name What is executing, must be a string literal
+   */
+  Scope(char const *category, char const *name)
+      : category_{category}, name_{name}, begin_{is_enabled() ? now() : -1}
+  {}
+
+  ~Scope()
+  {
+    if (begin_ >= 0) { record({category_, name_, begin_, now()}); }
+  }
+
+  //! Deleted functions
+  Scope(Scope const &) = delete;
+  Scope(Scope &&) = delete;
+  Scope &operator=(Scope const &) = delete;
+  Scope &operator=(Scope &&) = delete;
+
+private:
+  char const *category_;
+  char const *name_;
+
+  /**
+   * @brief -1 when recording was off as the scope began
+   */
+  std::int64_t begin_;
+};
+
+} // namespace trace
+
+#define TRACKER_TRACE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define TRACKER_TRACE_CONCAT(lhs, rhs) TRACKER_TRACE_CONCAT_IMPL(lhs, rhs)
+
+/**
+ * @brief Records a span named name in category until the end of the enclosing
+ *        scope. Compiled out when TRACKER_DISABLE_TRACING is defined.
+ *
+ * Usage:
+ * @n void database::utils::update(...)
+ * @n {
+ * @n   TRACKER_TRACE_SCOPE("database", "utils::update");
+ * @n   ...
+ * @n }
+ */
+#ifdef TRACKER_DISABLE_TRACING
+#define TRACKER_TRACE_SCOPE(category, name) static_cast<void>(0)
+#else
+#define TRACKER_TRACE_SCOPE(category, name)                                    \
+  ::trace::Scope TRACKER_TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file Date.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Conversions between calendar dates and days since the epoch
+ *
+ * Source: http://howardhinnant.github.io/date_algorithms.html
+ */
+
+#include "body/Date.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+auto body::to_epoch_day(Date const &date) -> int
+{
+  // Years start in March so the leap day is the last day of the year
+  int const year = date.month <= 2 ? date.year - 1 : date.year;
+  int const era = (year >= 0 ? year : year - 399) / 400;
+  int const year_of_era = year - era * 400;
+  int const day_of_year =
+      (153 * (date.month + (date.month > 2 ? -3 : 9)) + 2) / 5 + date.day - 1;
+  int const day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+  // 719468 days from 0000-03-01 to 1970-01-01
+  return era * 146097 + day_of_era - 719468;
+}
+
+auto body::to_date(int epoch_day) -> Date
+{
+  int const days = epoch_day + 719468;
+  int const era = (days >= 0 ? days : days - 146096) / 146097;
+  int const day_of_era = days - era * 146097;
+  int const year_of_era = (day_of_era - day_of_era / 1460 +
+                           day_of_era / 36524 - day_of_era / 146096) /
+                          365;
+  int const day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  int const shifted_month = (5 * day_of_year + 2) / 153;
+
+  Date date;
+  date.day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+  date.month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  date.year = year_of_era + era * 400 + (date.month <= 2 ? 1 : 0);
+  return date;
+}
+
+auto body::to_string(Date const &date) -> std::string
+{
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", date.year,
+                date.month, date.day);
+  return buffer;
+}
+
+auto body::parse_date(std::string_view text) -> std::optional<Date>
+{
+  std::stringstream ss{std::string(text)};
+
+  Date date;
+  char first_dash = 0;
+  char second_dash = 0;
+  ss >> date.year >> first_dash >> date.month >> second_dash >> date.day;
+
+  if (ss.fail() || first_dash != '-' || second_dash != '-' ||
+      date.month < 1 || date.month > 12 || date.day < 1 || date.day > 31) {
+    return std::nullopt;
+  }
+
+  return date;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file WeightEntry.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A single weigh-in
+ */
+
+#include "body/WeightEntry.hpp"
+#include "body/Date.hpp"
+#include "database/Data.hpp"
+#include "database/Memory.hpp"
+#include "database/utils.hpp"
+#include "trace/Trace.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <memory_resource>
+#include <sstream>
+#include <unordered_map>
+
+body::WeightEntry::WeightEntry(int id) : id_{id}
+{
+  this->name_day();
+}
+
+body::WeightEntry::WeightEntry(int id, int day, float kg)
+    : id_{id}, day_{day}, previous_day_{day}, kg_{kg}
+{
+  this->name_day();
+}
+
+body::WeightEntry::WeightEntry(
+    std::vector<database::ColumnProperties> const &schema,
+    database::Row const &data)
+{
+  this->set_data(schema, data);
+}
+
+auto body::WeightEntry::name() const -> std::string_view
+{
+  return this->name_;
+}
+
+void body::WeightEntry::set_name(std::string_view name)
+{
+  auto const date = parse_date(name);
+  if (!date) {
+    std::cerr << "Not a YYYY-MM-DD date: " << name << std::endl;
+    throw std::runtime_error("Weigh-in name must be its date");
+  }
+
+  this->set_day(to_epoch_day(*date));
+}
+
+auto body::WeightEntry::day() const -> int
+{
+  return this->day_;
+}
+
+void body::WeightEntry::set_day(int day)
+{
+  TRACKER_TRACE_SCOPE("body", "WeightEntry::set_day");
+
+  this->previous_day_ = this->day_;
+  this->day_ = day;
+  this->name_day();
+  database::utils::update(*this);
+}
+
+auto body::WeightEntry::previous_day() const -> int
+{
+  return this->previous_day_;
+}
+
+auto body::WeightEntry::kg() const -> float
+{
+  return this->kg_;
+}
+
+void body::WeightEntry::set_kg(float kg)
+{
+  TRACKER_TRACE_SCOPE("body", "WeightEntry::set_kg");
+
+  this->previous_day_ = this->day_;
+  this->kg_ = kg;
+  database::utils::update(*this);
+}
+
+auto body::WeightEntry::get_data() const -> database::Data const
+{
+  TRACKER_TRACE_SCOPE("body", "WeightEntry::get_data");
+
+  database::Data data;
+  data.table_name = "WeightEntry";
+
+  // WeightEntry ID|day|kg
+  size_t num_columns = 3;
+  data.schema.reserve(num_columns);
+
+  // The properties of a single column;
+  database::ColumnProperties column_properties;
+
+  // WeightEntry_id column begin
+  column_properties.name = data.table_name + "_id";
+  column_properties.data_type = database::DataType::INTEGER;
+  column_properties.constraint = database::Constraint::PRIMARY_KEY;
+  data.schema.emplace_back(column_properties);
+
+  database::Row new_row;
+  new_row.row_data.reserve(num_columns);
+
+  // std::variant to hold multiple data types. Defined in Data.hpp.
+  database::Row::row_data_t row_data = this->id();
+  new_row.row_data.emplace_back(row_data);
+
+  // The rest of the columns from hereon will be NOT NULL constraint
+  column_properties.constraint = database::Constraint::NOT_NULL;
+
+  column_properties.name = "day";
+  column_properties.data_type = database::DataType::INTEGER;
+  data.schema.emplace_back(column_properties);
+  row_data = this->day();
+  new_row.row_data.emplace_back(row_data);
+
+  column_properties.name = "kg";
+  column_properties.data_type = database::DataType::REAL;
+  data.schema.emplace_back(column_properties);
+  row_data = static_cast<double>(this->kg());
+  new_row.row_data.emplace_back(row_data);
+
+  data.rows.emplace_back(std::move(new_row));
+
+  // Covers every column, the rollups are computed from the index alone
+  data.indexes.push_back({"WeightEntry_day", {"day", "kg"}});
+
+  return data;
+}
+
+void body::WeightEntry::set_data(
+    std::vector<database::ColumnProperties> const &schema,
+    database::Row const &row)
+{
+  TRACKER_TRACE_SCOPE("body", "WeightEntry::set_data");
+
+  // Three columns, the arena is never outgrown
+  database::StackArena<1024> arena;
+  std::pmr::unordered_map<std::string_view, database::Row::row_data_t const *>
+      organized_data(&arena);
+
+  for (auto const &[first, second] : ranges::view::zip(schema, row.row_data)) {
+    organized_data[first.name] = &second;
+  }
+
+  this->id_ = std::get<int>(*organized_data.at("WeightEntry_id"));
+  this->day_ = std::get<int>(*organized_data.at("day"));
+  this->previous_day_ = this->day_;
+  this->kg_ = static_cast<float>(std::get<double>(*organized_data.at("kg")));
+  this->name_day();
+}
+
+void body::WeightEntry::name_day()
+{
+  this->name_ = to_string(to_date(this->day_));
+}
+
+auto body::WeightEntry::str() const -> std::string
+{
+  std::stringstream ss;
+  ss << this->id();
+
+  auto const delimeter = "|";
+  ss << delimeter << this->day();
+  ss << delimeter << this->kg();
+
+  return ss.str();
+}
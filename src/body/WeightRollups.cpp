@@ -0,0 +1,215 @@
+/**
+ * @file WeightRollups.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Week and month summaries of the weigh-ins, kept up to date as they
+ *        change
+ */
+
+#include "body/WeightRollups.hpp"
+#include "body/Date.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief SQL computing the same number as WeightRollups::bucket_of from the
+ *        day column
+ */
+auto bucket_expression(body::Resolution resolution) -> std::string
+{
+  if (resolution == body::Resolution::WEEK) {
+    // 1970-01-01 was a Thursday, shift so weeks start on Monday
+    return "(day + 3) / 7";
+  }
+
+  return "(CAST(strftime('%Y', day * 86400, 'unixepoch') AS INTEGER) * 12 + "
+         "CAST(strftime('%m', day * 86400, 'unixepoch') AS INTEGER) - 1)";
+}
+
+} // namespace
+
+body::WeightRollups::WeightRollups()
+{
+  listener_ = database::utils::Subscription<WeightEntry>(
+      [this](WeightEntry const &weight, database::utils::Change change) {
+        this->on_weight(weight, change);
+      });
+
+  this->rebuild();
+}
+
+auto body::WeightRollups::summaries(Resolution resolution, int first_day,
+                                    int last_day) -> std::vector<WeightSummary>
+{
+  TRACKER_TRACE_SCOPE("body", "WeightRollups::summaries");
+
+  auto &buckets = this->buckets(resolution);
+
+  auto first = buckets.lower_bound(bucket_of(resolution, first_day));
+  auto last = buckets.upper_bound(bucket_of(resolution, last_day));
+
+  std::vector<WeightSummary> summaries;
+  for (auto it = first; it != last;) {
+    auto &[bucket, aggregate] = *it;
+
+    if (aggregate.stale) { this->refresh(resolution, bucket, aggregate); }
+
+    // Every weigh-in in it was deleted
+    if (aggregate.count == 0) {
+      it = buckets.erase(it);
+      continue;
+    }
+
+    WeightSummary summary;
+    summary.first_day = first_day_of(resolution, bucket);
+    summary.last_day = first_day_of(resolution, bucket + 1) - 1;
+    summary.min = aggregate.min;
+    summary.max = aggregate.max;
+    summary.mean = static_cast<float>(aggregate.sum / aggregate.count);
+    summary.count = aggregate.count;
+    summaries.push_back(summary);
+
+    ++it;
+  }
+
+  return summaries;
+}
+
+void body::WeightRollups::rebuild()
+{
+  TRACKER_TRACE_SCOPE("body", "WeightRollups::rebuild");
+
+  weeks_.clear();
+  months_.clear();
+
+  if (!database::utils::table_exists<WeightEntry>()) { return; }
+
+  this->load(Resolution::WEEK);
+  this->load(Resolution::MONTH);
+}
+
+auto body::WeightRollups::bucket_of(Resolution resolution, int day) -> int
+{
+  if (resolution == Resolution::WEEK) { return (day + 3) / 7; }
+
+  Date const date = to_date(day);
+  return date.year * 12 + date.month - 1;
+}
+
+auto body::WeightRollups::first_day_of(Resolution resolution, int bucket)
+    -> int
+{
+  if (resolution == Resolution::WEEK) { return bucket * 7 - 3; }
+
+  return to_epoch_day({bucket / 12, bucket % 12 + 1, 1});
+}
+
+auto body::WeightRollups::buckets(Resolution resolution) -> Buckets &
+{
+  return resolution == Resolution::WEEK ? weeks_ : months_;
+}
+
+void body::WeightRollups::load(Resolution resolution)
+{
+  auto const bucket = bucket_expression(resolution);
+
+  size_t num_buckets = 0;
+  database::utils::execute("SELECT count(DISTINCT " + bucket +
+                               ") FROM WeightEntry",
+                           {}, "Attempt to count weigh-in summaries failed.",
+                           soci::into(num_buckets));
+
+  if (num_buckets == 0) { return; }
+
+  std::stringstream sql_command;
+  sql_command << "SELECT " << bucket << " AS bucket, min(kg), max(kg), "
+              << "sum(kg), count(*)\n";
+  sql_command << "FROM WeightEntry\n";
+  sql_command << "GROUP BY bucket";
+
+  std::vector<int> numbers(num_buckets);
+  std::vector<double> mins(num_buckets);
+  std::vector<double> maxs(num_buckets);
+  std::vector<double> sums(num_buckets);
+  std::vector<int> counts(num_buckets);
+
+  database::utils::execute(sql_command.str(), {},
+                           "Attempt to summarize weigh-ins failed.",
+                           soci::into(numbers), soci::into(mins),
+                           soci::into(maxs), soci::into(sums),
+                           soci::into(counts));
+
+  auto &buckets = this->buckets(resolution);
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    auto &aggregate = buckets[numbers[i]];
+    aggregate.min = static_cast<float>(mins[i]);
+    aggregate.max = static_cast<float>(maxs[i]);
+    aggregate.sum = sums[i];
+    aggregate.count = counts[i];
+  }
+}
+
+void body::WeightRollups::refresh(Resolution resolution, int bucket,
+                                  Aggregate &aggregate)
+{
+  TRACKER_TRACE_SCOPE("body", "WeightRollups::refresh");
+
+  std::string const sql_command =
+      "SELECT count(*), ifnull(min(kg), 0), ifnull(max(kg), 0), "
+      "ifnull(sum(kg), 0)\n"
+      "FROM WeightEntry\n"
+      "WHERE day >= :first AND day < :end";
+
+  int count = 0;
+  double min = 0;
+  double max = 0;
+  double sum = 0;
+
+  database::utils::execute(
+      sql_command,
+      {first_day_of(resolution, bucket), first_day_of(resolution, bucket + 1)},
+      "Attempt to summarize weigh-ins failed.", soci::into(count),
+      soci::into(min), soci::into(max), soci::into(sum));
+
+  aggregate.min = static_cast<float>(min);
+  aggregate.max = static_cast<float>(max);
+  aggregate.sum = sum;
+  aggregate.count = count;
+  aggregate.stale = false;
+}
+
+void body::WeightRollups::on_weight(WeightEntry const &weight,
+                                    database::utils::Change change)
+{
+  using database::utils::Change;
+
+  if (change != Change::INSERTED) {
+    // The old weight is gone, only the database can tell the new min or max
+    this->invalidate(weight.day());
+    if (change == Change::UPDATED) { this->invalidate(weight.previous_day()); }
+    return;
+  }
+
+  for (auto const resolution : {Resolution::WEEK, Resolution::MONTH}) {
+    auto &aggregate =
+        this->buckets(resolution)[bucket_of(resolution, weight.day())];
+    if (aggregate.stale) { continue; }
+
+    float const kg = weight.kg();
+    aggregate.min = aggregate.count == 0 ? kg : std::min(aggregate.min, kg);
+    aggregate.max = aggregate.count == 0 ? kg : std::max(aggregate.max, kg);
+    aggregate.sum += kg;
+    ++aggregate.count;
+  }
+}
+
+void body::WeightRollups::invalidate(int day)
+{
+  for (auto const resolution : {Resolution::WEEK, Resolution::MONTH}) {
+    this->buckets(resolution)[bucket_of(resolution, day)].stale = true;
+  }
+}
@@ -0,0 +1,272 @@
+/**
+ * @file Downsample.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Reduces time series to about one point per pixel while keeping their
+ *        visual shape
+ */
+
+#include "chart/Downsample.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Twice the area of the triangle abc
+ */
+auto triangle_area(chart::Point const &a, chart::Point const &b,
+                   chart::Point const &c) -> double
+{
+  return std::abs((a.x - c.x) * (b.y - a.y) - (a.x - b.x) * (c.y - a.y));
+}
+
+/**
+ * @brief Caches are dropped past this many buckets, deep zooms mostly cache
+ *        empty buckets
+ */
+constexpr size_t max_cached_buckets = 1 << 16;
+
+} // namespace
+
+auto chart::lttb(Point const *points, size_t size, size_t threshold)
+    -> std::vector<Point>
+{
+  if (threshold >= size || threshold < 3) {
+    return std::vector<Point>(points, points + size);
+  }
+
+  std::vector<Point> sampled;
+  sampled.reserve(threshold);
+  sampled.push_back(points[0]);
+
+  // The first and last point are kept, the rest is split evenly
+  double const bucket_size = static_cast<double>(size - 2) / (threshold - 2);
+  size_t kept = 0;
+
+  for (size_t bucket = 0; bucket < threshold - 2; ++bucket) {
+    size_t const first = static_cast<size_t>(bucket * bucket_size) + 1;
+    size_t const last = static_cast<size_t>((bucket + 1) * bucket_size) + 1;
+
+    // Average of the next bucket, the last point for the last bucket
+    size_t const next_first = last;
+    size_t const next_last = std::min(
+        static_cast<size_t>((bucket + 2) * bucket_size) + 1, size);
+
+    Point next{0, 0};
+    for (size_t i = next_first; i < next_last; ++i) {
+      next.x += points[i].x;
+      next.y += points[i].y;
+    }
+    next.x /= next_last - next_first;
+    next.y /= next_last - next_first;
+
+    double max_area = -1;
+    for (size_t i = first; i < last; ++i) {
+      double const area = triangle_area(points[kept], points[i], next);
+      if (area > max_area) {
+        max_area = area;
+        kept = i;
+      }
+    }
+
+    sampled.push_back(points[kept]);
+  }
+
+  sampled.push_back(points[size - 1]);
+  return sampled;
+}
+
+void chart::Downsampler::set_points(std::vector<Point> points)
+{
+  points_ = std::move(points);
+  levels_.clear();
+}
+
+void chart::Downsampler::insert(Point point)
+{
+  auto const compare = [](Point const &lhs, Point const &rhs) {
+    return lhs.x < rhs.x;
+  };
+  auto const inserted = points_.insert(
+      std::upper_bound(begin(points_), end(points_), point, compare), point);
+
+  this->invalidate(static_cast<size_t>(inserted - begin(points_)));
+}
+
+void chart::Downsampler::update(Point point)
+{
+  auto const compare = [](Point const &lhs, double rhs) { return lhs.x < rhs; };
+  auto const found =
+      std::lower_bound(begin(points_), end(points_), point.x, compare);
+
+  if (found == end(points_) || found->x != point.x) {
+    this->insert(point);
+    return;
+  }
+
+  this->invalidate(static_cast<size_t>(found - begin(points_)));
+  found->y = point.y;
+}
+
+void chart::Downsampler::erase(double x)
+{
+  auto const compare = [](Point const &lhs, double rhs) { return lhs.x < rhs; };
+  auto const first = std::lower_bound(begin(points_), end(points_), x, compare);
+
+  // Dropped one by one, each with the neighbours it has at the time
+  auto const position = static_cast<size_t>(first - begin(points_));
+  while (position < points_.size() && points_[position].x == x) {
+    this->invalidate(position);
+    points_.erase(begin(points_) + static_cast<std::ptrdiff_t>(position));
+  }
+}
+
+auto chart::Downsampler::points() const -> std::vector<Point> const &
+{
+  return points_;
+}
+
+auto chart::Downsampler::window(double x_min, double x_max, size_t pixels)
+    -> std::vector<Point>
+{
+  std::vector<Point> shown;
+  if (points_.empty() || pixels < 2 || !(x_min < x_max)) { return shown; }
+
+  auto const compare = [](Point const &point, double x) { return point.x < x; };
+  auto const first =
+      std::lower_bound(begin(points_), end(points_), x_min, compare);
+  auto const last = std::upper_bound(
+      first, end(points_), x_max,
+      [](double x, Point const &point) { return x < point.x; });
+
+  // Edges included, a bucket can't span more than a pixel
+  size_t const visible = last - first;
+  if (visible <= pixels) {
+    shown.assign(first == begin(points_) ? first : first - 1,
+                 last == end(points_) ? last : last + 1);
+    return shown;
+  }
+
+  // Smallest power of two width that fits every bucket in a pixel
+  int const exponent = static_cast<int>(
+      std::ceil(std::log2((x_max - x_min) / (pixels - 1))));
+  double const width = std::ldexp(1.0, exponent);
+
+  auto const first_index = static_cast<long long>(std::floor(x_min / width));
+  auto const last_index = static_cast<long long>(std::floor(x_max / width));
+
+  if (levels_[exponent].size() > max_cached_buckets) {
+    levels_[exponent].clear();
+  }
+
+  // The closest points outside the edges
+  if (first != begin(points_)) { shown.push_back(*(first - 1)); }
+
+  for (long long index = first_index; index <= last_index; ++index) {
+    if (auto const point = this->select(exponent, index)) {
+      // The edge buckets may choose a point outside the visible range
+      if (point->x >= x_min && point->x <= x_max) { shown.push_back(*point); }
+    }
+  }
+
+  if (last != end(points_)) { shown.push_back(*last); }
+
+  return shown;
+}
+
+void chart::Downsampler::invalidate(size_t position)
+{
+  for (auto &[exponent, level] : levels_) {
+    auto const index_of = [exponent = exponent](Point const &point) {
+      return static_cast<long long>(std::floor(std::ldexp(point.x, -exponent)));
+    };
+
+    // A bucket depends on its neighbours' averages
+    long long const index = index_of(points_[position]);
+    for (long long neighbour = index - 1; neighbour <= index + 1;
+         ++neighbour) {
+      level.erase(neighbour);
+    }
+
+    // and on the closest point past an empty neighbour, which is the
+    // nearest non-empty bucket on either side
+    if (position > 0) { level.erase(index_of(points_[position - 1])); }
+    if (position + 1 < points_.size()) {
+      level.erase(index_of(points_[position + 1]));
+    }
+  }
+}
+
+auto chart::Downsampler::bucket(double width, long long index) const -> Bucket
+{
+  auto const compare = [](Point const &point, double x) { return point.x < x; };
+
+  auto const first = std::lower_bound(begin(points_), end(points_),
+                                      index * width, compare);
+  auto const last =
+      std::lower_bound(first, end(points_), (index + 1) * width, compare);
+
+  return {static_cast<size_t>(first - begin(points_)),
+          static_cast<size_t>(last - begin(points_))};
+}
+
+auto chart::Downsampler::average(Bucket const &bucket) const -> Point
+{
+  Point average{0, 0};
+  for (size_t i = bucket.first; i < bucket.last; ++i) {
+    average.x += points_[i].x;
+    average.y += points_[i].y;
+  }
+
+  double const size = bucket.last - bucket.first;
+  return {average.x / size, average.y / size};
+}
+
+auto chart::Downsampler::select(int exponent, long long index)
+    -> std::optional<Point>
+{
+  auto &level = levels_[exponent];
+
+  auto found = level.find(index);
+  if (found != end(level)) { return found->second; }
+
+  double const width = std::ldexp(1.0, exponent);
+  Bucket const current = this->bucket(width, index);
+
+  if (current.first == current.last) {
+    level.emplace(index, std::nullopt);
+    return std::nullopt;
+  }
+
+  // Neighbouring bucket averages, or the closest point if it is empty
+  Bucket const previous = this->bucket(width, index - 1);
+  Point before = points_[current.first];
+  if (previous.first != previous.last) {
+    before = this->average(previous);
+  } else if (current.first > 0) {
+    before = points_[current.first - 1];
+  }
+
+  Bucket const next = this->bucket(width, index + 1);
+  Point after = points_[current.last - 1];
+  if (next.first != next.last) {
+    after = this->average(next);
+  } else if (current.last < points_.size()) {
+    after = points_[current.last];
+  }
+
+  size_t kept = current.first;
+  double max_area = -1;
+  for (size_t i = current.first; i < current.last; ++i) {
+    double const area = triangle_area(before, points_[i], after);
+    if (area > max_area) {
+      max_area = area;
+      kept = i;
+    }
+  }
+
+  level.emplace(index, points_[kept]);
+  return points_[kept];
+}
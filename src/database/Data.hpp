@@ -10,7 +10,13 @@
 
 #include <ctime>
 
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory_resource>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -24,8 +30,11 @@ namespace database {
  *
  * Types with the underscore _ suffix were special keywords that
  * could not be defined.
+ *
+ * INTEGER columns are read back as int, use BIGINT for 64 bit values.
+ * TIMESTAMP columns hold a Timestamp as an integer and are read back as one.
  */
-enum class DataType { REAL, INTEGER, TEXT, NULL_, BLOB };
+enum class DataType { REAL, INTEGER, BIGINT, TEXT, NULL_, BLOB, TIMESTAMP };
 
 /**
  * @brief The SQL constraint for column of data when creating a table schema
@@ -55,22 +64,267 @@ struct ColumnProperties {
   Constraint constraint;
 };
 
+/**
+ * @brief An index on one or more columns of a table
+ *
+ * Creates the following SQLite3 command:
+ * @n CREATE INDEX IF NOT EXISTS name ON table_name (column_1, column_2, ...);
+ */
+struct Index {
+  /**
+   * @brief The name of the index, unique within the database
+   */
+  std::string name;
+
+  /**
+   * @brief The indexed columns. The first column is the one the index is
+   *        sorted by, the rest make it a covering index for queries that
+   *        only read them.
+   */
+  std::vector<std::string> columns;
+};
+
+/**
+ * @brief A point in time, in seconds since the Unix epoch
+ *
+ * Stored as a plain integer, so timestamps sort and compare in SQL the way
+ * they do here and a range of them is an index seek. Nothing is formatted on
+ * the way in or parsed on the way out.
+ *
+ * Usage:
+ * @n new_row.row_data.emplace_back(database::Timestamp{std::time(nullptr)});
+ * @n auto const eaten = std::get<database::Timestamp>(value).seconds;
+ */
+struct Timestamp {
+  long long seconds = 0;
+
+  /**
+   * @return The day the timestamp falls on in UTC, in days since the epoch
+   */
+  constexpr auto day() const -> long long
+  {
+    // Rounds down for times before the epoch as well
+    long long const day = seconds / seconds_per_day;
+    return seconds % seconds_per_day < 0 ? day - 1 : day;
+  }
+
+  static constexpr long long seconds_per_day = 86400;
+};
+
+constexpr auto operator==(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds == b.seconds;
+}
+
+constexpr auto operator!=(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds != b.seconds;
+}
+
+constexpr auto operator<(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds < b.seconds;
+}
+
+constexpr auto operator<=(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds <= b.seconds;
+}
+
+constexpr auto operator>(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds > b.seconds;
+}
+
+constexpr auto operator>=(Timestamp const &a, Timestamp const &b) -> bool
+{
+  return a.seconds >= b.seconds;
+}
+
+/**
+ * @brief A read only view of bytes, the value of a BLOB column. Stands in for
+ *        std::span<std::byte const> until C++20.
+ *
+ * Does not own the bytes. Read from a query, it points into the memory SQLite
+ * keeps the current row in and is valid until the next row is read. Given to
+ * insert or update, it points into the storable and is bound without a copy.
+ *
+ * Usage:
+ * @n std::vector<float> const amounts = {0.5f, 12.f, 0.f};
+ * @n new_row.row_data.emplace_back(database::ByteView::of(amounts));
+ * @n amounts_ = std::get<database::ByteView>(value).to_vector<float>();
+ */
+class ByteView {
+public:
+  constexpr ByteView() = default;
+
+  constexpr ByteView(std::byte const *data, size_t size)
+      : data_{data}, size_{size}
+  {}
+
+  /**
+   * @return A view of the bytes of values
+   */
+  template <typename T>
+  static auto of(std::vector<T> const &values) -> ByteView
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable values can be viewed as bytes");
+
+    return ByteView(reinterpret_cast<std::byte const *>(values.data()),
+                    values.size() * sizeof(T));
+  }
+
+  /**
+   * @return A copy of the bytes as values of T, trailing bytes that do not
+   *         make up a whole T are ignored
+   *
+   * Copied rather than cast, SQLite does not align the memory of a BLOB.
+   */
+  template <typename T> auto to_vector() const -> std::vector<T>
+  {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Only trivially copyable values can be read from bytes");
+
+    std::vector<T> values(size_ / sizeof(T));
+    if (!values.empty()) {
+      std::memcpy(values.data(), data_, values.size() * sizeof(T));
+    }
+    return values;
+  }
+
+  constexpr auto data() const -> std::byte const *
+  {
+    return data_;
+  }
+
+  constexpr auto size() const -> size_t
+  {
+    return size_;
+  }
+
+  constexpr auto empty() const -> bool
+  {
+    return size_ == 0;
+  }
+
+  constexpr auto begin() const -> std::byte const *
+  {
+    return data_;
+  }
+
+  constexpr auto end() const -> std::byte const *
+  {
+    return data_ + size_;
+  }
+
+private:
+  std::byte const *data_ = nullptr;
+  size_t size_ = 0;
+};
+
 /**
  * @brief A row of variant data
+ *
+ * Allocator aware, a std::pmr container of rows hands its memory resource
+ * down to every row.
  */
 struct Row {
   /**
    * @brief The following data types are the expected types to be received from
-   *        the SOCI library when retrieving data
+   *        the database when retrieving data. The order follows
+   *        soci::data_type, Timestamp takes the place of dt_date and
+   *        ByteView is the value of a BLOB column.
    */
-  using row_data_t = std::variant<std::string, std::tm, double, int, long long,
-                                  unsigned long long>;
+  using row_data_t = std::variant<std::string, Timestamp, double, int,
+                                  long long, unsigned long long, ByteView>;
+
+  using allocator_type = std::pmr::polymorphic_allocator<row_data_t>;
+
+  Row() = default;
+  Row(Row const &row) = default;
+  Row(Row &&row) = default;
+  Row &operator=(Row const &row) = default;
+  Row &operator=(Row &&row) = default;
+  ~Row() = default;
+
+  explicit Row(allocator_type const &allocator) : row_data(allocator) {}
+
+  Row(Row const &row, allocator_type const &allocator)
+      : row_data(row.row_data, allocator)
+  {}
+
+  Row(Row &&row, allocator_type const &allocator)
+      : row_data(std::move(row.row_data), allocator)
+  {}
 
   /**
    * @brief The following data types are the expected types to be received from
    *        the SOCI library when retrieving data
    */
-  std::vector<row_data_t> row_data;
+  std::pmr::vector<row_data_t> row_data;
+};
+
+/**
+ * @brief A read only view of the values bound to a statement. Stands in for
+ *        std::span<Row::row_data_t const> until C++20.
+ *
+ * Does not own the values, so the row of a storable is bound without being
+ * copied. Made from a braced list, the list lives until the end of the
+ * statement the view is made in.
+ *
+ * Usage:
+ * @n statement.bind(data.rows[0].row_data);
+ * @n statement.bind({10.0});
+ */
+class Parameters {
+public:
+  constexpr Parameters() = default;
+
+  constexpr Parameters(Row::row_data_t const *data, size_t size)
+      : data_{data}, size_{size}
+  {}
+
+  Parameters(std::vector<Row::row_data_t> const &values)
+      : data_{values.data()}, size_{values.size()}
+  {}
+
+  Parameters(std::pmr::vector<Row::row_data_t> const &values)
+      : data_{values.data()}, size_{values.size()}
+  {}
+
+  Parameters(std::initializer_list<Row::row_data_t> values)
+      : data_{values.begin()}, size_{values.size()}
+  {}
+
+  constexpr auto size() const -> size_t
+  {
+    return size_;
+  }
+
+  constexpr auto empty() const -> bool
+  {
+    return size_ == 0;
+  }
+
+  constexpr auto operator[](size_t i) const -> Row::row_data_t const &
+  {
+    return data_[i];
+  }
+
+  constexpr auto begin() const -> Row::row_data_t const *
+  {
+    return data_;
+  }
+
+  constexpr auto end() const -> Row::row_data_t const *
+  {
+    return data_ + size_;
+  }
+
+private:
+  Row::row_data_t const *data_ = nullptr;
+  size_t size_ = 0;
 };
 
 /**
@@ -92,6 +346,11 @@ struct Data {
    *        order as the schema
    */
   std::vector<Row> rows;
+
+  /**
+   * @brief Indexes of the table, made on its first use if missing
+   */
+  std::vector<Index> indexes;
 };
 
 } // namespace database
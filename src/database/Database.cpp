@@ -14,13 +14,41 @@
 
 std::unique_ptr<soci::session> database::Database::sql_connection = nullptr;
 
+std::string database::Database::connection_string =
+    "db=tracker.db timeout=2 shared_cache=true";
+
 auto database::Database::get_connection() -> soci::session &
 {
   if (!sql_connection) {
     soci::register_factory_sqlite3();
-    sql_connection = std::make_unique<soci::session>(
-        "sqlite3", "db=tracker.db timeout=2 shared_cache=true");
+    sql_connection =
+        std::make_unique<soci::session>("sqlite3", connection_string);
   }
 
   return *sql_connection;
 }
+
+void database::Database::connect(std::string connection_string)
+{
+  sql_connection.reset();
+  Database::connection_string = std::move(connection_string);
+}
+
+auto database::Database::open_read_connection()
+    -> std::unique_ptr<soci::session>
+{
+  if (connection_string.find(":memory:") != std::string::npos) {
+    return nullptr;
+  }
+
+  std::string read_connection_string = connection_string;
+  std::string const shared_cache = "shared_cache=true";
+
+  auto const found = read_connection_string.find(shared_cache);
+  if (found != std::string::npos) {
+    read_connection_string.erase(found, shared_cache.size());
+  }
+
+  soci::register_factory_sqlite3();
+  return std::make_unique<soci::session>("sqlite3", read_connection_string);
+}
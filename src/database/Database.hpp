@@ -13,6 +13,7 @@
 #include <soci.h>
 
 #include <memory>
+#include <string>
 
 // Necessary to load a database with statically linked soci library
 extern "C" void soci::register_factory_sqlite3();
@@ -44,6 +45,38 @@ public:
    */
   static auto get_connection() -> soci::session &;
 
+  /**
+   * @brief Closes the current connection and points all future connections to
+   *        a new database.
+   *
+   * @param connection_string A soci sqlite3 connection string
+   *                          (e.g. "db=:memory:", "db=other.db timeout=2")
+   *
+   * The Storable caches in database::utils are not touched, clear them for
+   * any Storable type that was loaded before switching databases.
+   *
+   * Usage:
+   * @n database::Database::connect("db=:memory:");
+   * @n auto& sql_connection = database::Database::get_connection();
+   */
+  static void connect(std::string connection_string);
+
+  /**
+   * @brief Opens another connection to the current database, for reading on
+   *        a thread of its own
+   *
+   * @return The connection, or nullptr if the database lives in memory and
+   *         other connections would not see it
+   *
+   * The connection gets a page cache of its own even if the main connection
+   * uses a shared cache, SQLite serializes connections sharing a cache.
+   *
+   * Usage:
+   * @n auto reader = database::Database::open_read_connection();
+   * @n if (reader) { *reader << "SELECT ..."; }
+   */
+  static auto open_read_connection() -> std::unique_ptr<soci::session>;
+
   //! Deleted functions
   Database(const Database &) = delete;
   Database(Database &&) = delete;
@@ -55,5 +88,7 @@ private:
   ~Database() = default;
 
   static std::unique_ptr<soci::session> sql_connection;
+
+  static std::string connection_string;
 };
 } // namespace database
@@ -0,0 +1,98 @@
+/**
+ * @file Interner.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps a single copy of every distinct string in a shared arena
+ */
+
+#include "database/Interner.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+auto database::Interner::intern(std::string_view text) -> std::string_view
+{
+  if (text.empty()) { return {}; }
+
+  std::lock_guard lock(mutex_);
+
+  if (auto found = strings_.find(text); found != end(strings_)) {
+    return *found;
+  }
+
+  if (text.size() > block_size - used_) {
+    // The rest of the last block is left unused
+    blocks_.emplace_back(new char[std::max(block_size, text.size())]);
+    used_ = 0;
+  }
+
+  char *copy = blocks_.back().get() + used_;
+  std::memcpy(copy, text.data(), text.size());
+
+  // A long string fills its block, the next string starts a new one
+  used_ = std::min(used_ + text.size(), block_size);
+  bytes_ += text.size();
+
+  return *strings_.emplace(copy, text.size()).first;
+}
+
+auto database::Interner::size() const -> size_t
+{
+  std::lock_guard lock(mutex_);
+  return strings_.size();
+}
+
+auto database::Interner::bytes() const -> size_t
+{
+  std::lock_guard lock(mutex_);
+  return bytes_;
+}
+
+auto database::name_interner() -> Interner &
+{
+  // Never destroyed, the names of static caches must outlive them
+  static auto *interner = new Interner();
+  return *interner;
+}
+
+namespace {
+
+/**
+ * @brief The OwnedNames of the innermost Scope of this thread
+ */
+thread_local database::OwnedNames *current_names = nullptr;
+
+} // namespace
+
+database::OwnedNames::Scope::Scope(OwnedNames &names)
+    : previous_{current_names}
+{
+  current_names = &names;
+}
+
+database::OwnedNames::Scope::~Scope()
+{
+  current_names = previous_;
+}
+
+auto database::OwnedNames::store(std::string_view text) -> std::string_view
+{
+  if (text.empty()) { return {}; }
+
+  auto &copy = names_.emplace_back(new char[text.size()]);
+  std::memcpy(copy.get(), text.data(), text.size());
+  bytes_ += text.size() + sizeof(copy);
+
+  return std::string_view(copy.get(), text.size());
+}
+
+auto database::OwnedNames::bytes() const -> size_t
+{
+  return bytes_;
+}
+
+auto database::intern_name(std::string_view name) -> std::string_view
+{
+  if (current_names) { return current_names->store(name); }
+  return name_interner().intern(name);
+}
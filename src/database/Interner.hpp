@@ -0,0 +1,165 @@
+/**
+ * @file Interner.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps a single copy of every distinct string in a shared arena
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Organizes all databasing related classes and functions
+ */
+namespace database {
+
+/**
+ * @brief Keeps a single copy of every distinct string in an append only
+ *        arena, so objects can hold a std::string_view instead of a
+ *        std::string.
+ *
+ * Views returned by intern stay valid for the lifetime of the interner.
+ * Strings are never released, the arena grows with the number of distinct
+ * strings ever interned. Safe to use from several threads.
+ *
+ * Usage:
+ * @n database::Interner interner;
+ * @n std::string_view const name = interner.intern("taco");
+ * @n assert(name.data() == interner.intern("taco").data());
+ */
+class Interner {
+public:
+  Interner() = default;
+
+  /**
+   * @return A view of the interned copy of text, the same view for equal
+   *         strings
+   */
+  auto intern(std::string_view text) -> std::string_view;
+
+  /**
+   * @return The number of distinct strings interned
+   */
+  auto size() const -> size_t;
+
+  /**
+   * @return The bytes of characters held in the arena
+   */
+  auto bytes() const -> size_t;
+
+  //! Deleted functions
+  Interner(Interner const &) = delete;
+  Interner(Interner &&) = delete;
+  Interner &operator=(Interner const &) = delete;
+  Interner &operator=(Interner &&) = delete;
+
+private:
+  /**
+   * @brief The size of each block of characters, longer strings get a block
+   *        of their own
+   */
+  static constexpr size_t block_size = 64 * 1024;
+
+  mutable std::mutex mutex_;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+
+  /**
+   * @brief Characters used in the last block
+   */
+  size_t used_ = block_size;
+
+  size_t bytes_ = 0;
+
+  /**
+   * @brief Pools the nodes of the set, every access holds the mutex
+   */
+  std::pmr::unsynchronized_pool_resource pool_;
+
+  std::pmr::unordered_set<std::string_view> strings_{&pool_};
+};
+
+/**
+ * @brief The interner the names of every Storable are kept in
+ *
+ * Usage:
+ * @n this->name_ = database::name_interner().intern(name);
+ */
+auto name_interner() -> Interner &;
+
+/**
+ * @brief Owns the names of objects that are released one at a time, e.g. by
+ *        a BoundedCache, so their names are freed along with them instead of
+ *        staying in name_interner for good
+ *
+ * While a Scope is alive, intern_name on its thread copies names into the
+ * OwnedNames it was made with. Equal names are not shared.
+ *
+ * Usage:
+ * @n database::OwnedNames names;
+ * @n {
+ * @n   database::OwnedNames::Scope scope(names);
+ * @n   // Objects decoded here keep views of strings owned by names
+ * @n }
+ */
+class OwnedNames {
+public:
+  /**
+   * @brief Sends the names interned on this thread to names while alive
+   */
+  class Scope {
+  public:
+    explicit Scope(OwnedNames &names);
+    ~Scope();
+
+    //! Deleted functions
+    Scope(Scope const &) = delete;
+    Scope(Scope &&) = delete;
+    Scope &operator=(Scope const &) = delete;
+    Scope &operator=(Scope &&) = delete;
+
+  private:
+    OwnedNames *previous_;
+  };
+
+  OwnedNames() = default;
+
+  /**
+   * @return A view of a copy of text, valid as long as this object
+   */
+  auto store(std::string_view text) -> std::string_view;
+
+  /**
+   * @return The bytes of characters held, with the pointer to each copy
+   */
+  auto bytes() const -> size_t;
+
+  //! Deleted functions, views point into the copies
+  OwnedNames(OwnedNames const &) = delete;
+  OwnedNames(OwnedNames &&) = delete;
+  OwnedNames &operator=(OwnedNames const &) = delete;
+  OwnedNames &operator=(OwnedNames &&) = delete;
+
+private:
+  std::vector<std::unique_ptr<char[]>> names_;
+  size_t bytes_ = 0;
+};
+
+/**
+ * @brief Interns the name of a Storable being decoded, in the OwnedNames of
+ *        the innermost Scope of this thread if there is one, in
+ *        name_interner otherwise
+ *
+ * Usage:
+ * @n this->name_ = database::intern_name(name);
+ */
+auto intern_name(std::string_view name) -> std::string_view;
+
+} // namespace database
@@ -0,0 +1,16 @@
+/**
+ * @file Memory.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Memory resources for the Storable caches and for the temporaries
+ *        made while decoding rows
+ */
+
+#include "database/Memory.hpp"
+
+auto database::cache_resource() -> std::pmr::memory_resource *
+{
+  // Never destroyed, caches are static and may outlive any other static
+  static auto *resource = new std::pmr::synchronized_pool_resource();
+  return resource;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file Memory.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Memory resources for the Storable caches and for the temporaries
+ *        made while decoding rows
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief Organizes all databasing related classes and functions
+ */
+namespace database {
+
+/**
+ * @brief The pool every Storable cache allocates from
+ *
+ * Cached objects live until the cache is cleared, so their memory is pooled
+ * by size instead of going through malloc one object at a time. The pool is
+ * synchronized, chunks of a table may be read on another thread.
+ *
+ * Usage:
+ * @n struct Allocator : std::pmr::polymorphic_allocator<Food> {
+ * @n   Allocator()
+ * @n       : std::pmr::polymorphic_allocator<Food>(database::cache_resource())
+ * @n   {}
+ * @n };
+ */
+auto cache_resource() -> std::pmr::memory_resource *;
+
+/**
+ * @brief A monotonic arena that starts out in a buffer of size bytes inside
+ *        the object, so short lived temporaries never reach the heap as long
+ *        as they fit.
+ *
+ * Usage:
+ * @n database::StackArena<1024> arena;
+ * @n std::pmr::unordered_map<std::string_view, int> columns(&arena);
+ */
+template <size_t size>
+class StackArena : public std::pmr::monotonic_buffer_resource {
+public:
+  StackArena() : std::pmr::monotonic_buffer_resource(buffer_.data(), size) {}
+
+  //! Deleted functions
+  StackArena(StackArena const &) = delete;
+  StackArena(StackArena &&) = delete;
+  StackArena &operator=(StackArena const &) = delete;
+  StackArena &operator=(StackArena &&) = delete;
+
+private:
+  alignas(std::max_align_t) std::array<std::byte, size> buffer_;
+};
+
+} // namespace database
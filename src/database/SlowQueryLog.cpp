@@ -0,0 +1,184 @@
+/**
+ * @file SlowQueryLog.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Records statements that exceed a latency threshold, along with their
+ *        query plan, to a rotating log file.
+ */
+
+#include "database/SlowQueryLog.hpp"
+#include "database/Statement.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <variant>
+
+namespace {
+
+auto default_settings() -> database::SlowQueryLog::Settings
+{
+  database::SlowQueryLog::Settings settings;
+
+  if (char const *threshold = std::getenv("TRACKER_SLOW_QUERY_MS")) {
+    settings.threshold = std::chrono::milliseconds(std::atol(threshold));
+  }
+
+  return settings;
+}
+
+auto log_mutex() -> std::mutex &
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * @brief Formats parameters the way they would appear in SQL
+ */
+auto parameters_to_string(database::Parameters parameters) -> std::string
+{
+  std::stringstream ss;
+  ss << "[";
+
+  auto delimeter = "";
+  for (auto const &parameter : parameters) {
+    ss << delimeter;
+
+    std::visit(
+        [&ss = ss](auto const &value) {
+          using T = std::decay_t<decltype(value)>;
+          if constexpr (std::is_same_v<T, std::string>) {
+            ss << "'" << value << "'";
+          } else if constexpr (std::is_same_v<T, database::Timestamp>) {
+            ss << value.seconds;
+          } else if constexpr (std::is_same_v<T, database::ByteView>) {
+            ss << "<" << value.size() << " bytes>";
+          } else {
+            ss << value;
+          }
+        },
+        parameter);
+
+    delimeter = ", ";
+  }
+
+  ss << "]";
+  return ss.str();
+}
+
+} // namespace
+
+database::SlowQueryLog::Settings database::SlowQueryLog::current_settings =
+    default_settings();
+
+void database::SlowQueryLog::configure(Settings settings)
+{
+  std::lock_guard lock(log_mutex());
+  current_settings = std::move(settings);
+}
+
+auto database::SlowQueryLog::settings() -> Settings
+{
+  std::lock_guard lock(log_mutex());
+  return current_settings;
+}
+
+void database::SlowQueryLog::record(std::string const &sql_command,
+                                    Parameters parameters,
+                                    std::chrono::nanoseconds duration,
+                                    soci::session &sql_connection)
+{
+  {
+    std::lock_guard lock(log_mutex());
+    if (!current_settings.enabled || duration < current_settings.threshold) {
+      return;
+    }
+  }
+
+  // Explain before taking the lock, it runs another statement
+  auto const plan =
+      SlowQueryLog::explain(sql_command, parameters, sql_connection);
+
+  std::lock_guard lock(log_mutex());
+
+  std::ofstream log(current_settings.path, std::ios::app);
+  if (!log) {
+    std::cerr << "Failed to open slow query log " << current_settings.path
+              << std::endl;
+    return;
+  }
+
+  std::time_t const now = std::time(nullptr);
+  std::tm utc{};
+  gmtime_r(&now, &utc);
+  char timestamp[32];
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+  double const milliseconds =
+      std::chrono::duration<double, std::milli>(duration).count();
+
+  log << timestamp << " duration_ms=" << milliseconds << "\n";
+  log << "sql: " << sql_command << "\n";
+  log << "parameters: " << parameters_to_string(parameters) << "\n";
+  log << "plan:\n";
+  for (auto const &step : plan) {
+    log << "  " << step << "\n";
+  }
+  log << "\n";
+
+  bool const should_rotate =
+      static_cast<size_t>(log.tellp()) >= current_settings.max_bytes;
+  log.close();
+
+  if (should_rotate) { SlowQueryLog::rotate(); }
+}
+
+auto database::SlowQueryLog::explain(std::string const &sql_command,
+                                     Parameters parameters,
+                                     soci::session &sql_connection)
+    -> std::vector<std::string>
+{
+  std::vector<std::string> plan;
+
+  try {
+    // Columns: id | parent | notused | detail
+    Statement statement(sql_connection, "EXPLAIN QUERY PLAN " + sql_command);
+    statement.bind(parameters);
+
+    while (statement.step()) {
+      int const detail = statement.column_count() - 1;
+      plan.emplace_back(std::get<std::string>(statement.column(detail)));
+    }
+  } catch (std::exception const &error) {
+    plan.emplace_back(std::string("EXPLAIN QUERY PLAN failed: ") +
+                      error.what());
+  }
+
+  return plan;
+}
+
+void database::SlowQueryLog::rotate()
+{
+  auto const &path = current_settings.path;
+  auto const rotated = [&path](size_t n) {
+    return path + "." + std::to_string(n);
+  };
+
+  if (current_settings.max_files == 0) {
+    std::remove(path.c_str());
+    return;
+  }
+
+  std::remove(rotated(current_settings.max_files).c_str());
+  for (size_t n = current_settings.max_files - 1; n >= 1; --n) {
+    std::rename(rotated(n).c_str(), rotated(n + 1).c_str());
+  }
+
+  std::rename(path.c_str(), rotated(1).c_str());
+}
@@ -0,0 +1,122 @@
+/**
+ * @file SlowQueryLog.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Records statements that exceed a latency threshold, along with their
+ *        query plan, to a rotating log file.
+ */
+
+#pragma once
+
+#include "database/Data.hpp"
+
+#include <soci.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Organizes all databasing related classes and functions
+ */
+namespace database {
+
+/**
+ * @brief Records statements that exceed a latency threshold to a rotating log
+ *        file.
+ *
+ * Each entry contains the SQL text, the bound parameters, how long the
+ * statement took and the output of EXPLAIN QUERY PLAN for the statement, so a
+ * full table scan caused by a missing index shows up as a SCAN line.
+ *
+ * The threshold can also be set in milliseconds with the
+ * TRACKER_SLOW_QUERY_MS environment variable.
+ */
+class SlowQueryLog {
+public:
+  /**
+   * @brief How and where slow statements are recorded
+   */
+  struct Settings {
+    /**
+     * @brief Statements that take at least this long are recorded
+     */
+    std::chrono::microseconds threshold{std::chrono::milliseconds(100)};
+
+    /**
+     * @brief The log file, rotated files get a .1, .2, ... suffix
+     */
+    std::string path{"tracker_slow_queries.log"};
+
+    /**
+     * @brief The log is rotated once it grows past this size
+     */
+    size_t max_bytes{1024 * 1024};
+
+    /**
+     * @brief Number of rotated files kept besides the current log
+     */
+    size_t max_files{3};
+
+    /**
+     * @brief Nothing is recorded when false
+     */
+    bool enabled{true};
+  };
+
+  /**
+   * @brief Replaces the current settings
+   *
+   * Usage:
+   * @n database::SlowQueryLog::Settings settings;
+   * @n settings.threshold = std::chrono::milliseconds(10);
+   * @n database::SlowQueryLog::configure(settings);
+   */
+  static void configure(Settings settings);
+
+  /**
+   * @return A copy of the current settings
+   */
+  static auto settings() -> Settings;
+
+  /**
+   * @brief Records the statement if it took longer than the threshold
+   *
+   * @param sql_command The SQL statement that was executed
+   * @param parameters The values that were bound to the statement
+   * @param duration How long the statement took
+   * @param sql_connection The connection the statement ran on, its plan is
+   *        explained on the same one from the same thread
+   */
+  static void record(std::string const &sql_command, Parameters parameters,
+                     std::chrono::nanoseconds duration,
+                     soci::session &sql_connection);
+
+  //! Deleted functions
+  SlowQueryLog() = delete;
+  SlowQueryLog(const SlowQueryLog &) = delete;
+  SlowQueryLog(SlowQueryLog &&) = delete;
+  SlowQueryLog &operator=(const SlowQueryLog &) = delete;
+  SlowQueryLog &operator=(SlowQueryLog &&) = delete;
+
+private:
+  /**
+   * @return The query plan of the statement, one line per step
+   */
+  static auto explain(std::string const &sql_command, Parameters parameters,
+                      soci::session &sql_connection)
+      -> std::vector<std::string>;
+
+  /**
+   * @brief Moves log to log.1, log.1 to log.2, ... dropping the oldest file.
+   *        The caller holds the log mutex.
+   */
+  static void rotate();
+
+  /**
+   * @brief Read and written with the log mutex held, statements may be
+   *        recorded from any thread
+   */
+  static Settings current_settings;
+};
+} // namespace database
@@ -0,0 +1,180 @@
+/**
+ * @file Statement.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A prepared statement on the SQLite connection of a soci session,
+ *        binding and reading text and BLOB values without copies
+ */
+
+#include "database/Statement.hpp"
+
+#include <soci-sqlite3.h>
+
+#include <climits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace {
+
+/**
+ * @return true if declared contains name, ignoring case the way SQLite does
+ *         for type names. name is upper case.
+ */
+auto declared_as(char const *declared, std::string_view name) -> bool
+{
+  if (declared == nullptr) { return false; }
+
+  auto const upper = [](char character) {
+    return character >= 'a' && character <= 'z'
+               ? static_cast<char>(character - ('a' - 'A'))
+               : character;
+  };
+
+  std::string_view const type = declared;
+  for (size_t start = 0; start + name.size() <= type.size(); ++start) {
+    size_t i = 0;
+    while (i < name.size() && upper(type[start + i]) == name[i]) {
+      ++i;
+    }
+    if (i == name.size()) { return true; }
+  }
+  return false;
+}
+
+} // namespace
+
+database::Statement::Statement(soci::session &sql_connection,
+                               std::string const &sql_command)
+{
+  using Backend = soci::sqlite3_session_backend;
+  connection_ = static_cast<Backend *>(sql_connection.get_backend())->conn_;
+
+  if (sqlite3_prepare_v2(connection_, sql_command.c_str(), -1, &statement_,
+                         nullptr) != SQLITE_OK) {
+    this->fail("Failed to prepare statement");
+  }
+}
+
+database::Statement::~Statement()
+{
+  sqlite3_finalize(statement_);
+}
+
+void database::Statement::bind(Parameters parameters)
+{
+  if (static_cast<int>(parameters.size()) !=
+      sqlite3_bind_parameter_count(statement_)) {
+    throw std::runtime_error("Number of parameters does not match the number "
+                             "of placeholders");
+  }
+
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    int const index = static_cast<int>(i) + 1;
+
+    int const result = std::visit(
+        [this, index](auto const &value) {
+          using T = std::decay_t<decltype(value)>;
+          if constexpr (std::is_same_v<T, std::string>) {
+            return sqlite3_bind_text(statement_, index, value.data(),
+                                     static_cast<int>(value.size()),
+                                     SQLITE_STATIC);
+          } else if constexpr (std::is_same_v<T, Timestamp>) {
+            return sqlite3_bind_int64(statement_, index, value.seconds);
+          } else if constexpr (std::is_same_v<T, double>) {
+            return sqlite3_bind_double(statement_, index, value);
+          } else if constexpr (std::is_same_v<T, int>) {
+            return sqlite3_bind_int(statement_, index, value);
+          } else if constexpr (std::is_same_v<T, ByteView>) {
+            // A null pointer would bind NULL instead of an empty BLOB
+            if (value.empty()) {
+              return sqlite3_bind_zeroblob(statement_, index, 0);
+            }
+            return sqlite3_bind_blob(statement_, index, value.data(),
+                                     static_cast<int>(value.size()),
+                                     SQLITE_STATIC);
+          } else { // long long, unsigned long long
+            return sqlite3_bind_int64(statement_, index,
+                                      static_cast<sqlite3_int64>(value));
+          }
+        },
+        parameters[i]);
+
+    if (result != SQLITE_OK) { this->fail("Failed to bind parameter"); }
+  }
+}
+
+auto database::Statement::step() -> bool
+{
+  int const result = sqlite3_step(statement_);
+  if (result == SQLITE_ROW) {
+    if (kinds_.empty()) { this->classify(); }
+    return true;
+  }
+  if (result == SQLITE_DONE) { return false; }
+
+  this->fail("Failed to execute statement");
+}
+
+auto database::Statement::column_count() const -> int
+{
+  return sqlite3_column_count(statement_);
+}
+
+auto database::Statement::column_name(int column) const -> std::string
+{
+  return sqlite3_column_name(statement_, column);
+}
+
+auto database::Statement::column(int column) const -> Row::row_data_t
+{
+  switch (sqlite3_column_type(statement_, column)) {
+  case SQLITE_INTEGER: {
+    sqlite3_int64 const value = sqlite3_column_int64(statement_, column);
+    auto const kind = kinds_[column];
+    if (kind == ColumnKind::TIMESTAMP) { return Timestamp{value}; }
+    if (kind == ColumnKind::BIGINT || value < INT_MIN || value > INT_MAX) {
+      return static_cast<long long>(value);
+    }
+    return static_cast<int>(value);
+  }
+  case SQLITE_FLOAT:
+    return sqlite3_column_double(statement_, column);
+  case SQLITE_TEXT: {
+    auto const *text =
+        reinterpret_cast<char const *>(sqlite3_column_text(statement_, column));
+    return std::string(text, sqlite3_column_bytes(statement_, column));
+  }
+  case SQLITE_BLOB: {
+    // The pointer is asked for before the size, as SQLite requires
+    auto const *bytes =
+        static_cast<std::byte const *>(sqlite3_column_blob(statement_, column));
+    return ByteView(bytes, sqlite3_column_bytes(statement_, column));
+  }
+  default:
+    throw std::runtime_error("NULL values can not be read");
+  }
+}
+
+void database::Statement::fail(std::string const &what) const
+{
+  throw std::runtime_error(what + ": " + sqlite3_errmsg(connection_));
+}
+
+void database::Statement::classify()
+{
+  int const num_columns = this->column_count();
+  kinds_.reserve(num_columns);
+
+  for (int column = 0; column < num_columns; ++column) {
+    char const *declared = sqlite3_column_decltype(statement_, column);
+    if (declared_as(declared, "TIMESTAMP")) {
+      kinds_.push_back(ColumnKind::TIMESTAMP);
+    } else if (declared_as(declared, "BIGINT")) {
+      kinds_.push_back(ColumnKind::BIGINT);
+    } else {
+      kinds_.push_back(ColumnKind::INT);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file Statement.hpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A prepared statement on the SQLite connection of a soci session,
+ *        binding and reading text and BLOB values without copies
+ */
+
+#pragma once
+
+#include "database/Data.hpp"
+
+#include <soci.h>
+#include <sqlite3.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Organizes all databasing related classes and functions
+ */
+namespace database {
+
+/**
+ * @brief A prepared statement run directly on the SQLite connection behind a
+ *        soci session
+ *
+ * soci copies BLOB values in and out of its own buffers. Here text and BLOB
+ * parameters are bound in place and must outlive the statement, and BLOB
+ * columns are read as views of the memory SQLite keeps the current row in.
+ *
+ * Integer columns are read as int, or long long if declared BIGINT, the way
+ * soci reads them, and as a Timestamp if declared TIMESTAMP.
+ *
+ * Usage:
+ * @n database::Statement statement(database::Database::get_connection(),
+ * @n                               "SELECT * FROM Food WHERE fat > :fat");
+ * @n statement.bind({10.0});
+ * @n while (statement.step()) {
+ * @n   auto const name = std::get<std::string>(statement.column(1));
+ * @n }
+ *
+ * Will throw a runtime error if the statement fails
+ */
+class Statement {
+public:
+  /**
+   * @param sql_connection The session whose connection runs the statement
+   * @param sql_command A single SQL statement, with :name placeholders for
+   *                    the parameters
+   */
+  Statement(soci::session &sql_connection, std::string const &sql_command);
+
+  ~Statement();
+
+  /**
+   * @param parameters Values bound to the placeholders, in order of
+   *                   appearance. Must outlive the statement.
+   */
+  void bind(Parameters parameters);
+
+  /**
+   * @brief Runs the statement until the next row of the result
+   * @return true if there is a row to read, false once the statement is done
+   */
+  auto step() -> bool;
+
+  /**
+   * @return The number of columns in a row of the result
+   */
+  auto column_count() const -> int;
+
+  /**
+   * @return The name of column in the result
+   */
+  auto column_name(int column) const -> std::string;
+
+  /**
+   * @return The value of column in the current row. A BLOB is a view that
+   *         is valid until the next call to step.
+   */
+  auto column(int column) const -> Row::row_data_t;
+
+  //! Deleted functions
+  Statement(Statement const &) = delete;
+  Statement(Statement &&) = delete;
+  Statement &operator=(Statement const &) = delete;
+  Statement &operator=(Statement &&) = delete;
+
+private:
+  /**
+   * @brief How the integers of a column are read, from its declared type
+   */
+  enum class ColumnKind { INT, BIGINT, TIMESTAMP };
+
+  /**
+   * @brief Throws a runtime error with what went wrong and SQLite's message
+   */
+  [[noreturn]] void fail(std::string const &what) const;
+
+  /**
+   * @brief Reads the declared type of every column once, on the first row
+   */
+  void classify();
+
+  sqlite3 *connection_ = nullptr;
+  sqlite3_stmt *statement_ = nullptr;
+
+  /**
+   * @brief The kind of every column of the result
+   */
+  std::vector<ColumnKind> kinds_;
+};
+
+} // namespace database
@@ -0,0 +1,151 @@
+/**
+ * @file DailyTotals.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Macronutrients eaten per day, with the total of any range of days in
+ *        O(log n)
+ */
+
+#include "food/DailyTotals.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * @return The lowest set bit of i, the span of tree node i
+ */
+auto lowest_bit(size_t i) -> size_t
+{
+  return i & (~i + 1);
+}
+
+} // namespace
+
+void food::DailyTotals::add(long long day, Macronutrients const &macros)
+{
+  if (!this->cover(day)) {
+    far_days_[day] += macros;
+    return;
+  }
+
+  size_t const index = day - first_day_;
+  days_[index] += macros;
+
+  for (size_t node = index + 1; node < tree_.size(); node += lowest_bit(node)) {
+    tree_[node] += macros;
+  }
+}
+
+void food::DailyTotals::subtract(long long day, Macronutrients const &macros)
+{
+  Macronutrients negated = macros;
+  negated *= -1;
+  this->add(day, negated);
+}
+
+auto food::DailyTotals::total(long long first_day, long long last_day) const
+    -> Macronutrients
+{
+  Macronutrients total;
+  if (first_day > last_day) { return total; }
+
+  auto const last_far = far_days_.upper_bound(last_day);
+  for (auto far = far_days_.lower_bound(first_day); far != last_far; ++far) {
+    total += far->second;
+  }
+
+  if (days_.empty()) { return total; }
+
+  long long const last_covered = first_day_ + days_.size() - 1;
+  first_day = std::max(first_day, first_day_);
+  last_day = std::min(last_day, last_covered);
+
+  if (first_day > last_day) { return total; }
+
+  total += this->prefix(last_day - first_day_ + 1);
+  total -= this->prefix(first_day - first_day_);
+  return total;
+}
+
+auto food::DailyTotals::day(long long day) const -> Macronutrients
+{
+  long long const size = days_.size();
+  if (day < first_day_ || day >= first_day_ + size) {
+    auto const far = far_days_.find(day);
+    return far == end(far_days_) ? Macronutrients() : far->second;
+  }
+
+  return days_[day - first_day_];
+}
+
+void food::DailyTotals::clear()
+{
+  first_day_ = 0;
+  days_.clear();
+  tree_.clear();
+  far_days_.clear();
+}
+
+auto food::DailyTotals::cover(long long day) -> bool
+{
+  if (days_.empty()) {
+    first_day_ = day;
+    days_.resize(1);
+  } else {
+    long long const size = days_.size();
+    long long const last_day = first_day_ + size - 1;
+    long long const max_days = max_covered_days;
+
+    if (day >= first_day_ && day <= last_day) { return true; }
+    if (std::max(day, last_day) - std::min(day, first_day_) >= max_days) {
+      return false;
+    }
+
+    // Doubles so adding day by day stays amortized O(1), within max_days
+    if (day < first_day_) {
+      long long const new_first_day =
+          std::max(std::min(day, first_day_ - size), last_day - max_days + 1);
+      days_.insert(begin(days_), first_day_ - new_first_day, Macronutrients());
+      first_day_ = new_first_day;
+    } else {
+      days_.resize(std::min(std::max(day - first_day_ + 1, 2 * size),
+                            max_days));
+    }
+  }
+
+  // Days kept on their own that are covered now move into days_
+  long long const last_day = first_day_ + days_.size() - 1;
+  auto const first_far = far_days_.lower_bound(first_day_);
+  auto const last_far = far_days_.upper_bound(last_day);
+  for (auto far = first_far; far != last_far; ++far) {
+    days_[far->first - first_day_] += far->second;
+  }
+  far_days_.erase(first_far, last_far);
+
+  this->rebuild();
+  return true;
+}
+
+void food::DailyTotals::rebuild()
+{
+  size_t const size = days_.size();
+  tree_.assign(size + 1, Macronutrients());
+
+  // Every node passes its sum up to its parent once
+  for (size_t node = 1; node <= size; ++node) {
+    tree_[node] += days_[node - 1];
+
+    size_t const parent = node + lowest_bit(node);
+    if (parent <= size) { tree_[parent] += tree_[node]; }
+  }
+}
+
+auto food::DailyTotals::prefix(size_t count) const -> Macronutrients
+{
+  Macronutrients sum;
+  for (size_t node = count; node > 0; node -= lowest_bit(node)) {
+    sum += tree_[node];
+  }
+  return sum;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file Entry.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief An entry in the food diary, a portion of a food eaten at some time
+ */
+
+#include "food/Entry.hpp"
+#include "database/Data.hpp"
+#include "database/Memory.hpp"
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "trace/Trace.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <algorithm>
+#include <memory_resource>
+#include <sstream>
+#include <unordered_map>
+
+food::Entry::Entry(int id) : id_{id} {}
+
+food::Entry::Entry(int id, int food_id, double grams, std::time_t timestamp,
+                   Meal meal)
+    : id_{id}, food_id_{food_id}, grams_{grams}, timestamp_{timestamp},
+      meal_{meal}
+{}
+
+food::Entry::Entry(std::vector<database::ColumnProperties> const &schema,
+                   database::Row const &data)
+{
+  this->set_data(schema, data);
+}
+
+auto food::Entry::name() const -> std::string_view
+{
+  auto const &all_food = database::utils::retrieve_all<Food>();
+
+  auto const compare = [](Food const &food, int id) { return food.id() < id; };
+  auto found = std::lower_bound(begin(all_food), end(all_food),
+                                this->food_id(), compare);
+
+  if (found == end(all_food) || found->id() != this->food_id()) { return ""; }
+  return found->name();
+}
+
+void food::Entry::set_name(std::string_view name)
+{
+  auto const &all_food = database::utils::retrieve_all<Food>();
+
+  auto found = std::find_if(begin(all_food), end(all_food),
+                            [name](Food const &food) {
+                              return food.name() == name;
+                            });
+
+  if (found == end(all_food)) {
+    std::cerr << "No food named " << name << std::endl;
+    throw std::runtime_error("Entry must refer to an existing food");
+  }
+
+  this->set_food_id(found->id());
+}
+
+auto food::Entry::food_id() const -> int
+{
+  return this->food_id_;
+}
+
+void food::Entry::set_food_id(int food_id)
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::set_food_id");
+
+  this->food_id_ = food_id;
+  database::utils::update(*this);
+}
+
+auto food::Entry::grams() const -> double
+{
+  return this->grams_;
+}
+
+void food::Entry::set_grams(double grams)
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::set_grams");
+
+  this->grams_ = grams;
+  database::utils::update(*this);
+}
+
+auto food::Entry::timestamp() const -> std::time_t
+{
+  return this->timestamp_;
+}
+
+void food::Entry::set_timestamp(std::time_t timestamp)
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::set_timestamp");
+
+  this->timestamp_ = timestamp;
+  database::utils::update(*this);
+}
+
+auto food::Entry::meal() const -> Meal
+{
+  return this->meal_;
+}
+
+void food::Entry::set_meal(Meal meal)
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::set_meal");
+
+  this->meal_ = meal;
+  database::utils::update(*this);
+}
+
+auto food::Entry::get_data() const -> database::Data const
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::get_data");
+
+  database::Data data;
+  data.table_name = "Entry";
+
+  // Entry ID|food_id|grams|timestamp|meal
+  size_t num_columns = 5;
+  data.schema.reserve(num_columns);
+
+  // The properties of a single column;
+  database::ColumnProperties column_properties;
+
+  // Entry_id column begin
+  column_properties.name = data.table_name + "_id";
+  column_properties.data_type = database::DataType::INTEGER;
+  column_properties.constraint = database::Constraint::PRIMARY_KEY;
+  data.schema.emplace_back(column_properties);
+
+  database::Row new_row;
+  new_row.row_data.reserve(num_columns);
+
+  // std::variant to hold multiple data types. Defined in Data.hpp.
+  database::Row::row_data_t row_data = this->id();
+  new_row.row_data.emplace_back(row_data);
+
+  // The rest of the columns from hereon will be NOT NULL constraint
+  column_properties.constraint = database::Constraint::NOT_NULL;
+
+  column_properties.name = "food_id";
+  column_properties.data_type = database::DataType::INTEGER;
+  data.schema.emplace_back(column_properties);
+  row_data = this->food_id();
+  new_row.row_data.emplace_back(row_data);
+
+  column_properties.name = "grams";
+  column_properties.data_type = database::DataType::REAL;
+  data.schema.emplace_back(column_properties);
+  row_data = this->grams();
+  new_row.row_data.emplace_back(row_data);
+
+  column_properties.name = "timestamp";
+  column_properties.data_type = database::DataType::TIMESTAMP;
+  data.schema.emplace_back(column_properties);
+  row_data = database::Timestamp{this->timestamp()};
+  new_row.row_data.emplace_back(row_data);
+
+  column_properties.name = "meal";
+  column_properties.data_type = database::DataType::INTEGER;
+  data.schema.emplace_back(column_properties);
+  row_data = static_cast<int>(this->meal());
+  new_row.row_data.emplace_back(row_data);
+
+  data.rows.emplace_back(std::move(new_row));
+
+  // Sorted by time and covering every column, range queries on the
+  // timestamp never touch the table itself. The id is the rowid, which
+  // every index already contains.
+  data.indexes.push_back(
+      {"Entry_timestamp", {"timestamp", "food_id", "grams", "meal"}});
+
+  return data;
+}
+
+void food::Entry::set_data(
+    std::vector<database::ColumnProperties> const &schema,
+    database::Row const &row)
+{
+  TRACKER_TRACE_SCOPE("food", "Entry::set_data");
+
+  // Points into the row rather than copying it, nothing leaves the arena
+  database::StackArena<1024> arena;
+  std::pmr::unordered_map<std::string_view, database::Row::row_data_t const *>
+      organized_data(&arena);
+
+  for (auto const &[first, second] : ranges::view::zip(schema, row.row_data)) {
+    organized_data[first.name] = &second;
+  }
+
+  this->id_ = std::get<int>(*organized_data.at("Entry_id"));
+  this->food_id_ = std::get<int>(*organized_data.at("food_id"));
+  this->grams_ = std::get<double>(*organized_data.at("grams"));
+  this->timestamp_ =
+      std::get<database::Timestamp>(*organized_data.at("timestamp")).seconds;
+  this->meal_ = static_cast<Meal>(std::get<int>(*organized_data.at("meal")));
+}
+
+auto food::Entry::str() const -> std::string
+{
+  std::stringstream ss;
+  ss << this->id();
+
+  auto const delimeter = "|";
+  ss << delimeter << this->food_id();
+  ss << delimeter << this->grams();
+  ss << delimeter << this->timestamp();
+  ss << delimeter << static_cast<int>(this->meal());
+
+  return ss.str();
+}
+
+auto food::entries_between(std::time_t begin, std::time_t end)
+    -> std::vector<Entry, Entry::Allocator>
+{
+  TRACKER_TRACE_SCOPE("food", "entries_between");
+
+  return database::utils::retrieve_range<Entry>(
+      "timestamp", database::Timestamp{begin}, database::Timestamp{end});
+}
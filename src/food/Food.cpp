@@ -9,18 +9,25 @@
 
 #include "food/Food.hpp"
 #include "database/Data.hpp"
+#include "database/Interner.hpp"
+#include "database/Memory.hpp"
 #include "database/utils.hpp"
+#include "trace/Trace.hpp"
 
 #include <range/v3/all.hpp>
 
+#include <memory_resource>
 #include <sstream>
 #include <unordered_map>
 
 food::Food::Food(int id) : id_{id} {}
 
-food::Food::Food(int id, std::string food_name, Macronutrients macros)
-    : id_{id}, name_{std::move(food_name)}, macronutrients_{macros}
-{}
+food::Food::Food(int id, std::string_view food_name,
+                 Macronutrients const &macros)
+    : id_{id}, name_{database::name_interner().intern(food_name)}
+{
+  this->store(macros);
+}
 
 food::Food::Food(std::vector<database::ColumnProperties> const &schema,
                  database::Row const &data)
@@ -28,35 +35,40 @@ food::Food::Food(std::vector<database::ColumnProperties> const &schema,
   this->set_data(schema, data);
 }
 
-auto food::Food::id() const -> int
-{
-  return this->id_;
-}
-
-auto food::Food::name() const -> std::string const
+auto food::Food::name() const -> std::string_view
 {
   return this->name_;
 }
 
 void food::Food::set_name(std::string_view name)
 {
-  this->name_ = name;
+  TRACKER_TRACE_SCOPE("food", "Food::set_name");
+
+  // Interned names are never freed, a renamed food owns its name
+  this->renamed_ = std::make_shared<std::string const>(name);
+  this->name_ = *this->renamed_;
   database::utils::update(*this);
 }
 
 auto food::Food::macronutrients() const -> Macronutrients const
 {
-  return this->macronutrients_;
+  return Macronutrients(Fat(this->fat_),
+                        Carbohydrate(this->carbohydrate_, Fiber(this->fiber_)),
+                        Protein(this->protein_));
 }
 
 void food::Food::set_macronutrients(Macronutrients const &macros)
 {
-  this->macronutrients_ = macros;
+  TRACKER_TRACE_SCOPE("food", "Food::set_macronutrients");
+
+  this->store(macros);
   database::utils::update(*this);
 }
 
 auto food::Food::get_data() const -> database::Data const
 {
+  TRACKER_TRACE_SCOPE("food", "Food::get_data");
+
   database::Data data;
   data.table_name = "Food";
 
@@ -73,15 +85,14 @@ auto food::Food::get_data() const -> database::Data const
   column_properties.constraint = database::Constraint::PRIMARY_KEY;
   data.schema.emplace_back(column_properties);
 
-  std::vector<database::Row::row_data_t> new_row;
-  new_row.reserve(num_columns);
+  database::Row new_row;
+  new_row.row_data.reserve(num_columns);
 
   // std::variant to hold multiple data types. Defined in Data.hpp.
   database::Row::row_data_t row_data = this->id();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
   // name column Begin
-  // The name of the table needs to be in single quotes for the SQL command
   column_properties.name = "name";
   column_properties.data_type = database::DataType::TEXT;
 
@@ -89,10 +100,8 @@ auto food::Food::get_data() const -> database::Data const
   column_properties.constraint = database::Constraint::NOT_NULL;
   data.schema.emplace_back(column_properties);
 
-  std::stringstream quoted_name;
-  quoted_name << "'" << this->name() << "'";
-  row_data = quoted_name.str();
-  new_row.emplace_back(row_data);
+  row_data = std::string(this->name());
+  new_row.row_data.emplace_back(row_data);
 
   // fat, carbohydrate, fiber, and protein columns begin
   // The next 4 columns will all be REAL
@@ -103,24 +112,24 @@ auto food::Food::get_data() const -> database::Data const
   column_properties.name = "fat";
   data.schema.emplace_back(column_properties);
   row_data = macronutrients.fat();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
   column_properties.name = "carbohydrate";
   data.schema.emplace_back(column_properties);
   row_data = macronutrients.carbohydrate();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
   column_properties.name = "fiber";
   data.schema.emplace_back(column_properties);
   row_data = macronutrients.fiber();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
   column_properties.name = "protein";
   data.schema.emplace_back(column_properties);
   row_data = macronutrients.protein();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
-  data.rows.emplace_back(database::Row{new_row});
+  data.rows.emplace_back(std::move(new_row));
 
   return data;
 }
@@ -128,25 +137,40 @@ auto food::Food::get_data() const -> database::Data const
 void food::Food::set_data(std::vector<database::ColumnProperties> const &schema,
                           database::Row const &row)
 {
-  std::unordered_map<std::string_view, database::Row::row_data_t>
-      organized_data;
+  TRACKER_TRACE_SCOPE("food", "Food::set_data");
+
+  // The map lives in an arena on the stack and points into the row, so
+  // decoding a row does not allocate
+  database::StackArena<1024> arena;
+  std::pmr::unordered_map<std::string_view, database::Row::row_data_t const *>
+      organized_data(&arena);
 
-  auto data = row.row_data;
-  for (auto const &[first, second] : ranges::view::zip(schema, data)) {
-    organized_data[first.name] = second;
+  for (auto const &[first, second] : ranges::view::zip(schema, row.row_data)) {
+    organized_data[first.name] = &second;
   }
 
-  this->id_ = std::get<int>(organized_data["Food_id"]);
+  this->id_ = std::get<int>(*organized_data.at("Food_id"));
 
-  this->name_ = std::get<std::string>(organized_data["name"]);
+  // Owned by the object's cache entry when a BoundedCache decodes it
+  this->name_ =
+      database::intern_name(std::get<std::string>(*organized_data.at("name")));
 
-  double const fat = std::get<double>(organized_data["fat"]);
-  double const carbohydrate = std::get<double>(organized_data["carbohydrate"]);
-  double const fiber = std::get<double>(organized_data["fiber"]);
-  double const protein = std::get<double>(organized_data["protein"]);
+  double const fat = std::get<double>(*organized_data.at("fat"));
+  double const carbohydrate =
+      std::get<double>(*organized_data.at("carbohydrate"));
+  double const fiber = std::get<double>(*organized_data.at("fiber"));
+  double const protein = std::get<double>(*organized_data.at("protein"));
 
-  this->macronutrients_ = Macronutrients(
-      Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)), Protein(protein));
+  this->store(Macronutrients(Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)),
+                             Protein(protein)));
+}
+
+void food::Food::store(Macronutrients const &macros)
+{
+  this->fat_ = static_cast<nutrient_t>(macros.fat());
+  this->carbohydrate_ = static_cast<nutrient_t>(macros.carbohydrate());
+  this->fiber_ = static_cast<nutrient_t>(macros.fiber());
+  this->protein_ = static_cast<nutrient_t>(macros.protein());
 }
 
 auto food::Food::str() const -> std::string
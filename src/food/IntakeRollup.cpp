@@ -0,0 +1,195 @@
+/**
+ * @file IntakeRollup.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps the macronutrients eaten per day up to date with the food diary
+ */
+
+#include "food/IntakeRollup.hpp"
+#include "database/utils.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr long long seconds_per_day = 86400;
+
+} // namespace
+
+food::IntakeRollup::IntakeRollup(std::time_t utc_offset)
+    : utc_offset_{utc_offset}
+{
+  namespace utils = database::utils;
+
+  entry_listener_ = utils::Subscription<Entry>(
+      [this](Entry const &entry, utils::Change change) {
+        this->on_entry(entry, change);
+      });
+
+  food_listener_ = utils::Subscription<Food>(
+      [this](Food const &food, utils::Change change) {
+        this->on_food(food, change);
+      });
+
+  this->rebuild();
+}
+
+auto food::IntakeRollup::day_of(std::time_t timestamp) const -> long long
+{
+  long long const local = timestamp + utc_offset_;
+
+  // Round towards negative infinity for days before the epoch
+  long long day = local / seconds_per_day;
+  if (local % seconds_per_day < 0) { --day; }
+  return day;
+}
+
+auto food::IntakeRollup::total(long long first_day, long long last_day) const
+    -> Macronutrients
+{
+  return totals_.total(first_day, last_day);
+}
+
+auto food::IntakeRollup::days() const -> std::vector<long long>
+{
+  std::vector<long long> days;
+  days.reserve(entries_per_day_.size());
+
+  for (auto const &[day, entries] : entries_per_day_) {
+    days.push_back(day);
+  }
+  return days;
+}
+
+auto food::IntakeRollup::has_entries(long long day) const -> bool
+{
+  return entries_per_day_.count(day) > 0;
+}
+
+void food::IntakeRollup::set_listener(Listener listener)
+{
+  listener_ = std::move(listener);
+}
+
+void food::IntakeRollup::rebuild()
+{
+  TRACKER_TRACE_SCOPE("food", "IntakeRollup::rebuild");
+
+  totals_.clear();
+  contributions_.clear();
+  entries_by_food_.clear();
+  entries_per_day_.clear();
+
+  for (auto const &entry : database::utils::retrieve_all<Entry>()) {
+    this->add(entry.id(), this->contribution_of(entry));
+  }
+}
+
+void food::IntakeRollup::on_entry(Entry const &entry,
+                                  database::utils::Change change)
+{
+  std::vector<long long> days;
+  if (auto const day = this->remove(entry.id())) { days.push_back(*day); }
+
+  if (change != database::utils::Change::DELETED) {
+    auto const contribution = this->contribution_of(entry);
+    days.push_back(contribution.day);
+    this->add(entry.id(), contribution);
+  }
+
+  // An entry moved to another day changes both
+  std::sort(begin(days), end(days));
+  days.erase(std::unique(begin(days), end(days)), end(days));
+  if (listener_ && !days.empty()) { listener_(days); }
+}
+
+void food::IntakeRollup::on_food(Food const &food,
+                                 database::utils::Change change)
+{
+  auto found = entries_by_food_.find(food.id());
+  if (found == end(entries_by_food_)) { return; }
+
+  // Ids of deleted foods are reused, an inserted food may already have
+  // entries. A deleted food is still in the cache, so it can't be looked up.
+  Macronutrients per_gram;
+  if (change != database::utils::Change::DELETED) {
+    per_gram = food.macronutrients();
+    per_gram *= 0.01;
+  }
+
+  std::vector<long long> days;
+  days.reserve(found->second.size());
+
+  for (int const entry_id : found->second) {
+    auto &contribution = contributions_.at(entry_id);
+    totals_.subtract(contribution.day, contribution.macros);
+
+    contribution.macros = per_gram;
+    contribution.macros *= contribution.grams;
+    totals_.add(contribution.day, contribution.macros);
+    days.push_back(contribution.day);
+  }
+
+  // A food eaten every day is passed on once per day, not once per entry
+  std::sort(begin(days), end(days));
+  days.erase(std::unique(begin(days), end(days)), end(days));
+  if (listener_) { listener_(days); }
+}
+
+auto food::IntakeRollup::contribution_of(Entry const &entry) const
+    -> Contribution
+{
+  Contribution contribution;
+  contribution.food_id = entry.food_id();
+  contribution.grams = entry.grams();
+  contribution.day = this->day_of(entry.timestamp());
+  contribution.macros = portion(entry.food_id(), entry.grams());
+  return contribution;
+}
+
+void food::IntakeRollup::add(int entry_id, Contribution contribution)
+{
+  totals_.add(contribution.day, contribution.macros);
+  entries_by_food_[contribution.food_id].push_back(entry_id);
+  ++entries_per_day_[contribution.day];
+  contributions_.emplace(entry_id, contribution);
+}
+
+auto food::IntakeRollup::remove(int entry_id) -> std::optional<long long>
+{
+  auto found = contributions_.find(entry_id);
+  if (found == end(contributions_)) { return std::nullopt; }
+
+  auto const contribution = found->second;
+  totals_.subtract(contribution.day, contribution.macros);
+
+  auto const on_day = entries_per_day_.find(contribution.day);
+  if (--on_day->second == 0) { entries_per_day_.erase(on_day); }
+
+  auto &entries = entries_by_food_[contribution.food_id];
+  entries.erase(std::remove(begin(entries), end(entries), entry_id),
+                end(entries));
+  if (entries.empty()) { entries_by_food_.erase(contribution.food_id); }
+
+  contributions_.erase(found);
+  return contribution.day;
+}
+
+auto food::IntakeRollup::portion(int food_id, double grams) -> Macronutrients
+{
+  auto const &all_food = database::utils::retrieve_all<Food>();
+
+  auto const compare = [](Food const &food, int id) { return food.id() < id; };
+  auto found =
+      std::lower_bound(begin(all_food), end(all_food), food_id, compare);
+
+  if (found == end(all_food) || found->id() != food_id) {
+    return Macronutrients();
+  }
+
+  Macronutrients macros = found->macronutrients();
+  macros *= grams / 100;
+  return macros;
+}
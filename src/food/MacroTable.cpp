@@ -0,0 +1,187 @@
+/**
+ * @file MacroTable.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Macronutrients of many foods stored column by column so energy and
+ *        totals can be computed with SIMD loops
+ *
+ * The loops below are written over plain pointers with no branches and use
+ * omp simd to tell the compiler the reductions may be reordered. This file is
+ * compiled with -fopenmp-simd, which only enables the pragmas and does not
+ * link the OpenMP runtime.
+ */
+
+#include "food/MacroTable.hpp"
+
+void food::MacroTable::push_back(int id, Macronutrients const &macros)
+{
+  ids_.push_back(id);
+  fat_.push_back(macros.fat());
+  carbohydrate_.push_back(macros.carbohydrate());
+  fiber_.push_back(macros.fiber());
+  protein_.push_back(macros.protein());
+}
+
+void food::MacroTable::reserve(size_t num_foods)
+{
+  ids_.reserve(num_foods);
+  fat_.reserve(num_foods);
+  carbohydrate_.reserve(num_foods);
+  fiber_.reserve(num_foods);
+  protein_.reserve(num_foods);
+}
+
+auto food::MacroTable::size() const -> size_t
+{
+  return ids_.size();
+}
+
+auto food::MacroTable::macronutrients(size_t row) const -> Macronutrients
+{
+  return Macronutrients(Fat(fat_[row]),
+                        Carbohydrate(carbohydrate_[row], Fiber(fiber_[row])),
+                        Protein(protein_[row]));
+}
+
+auto food::MacroTable::ids() const -> std::vector<int> const &
+{
+  return ids_;
+}
+
+auto food::MacroTable::fat() const -> std::vector<double> const &
+{
+  return fat_;
+}
+
+auto food::MacroTable::carbohydrate() const -> std::vector<double> const &
+{
+  return carbohydrate_;
+}
+
+auto food::MacroTable::fiber() const -> std::vector<double> const &
+{
+  return fiber_;
+}
+
+auto food::MacroTable::protein() const -> std::vector<double> const &
+{
+  return protein_;
+}
+
+auto food::MacroTable::kcal() const -> std::vector<double>
+{
+  std::vector<double> kcal(this->size());
+  this->kcal(kcal.data());
+  return kcal;
+}
+
+void food::MacroTable::kcal(double *out) const
+{
+  size_t const size = this->size();
+  double const *fat = fat_.data();
+  double const *carbohydrate = carbohydrate_.data();
+  double const *fiber = fiber_.data();
+  double const *protein = protein_.data();
+
+  // Fiber is part of carbohydrate, swap its carbohydrate energy for its own
+  constexpr double fiber_adjustment = energy::FIBER - energy::CARBOHYDRATE;
+
+#pragma omp simd
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = energy::FAT * fat[i] + energy::CARBOHYDRATE * carbohydrate[i] +
+             fiber_adjustment * fiber[i] + energy::PROTEIN * protein[i];
+  }
+}
+
+auto food::MacroTable::totals(std::vector<double> const &grams) const
+    -> Macronutrients
+{
+  size_t const size = this->size();
+  double const *portion = grams.data();
+  double const *fat = fat_.data();
+  double const *carbohydrate = carbohydrate_.data();
+  double const *fiber = fiber_.data();
+  double const *protein = protein_.data();
+
+  double total_fat = 0;
+  double total_carbohydrate = 0;
+  double total_fiber = 0;
+  double total_protein = 0;
+
+#pragma omp simd reduction(+ : total_fat, total_carbohydrate, total_fiber,     \
+                           total_protein)
+  for (size_t i = 0; i < size; ++i) {
+    total_fat += portion[i] * fat[i];
+    total_carbohydrate += portion[i] * carbohydrate[i];
+    total_fiber += portion[i] * fiber[i];
+    total_protein += portion[i] * protein[i];
+  }
+
+  // Columns are per 100g of food
+  return Macronutrients(
+      Fat(total_fat / 100),
+      Carbohydrate(total_carbohydrate / 100, Fiber(total_fiber / 100)),
+      Protein(total_protein / 100));
+}
+
+auto food::MacroTable::total_kcal(std::vector<double> const &grams) const
+    -> double
+{
+  size_t const size = this->size();
+  double const *portion = grams.data();
+  double const *fat = fat_.data();
+  double const *carbohydrate = carbohydrate_.data();
+  double const *fiber = fiber_.data();
+  double const *protein = protein_.data();
+
+  constexpr double fiber_adjustment = energy::FIBER - energy::CARBOHYDRATE;
+
+  double total = 0;
+
+#pragma omp simd reduction(+ : total)
+  for (size_t i = 0; i < size; ++i) {
+    total += portion[i] *
+             (energy::FAT * fat[i] + energy::CARBOHYDRATE * carbohydrate[i] +
+              fiber_adjustment * fiber[i] + energy::PROTEIN * protein[i]);
+  }
+
+  return total / 100;
+}
+
+auto food::MacroTable::ratios() const -> MacroRatios
+{
+  size_t const size = this->size();
+
+  MacroRatios ratios;
+  ratios.fat.resize(size);
+  ratios.carbohydrate.resize(size);
+  ratios.protein.resize(size);
+
+  std::vector<double> const energies = this->kcal();
+  double const *kcal = energies.data();
+
+  double *fat_ratio = ratios.fat.data();
+  double *carbohydrate_ratio = ratios.carbohydrate.data();
+  double *protein_ratio = ratios.protein.data();
+  double const *fat = fat_.data();
+  double const *carbohydrate = carbohydrate_.data();
+  double const *fiber = fiber_.data();
+  double const *protein = protein_.data();
+
+  constexpr double fiber_adjustment = energy::FIBER - energy::CARBOHYDRATE;
+
+#pragma omp simd
+  for (size_t i = 0; i < size; ++i) {
+    // Selects instead of a branch around the division so the loop vectorizes
+    double const has_energy = kcal[i] > 0 ? 1.0 : 0.0;
+    double const divisor = kcal[i] > 0 ? kcal[i] : 1.0;
+
+    fat_ratio[i] = energy::FAT * fat[i] * has_energy / divisor;
+    carbohydrate_ratio[i] = (energy::CARBOHYDRATE * carbohydrate[i] +
+                             fiber_adjustment * fiber[i]) *
+                            has_energy / divisor;
+    protein_ratio[i] = energy::PROTEIN * protein[i] * has_energy / divisor;
+  }
+
+  return ratios;
+}
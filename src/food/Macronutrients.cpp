@@ -79,3 +79,38 @@ void food::Macronutrients::set_protein(double protein)
 {
   this->protein_ = protein;
 }
+
+auto food::Macronutrients::kcal() const -> double
+{
+  return energy::FAT * fat_ + energy::CARBOHYDRATE * (carbohydrate_ - fiber_) +
+         energy::FIBER * fiber_ + energy::PROTEIN * protein_;
+}
+
+auto food::Macronutrients::operator+=(Macronutrients const &macros)
+    -> Macronutrients &
+{
+  this->fat_ += macros.fat_;
+  this->carbohydrate_ += macros.carbohydrate_;
+  this->fiber_ += macros.fiber_;
+  this->protein_ += macros.protein_;
+  return *this;
+}
+
+auto food::Macronutrients::operator-=(Macronutrients const &macros)
+    -> Macronutrients &
+{
+  this->fat_ -= macros.fat_;
+  this->carbohydrate_ -= macros.carbohydrate_;
+  this->fiber_ -= macros.fiber_;
+  this->protein_ -= macros.protein_;
+  return *this;
+}
+
+auto food::Macronutrients::operator*=(double scale) -> Macronutrients &
+{
+  this->fat_ *= scale;
+  this->carbohydrate_ *= scale;
+  this->fiber_ *= scale;
+  this->protein_ *= scale;
+  return *this;
+}
@@ -0,0 +1,964 @@
+/**
+ * @file MealPlanner.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Picks foods and amounts from the catalogue that hit macronutrient
+ *        targets
+ *
+ * The amounts are in units of 100g throughout, the unit of the columns of
+ * the table, and only converted to grams in the plan returned.
+ */
+
+#include "food/MealPlanner.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief kcal, fat, carbohydrate, fiber and protein, then the number of foods
+ */
+constexpr size_t num_targets = 5;
+constexpr size_t num_rows = num_targets + 1;
+constexpr size_t foods_row = num_targets;
+
+/**
+ * @brief The cost of going over the number of foods. Only the relaxation of
+ *        a node whose foods can not fit pays it, such nodes are pruned.
+ */
+constexpr double excess_cost = 1e6;
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Smallest amount, reduced cost and pivot the simplex tells from 0
+ */
+constexpr double epsilon = 1e-9;
+
+/**
+ * @brief Pivots without progress before the simplex falls back to Bland's
+ *        rule, which can not cycle
+ */
+constexpr size_t max_degenerate_pivots = 20;
+
+/**
+ * @brief Pivots between two inversions of the basis from scratch, so the
+ *        errors of the updates do not build up
+ */
+constexpr size_t refactor_interval = 50;
+
+using Inverse = std::array<double, num_rows * num_rows>;
+
+/**
+ * @brief How branch and bound fixed a candidate
+ */
+enum class Fixed : char { FREE, OUT, IN };
+
+/**
+ * @brief A relaxation to solve, with the basis to start the simplex from
+ */
+struct Node {
+  /**
+   * @brief The objective of the parent, no plan below the node is better
+   */
+  double bound = 0;
+
+  std::vector<Fixed> fixed;
+  std::array<int, num_rows> basis;
+
+  /**
+   * @brief Whether each nonbasic column is at its upper bound
+   */
+  std::vector<char> at_upper;
+};
+
+/**
+ * @brief Orders the open nodes so the one with the lowest bound is taken
+ *        first
+ */
+struct BestFirst {
+  auto operator()(Node const &a, Node const &b) const -> bool
+  {
+    return a.bound > b.bound;
+  }
+};
+
+/**
+ * @brief The continuous relaxation of the plan over the candidates
+ *
+ * Row r < 5 is target r: the sum of its column over the foods, plus the
+ * shortfall slack, minus the surplus slack, equals the target. Row 5 counts
+ * foods, each food adds its amount over the most it may have and the sum
+ * plus the slack is the most foods allowed. Slack r is column n + 2r for
+ * the shortfall and n + 2r + 1 for the surplus.
+ */
+class Relaxation {
+public:
+  Relaxation(std::vector<double> coefficients, std::array<double, num_rows> rhs,
+             std::array<double, num_rows> weights, double min_amount,
+             double max_amount)
+      : num_foods_{coefficients.size() / num_rows},
+        coefficients_{std::move(coefficients)}, rhs_{rhs},
+        min_amount_{min_amount}, max_amount_{max_amount}
+  {
+    costs_.assign(this->num_columns(), 0);
+    for (size_t row = 0; row < num_targets; ++row) {
+      costs_[num_foods_ + 2 * row] = weights[row];
+      costs_[num_foods_ + 2 * row + 1] = weights[row];
+    }
+    costs_[num_foods_ + 2 * foods_row + 1] = excess_cost;
+  }
+
+  auto num_columns() const -> size_t
+  {
+    return num_foods_ + 2 * num_rows;
+  }
+
+  /**
+   * @return The column of the surplus of row
+   */
+  auto excess(size_t row) const -> size_t
+  {
+    return num_foods_ + 2 * row + 1;
+  }
+
+  /**
+   * @brief A node with every slack basic, which is always feasible
+   */
+  auto root() const -> Node;
+
+  /**
+   * @brief Solves the relaxation of node from its basis, which is left as
+   *        the optimal one
+   * @param amounts Set to the value of every column
+   * @return The objective
+   */
+  auto solve(Node &node, std::vector<double> &amounts) const -> double;
+
+  /**
+   * @return The objective of the amounts of the foods
+   */
+  auto deviation(double const *amounts) const -> double;
+
+private:
+  /**
+   * @brief Writes column to out
+   */
+  void column(size_t column, double *out) const;
+
+  /**
+   * @brief Inverts the basis into inverse
+   * @return false if the basis is singular
+   */
+  auto invert(std::array<int, num_rows> const &basis, Inverse &inverse) const
+      -> bool;
+
+  size_t num_foods_;
+
+  /**
+   * @brief Row r of the foods starts at r * num_foods_
+   */
+  std::vector<double> coefficients_;
+
+  std::array<double, num_rows> rhs_;
+  std::vector<double> costs_;
+  double min_amount_;
+  double max_amount_;
+};
+
+/**
+ * @brief Replaces the column at position of the basis with one whose
+ *        coordinates in the basis are alpha
+ */
+void pivot(Inverse &inverse, size_t position, double const *alpha)
+{
+  double *pivot_row = &inverse[position * num_rows];
+  double const scale = 1 / alpha[position];
+  for (size_t k = 0; k < num_rows; ++k) {
+    pivot_row[k] *= scale;
+  }
+
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (i == position || alpha[i] == 0) { continue; }
+
+    double *row = &inverse[i * num_rows];
+    double const factor = alpha[i];
+    for (size_t k = 0; k < num_rows; ++k) {
+      row[k] -= factor * pivot_row[k];
+    }
+  }
+}
+
+auto Relaxation::root() const -> Node
+{
+  Node node;
+  node.fixed.assign(num_foods_, Fixed::FREE);
+  node.at_upper.assign(this->num_columns(), 0);
+  for (size_t row = 0; row < num_rows; ++row) {
+    node.basis[row] = static_cast<int>(num_foods_ + 2 * row);
+  }
+  return node;
+}
+
+void Relaxation::column(size_t column, double *out) const
+{
+  if (column < num_foods_) {
+    for (size_t row = 0; row < num_rows; ++row) {
+      out[row] = coefficients_[row * num_foods_ + column];
+    }
+    return;
+  }
+
+  size_t const slack = column - num_foods_;
+  std::fill(out, out + num_rows, 0.0);
+  out[slack / 2] = slack % 2 == 0 ? 1 : -1;
+}
+
+auto Relaxation::invert(std::array<int, num_rows> const &basis,
+                        Inverse &inverse) const -> bool
+{
+  // Gauss-Jordan with partial pivoting on [B | I]
+  std::array<double, num_rows * num_rows> matrix;
+  std::array<double, num_rows> values;
+  for (size_t position = 0; position < num_rows; ++position) {
+    this->column(static_cast<size_t>(basis[position]), values.data());
+    for (size_t row = 0; row < num_rows; ++row) {
+      matrix[row * num_rows + position] = values[row];
+    }
+  }
+
+  inverse.fill(0);
+  for (size_t i = 0; i < num_rows; ++i) {
+    inverse[i * num_rows + i] = 1;
+  }
+
+  for (size_t k = 0; k < num_rows; ++k) {
+    size_t best = k;
+    for (size_t i = k + 1; i < num_rows; ++i) {
+      if (std::abs(matrix[i * num_rows + k]) >
+          std::abs(matrix[best * num_rows + k])) {
+        best = i;
+      }
+    }
+    if (std::abs(matrix[best * num_rows + k]) < epsilon) { return false; }
+
+    for (size_t j = 0; j < num_rows; ++j) {
+      std::swap(matrix[k * num_rows + j], matrix[best * num_rows + j]);
+      std::swap(inverse[k * num_rows + j], inverse[best * num_rows + j]);
+    }
+
+    double const scale = 1 / matrix[k * num_rows + k];
+    for (size_t j = 0; j < num_rows; ++j) {
+      matrix[k * num_rows + j] *= scale;
+      inverse[k * num_rows + j] *= scale;
+    }
+
+    for (size_t i = 0; i < num_rows; ++i) {
+      double const factor = matrix[i * num_rows + k];
+      if (i == k || factor == 0) { continue; }
+
+      for (size_t j = 0; j < num_rows; ++j) {
+        matrix[i * num_rows + j] -= factor * matrix[k * num_rows + j];
+        inverse[i * num_rows + j] -= factor * inverse[k * num_rows + j];
+      }
+    }
+  }
+
+  return true;
+}
+
+auto Relaxation::solve(Node &node, std::vector<double> &amounts) const
+    -> double
+{
+  size_t const num_columns = this->num_columns();
+
+  std::vector<double> lower(num_columns, 0);
+  std::vector<double> upper(num_columns, infinity);
+  for (size_t food = 0; food < num_foods_; ++food) {
+    lower[food] = node.fixed[food] == Fixed::IN ? min_amount_ : 0;
+    upper[food] = node.fixed[food] == Fixed::OUT ? 0 : max_amount_;
+  }
+
+  auto &basis = node.basis;
+  auto &at_upper = node.at_upper;
+  std::vector<char> basic(num_columns, 0);
+  Inverse inverse;
+
+  auto const cold_start = [&] {
+    basis = this->root().basis;
+    std::fill(begin(at_upper), end(at_upper), 0);
+    this->invert(basis, inverse);
+  };
+
+  if (!this->invert(basis, inverse)) { cold_start(); }
+
+  // Every nonbasic column sits at one of its bounds, the basic ones make up
+  // the difference to the right hand side
+  auto const solve_basic = [&] {
+    std::fill(begin(basic), end(basic), 0);
+    for (int const column : basis) {
+      basic[column] = 1;
+    }
+
+    std::array<double, num_rows> residual = rhs_;
+    for (size_t column = 0; column < num_columns; ++column) {
+      if (basic[column]) { continue; }
+
+      amounts[column] = at_upper[column] ? upper[column] : lower[column];
+      if (column >= num_foods_ || amounts[column] == 0) { continue; }
+
+      for (size_t row = 0; row < num_rows; ++row) {
+        residual[row] -=
+            coefficients_[row * num_foods_ + column] * amounts[column];
+      }
+    }
+
+    for (size_t i = 0; i < num_rows; ++i) {
+      double value = 0;
+      for (size_t k = 0; k < num_rows; ++k) {
+        value += inverse[i * num_rows + k] * residual[k];
+      }
+      amounts[basis[i]] = value;
+    }
+  };
+
+  amounts.assign(num_columns, 0);
+  solve_basic();
+
+  // The bounds of the node may leave basic foods out of their bounds. Each
+  // one is swapped for a slack at the bound it broke.
+  auto const out_of_bounds = [&] {
+    for (size_t position = 0; position < num_rows; ++position) {
+      size_t const column = basis[position];
+      if (column >= num_foods_) { continue; }
+      if (amounts[column] < lower[column] - epsilon ||
+          amounts[column] > upper[column] + epsilon) {
+        return static_cast<int>(position);
+      }
+    }
+    return -1;
+  };
+
+  std::array<double, num_rows> alpha;
+  for (size_t repair = 0; repair <= num_rows; ++repair) {
+    int const position = out_of_bounds();
+    if (position < 0) { break; }
+
+    // Rows whose slack is basic have a 0 here, the largest entry is safe
+    size_t row = 0;
+    for (size_t k = 1; k < num_rows; ++k) {
+      if (std::abs(inverse[position * num_rows + k]) >
+          std::abs(inverse[position * num_rows + row])) {
+        row = k;
+      }
+    }
+
+    size_t const leaving = basis[position];
+    size_t const entering = num_foods_ + 2 * row;
+    at_upper[leaving] = amounts[leaving] > upper[leaving];
+
+    for (size_t i = 0; i < num_rows; ++i) {
+      alpha[i] = inverse[i * num_rows + row];
+    }
+    pivot(inverse, position, alpha.data());
+    basis[position] = static_cast<int>(entering);
+    solve_basic();
+  }
+
+  if (out_of_bounds() >= 0) {
+    cold_start();
+    solve_basic();
+  }
+
+  // A negative slack trades places with its partner, whose column is the
+  // negative of its own
+  for (size_t position = 0; position < num_rows; ++position) {
+    size_t const column = basis[position];
+    if (column < num_foods_ || amounts[column] >= 0) { continue; }
+
+    size_t const partner = column ^ 1;
+    amounts[partner] = -amounts[column];
+    amounts[column] = 0;
+    basis[position] = static_cast<int>(partner);
+    basic[column] = 0;
+    basic[partner] = 1;
+    for (size_t k = 0; k < num_rows; ++k) {
+      inverse[position * num_rows + k] *= -1;
+    }
+  }
+
+  // Bounded primal simplex
+  size_t const max_iterations = 50 * num_columns;
+  size_t degenerate = 0;
+  size_t since_refactor = 0;
+  std::array<double, num_rows> duals;
+  std::array<double, num_rows> values;
+
+  for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+    if (++since_refactor == refactor_interval) {
+      since_refactor = 0;
+      if (!this->invert(basis, inverse)) { break; }
+      solve_basic();
+    }
+
+    for (size_t k = 0; k < num_rows; ++k) {
+      double dual = 0;
+      for (size_t i = 0; i < num_rows; ++i) {
+        dual += costs_[basis[i]] * inverse[i * num_rows + k];
+      }
+      duals[k] = dual;
+    }
+
+    bool const bland = degenerate >= max_degenerate_pivots;
+    int entering = -1;
+    double direction = 1;
+    double best_score = epsilon;
+
+    for (size_t column = 0; column < num_columns; ++column) {
+      if (basic[column] || upper[column] - lower[column] < epsilon) {
+        continue;
+      }
+
+      double reduced_cost = costs_[column];
+      if (column < num_foods_) {
+        for (size_t row = 0; row < num_rows; ++row) {
+          reduced_cost -=
+              duals[row] * coefficients_[row * num_foods_ + column];
+        }
+      } else {
+        size_t const slack = column - num_foods_;
+        reduced_cost -= slack % 2 == 0 ? duals[slack / 2] : -duals[slack / 2];
+      }
+
+      double const score = at_upper[column] ? reduced_cost : -reduced_cost;
+      if (score > best_score) {
+        entering = static_cast<int>(column);
+        direction = at_upper[column] ? -1 : 1;
+        best_score = score;
+        if (bland) { break; }
+      }
+    }
+
+    if (entering < 0) { break; }
+
+    this->column(entering, values.data());
+    for (size_t i = 0; i < num_rows; ++i) {
+      double value = 0;
+      for (size_t k = 0; k < num_rows; ++k) {
+        value += inverse[i * num_rows + k] * values[k];
+      }
+      alpha[i] = value;
+    }
+
+    // The entering column moves by step, each basic one by -alpha * step
+    double step = upper[entering] - lower[entering];
+    int leaving = -1;
+    for (size_t i = 0; i < num_rows; ++i) {
+      double const rate = direction * alpha[i];
+      size_t const column = basis[i];
+
+      double limit = infinity;
+      if (rate > epsilon) {
+        limit = (amounts[column] - lower[column]) / rate;
+      } else if (rate < -epsilon && upper[column] < infinity) {
+        limit = (upper[column] - amounts[column]) / -rate;
+      }
+
+      limit = std::max(limit, 0.0);
+      if (limit < step) {
+        step = limit;
+        leaving = static_cast<int>(i);
+      }
+    }
+
+    // Costs are never negative, the objective is bounded
+    if (step == infinity) { break; }
+
+    degenerate = step < epsilon ? degenerate + 1 : 0;
+
+    amounts[entering] += direction * step;
+    for (size_t i = 0; i < num_rows; ++i) {
+      amounts[basis[i]] -= direction * step * alpha[i];
+    }
+
+    if (leaving < 0) {
+      at_upper[entering] = direction > 0;
+      amounts[entering] = direction > 0 ? upper[entering] : lower[entering];
+      continue;
+    }
+
+    size_t const column = basis[leaving];
+    at_upper[column] = direction * alpha[leaving] < 0;
+    amounts[column] = at_upper[column] ? upper[column] : lower[column];
+
+    pivot(inverse, static_cast<size_t>(leaving), alpha.data());
+    basis[leaving] = entering;
+    basic[column] = 0;
+    basic[entering] = 1;
+  }
+
+  double objective = 0;
+  for (size_t column = num_foods_; column < num_columns; ++column) {
+    objective += costs_[column] * amounts[column];
+  }
+  return objective;
+}
+
+auto Relaxation::deviation(double const *amounts) const -> double
+{
+  double total_deviation = 0;
+  for (size_t row = 0; row < num_targets; ++row) {
+    double const *coefficients = &coefficients_[row * num_foods_];
+
+    double total = 0;
+    for (size_t food = 0; food < num_foods_; ++food) {
+      total += coefficients[food] * amounts[food];
+    }
+    double const weight = costs_[num_foods_ + 2 * row];
+    total_deviation += weight * std::abs(total - rhs_[row]);
+  }
+  return total_deviation;
+}
+
+/**
+ * @return true if a node bounded by bound may hold a plan that deviates
+ *         less than best, by more than the rounding errors of the simplex
+ */
+auto may_improve(double bound, double best) -> bool
+{
+  if (best == infinity) { return true; }
+  return bound < best - epsilon - 1e-6 * best;
+}
+
+/**
+ * @return The rows with the count highest positive scores, highest first
+ */
+auto top_rows(std::vector<double> const &scores, size_t count)
+    -> std::vector<size_t>
+{
+  using Scored = std::pair<double, size_t>;
+  std::vector<Scored> heap;
+  heap.reserve(count + 1);
+
+  // Min heap of the best so far, most rows lose to its top
+  auto const better = std::greater<Scored>();
+  for (size_t row = 0; row < scores.size(); ++row) {
+    double const score = scores[row];
+    if (score <= 0) { continue; }
+    if (heap.size() == count && score <= heap.front().first) { continue; }
+
+    heap.emplace_back(score, row);
+    std::push_heap(begin(heap), end(heap), better);
+    if (heap.size() > count) {
+      std::pop_heap(begin(heap), end(heap), better);
+      heap.pop_back();
+    }
+  }
+
+  std::sort_heap(begin(heap), end(heap), better);
+
+  std::vector<size_t> rows;
+  rows.reserve(heap.size());
+  for (auto const &[score, row] : heap) {
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+/**
+ * @return The targets as an array in row order
+ */
+auto target_array(food::MacroTargets const &targets)
+    -> std::array<double, num_targets>
+{
+  return {targets.kcal, targets.fat, targets.carbohydrate, targets.fiber,
+          targets.protein};
+}
+
+/**
+ * @brief Branch and bound state shared by every thread
+ */
+struct Search {
+  std::mutex mutex;
+  std::condition_variable changed;
+
+  std::vector<Node> open;
+  size_t active = 0;
+  size_t nodes = 0;
+  bool stopped = false;
+
+  double best = infinity;
+  std::vector<double> best_amounts;
+};
+
+} // namespace
+
+food::MealPlanner::MealPlanner(MacroTable table)
+    : table_{std::move(table)}, kcal_{table_.kcal()}
+{}
+
+auto food::MealPlanner::table() const -> MacroTable const &
+{
+  return table_;
+}
+
+auto food::MealPlanner::candidates(MacroTargets const &targets,
+                                   MealLimits const &limits) const
+    -> std::vector<size_t>
+{
+  TRACKER_TRACE_SCOPE("food", "MealPlanner::candidates");
+
+  auto const target = target_array(targets);
+  std::array<double, num_targets> inverse_target{};
+  size_t num_active = 0;
+  for (size_t row = 0; row < num_targets; ++row) {
+    if (target[row] <= 0) { continue; }
+    inverse_target[row] = 1 / target[row];
+    ++num_active;
+  }
+
+  size_t const size = table_.size();
+  if (num_active == 0 || size == 0 || limits.num_candidates == 0) {
+    return {};
+  }
+
+  std::array<double const *, num_targets> const columns = {
+      kcal_.data(), table_.fat().data(), table_.carbohydrate().data(),
+      table_.fiber().data(), table_.protein().data()};
+
+  // A food measured against the targets is a vector with one component per
+  // target. A food in the proportions of the targets points the same way as
+  // a vector of ones, so its cosine with it is 1.
+  std::vector<double> norms(size, 0.0);
+  std::vector<double> similarity(size, 0.0);
+  {
+    double *norm = norms.data();
+    double *cosine = similarity.data();
+
+    for (size_t row = 0; row < num_targets; ++row) {
+      double const *column = columns[row];
+      double const scale = inverse_target[row];
+
+#pragma omp simd
+      for (size_t i = 0; i < size; ++i) {
+        double const component = column[i] * scale;
+        norm[i] += component * component;
+        cosine[i] += component;
+      }
+    }
+
+    double const ones_norm = std::sqrt(static_cast<double>(num_active));
+
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      // Selects instead of a branch around the division so the loop
+      // vectorizes
+      double const length = std::sqrt(norm[i]);
+      norm[i] = length > 0 ? length : 1.0;
+      cosine[i] = cosine[i] / (norm[i] * ones_norm);
+    }
+  }
+
+  std::vector<int> excluded = limits.excluded_foods;
+  std::sort(begin(excluded), end(excluded));
+  auto const &ids = table_.ids();
+  auto const is_excluded = [&](size_t row) {
+    return std::binary_search(begin(excluded), end(excluded), ids[row]);
+  };
+
+  std::vector<size_t> picked;
+  auto const pick = [&](std::vector<size_t> const &rows, size_t count) {
+    for (size_t row : rows) {
+      if (count == 0 || picked.size() == limits.num_candidates) { return; }
+      if (is_excluded(row) ||
+          std::find(begin(picked), end(picked), row) != end(picked)) {
+        continue;
+      }
+      picked.push_back(row);
+      --count;
+    }
+  };
+
+  // The purest sources of each target, to correct the totals with
+  size_t const per_target =
+      std::max<size_t>(1, limits.num_candidates / (2 * num_active));
+  std::vector<double> purity(size);
+  for (size_t row = 0; row < num_targets; ++row) {
+    if (inverse_target[row] == 0) { continue; }
+
+    double const *column = columns[row];
+    double const scale = inverse_target[row];
+    double const *norm = norms.data();
+    double *out = purity.data();
+
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = column[i] * scale / norm[i];
+    }
+
+    pick(top_rows(purity, per_target + excluded.size()), per_target);
+  }
+
+  pick(top_rows(similarity, limits.num_candidates + excluded.size()),
+       limits.num_candidates);
+
+  std::sort(begin(picked), end(picked));
+  return picked;
+}
+
+auto food::MealPlanner::plan(MacroTargets const &targets,
+                             MealLimits const &limits) const -> MealPlan
+{
+  TRACKER_TRACE_SCOPE("food", "MealPlanner::plan");
+
+  MealPlan plan;
+
+  auto const rows = this->candidates(targets, limits);
+  size_t const max_foods = std::min(limits.max_foods, rows.size());
+  if (rows.empty() || max_foods == 0 || limits.max_grams <= 0 ||
+      limits.min_grams > limits.max_grams) {
+    return plan;
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+  auto const target = target_array(targets);
+
+  double const min_amount = std::max(limits.min_grams, 0.0) / 100;
+  double const max_amount = limits.max_grams / 100;
+
+  // The columns of the candidates, row by row, in units of 100g
+  size_t const num_foods = rows.size();
+  std::array<double const *, num_targets> const columns = {
+      kcal_.data(), table_.fat().data(), table_.carbohydrate().data(),
+      table_.fiber().data(), table_.protein().data()};
+
+  std::vector<double> coefficients(num_rows * num_foods);
+  for (size_t row = 0; row < num_targets; ++row) {
+    for (size_t food = 0; food < num_foods; ++food) {
+      coefficients[row * num_foods + food] = columns[row][rows[food]];
+    }
+  }
+  std::fill(begin(coefficients) + foods_row * num_foods, end(coefficients),
+            1 / max_amount);
+
+  std::array<double, num_rows> rhs{};
+  std::array<double, num_rows> weights{};
+  for (size_t row = 0; row < num_targets; ++row) {
+    if (target[row] <= 0) { continue; }
+    rhs[row] = target[row];
+    weights[row] = 1 / target[row];
+  }
+  rhs[foods_row] = static_cast<double>(max_foods);
+
+  Relaxation const relaxation(std::move(coefficients), rhs, weights,
+                              min_amount, max_amount);
+
+  // Checks a plan against the tolerances from its deviation alone would let
+  // one target make up for another
+  auto const within_tolerance = [&](double const *amounts) {
+    for (size_t row = 0; row < num_targets; ++row) {
+      if (target[row] <= 0) { continue; }
+
+      double total = 0;
+      for (size_t food = 0; food < num_foods; ++food) {
+        total += columns[row][rows[food]] * amounts[food];
+      }
+      if (std::abs(total - target[row]) >
+          targets.tolerance * target[row] + epsilon) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  Search search;
+  search.open.push_back(relaxation.root());
+
+  // Offers a plan to the search, under its lock
+  auto const offer = [&](std::vector<double> const &amounts) {
+    double const deviation = relaxation.deviation(amounts.data());
+    if (deviation >= search.best) { return; }
+
+    search.best = deviation;
+    search.best_amounts.assign(begin(amounts), begin(amounts) + num_foods);
+    if (limits.first_within_tolerance &&
+        within_tolerance(search.best_amounts.data())) {
+      search.stopped = true;
+    }
+  };
+
+  auto const worker = [&] {
+    std::vector<double> amounts;
+    std::vector<double> rounded(num_foods);
+    std::vector<size_t> order(num_foods);
+    std::vector<Node> children;
+
+    std::unique_lock<std::mutex> lock(search.mutex);
+    while (true) {
+      search.changed.wait(lock, [&] {
+        return search.stopped || !search.open.empty() || search.active == 0;
+      });
+      if (search.stopped || search.open.empty()) { break; }
+
+      std::pop_heap(begin(search.open), end(search.open), BestFirst());
+      Node node = std::move(search.open.back());
+      search.open.pop_back();
+
+      double const best = search.best;
+      if (!may_improve(node.bound, best)) { continue; }
+
+      ++search.active;
+      lock.unlock();
+
+      children.clear();
+      bool feasible = false;
+      double const objective = relaxation.solve(node, amounts);
+      bool const fits =
+          amounts[relaxation.excess(foods_row)] <= epsilon;
+
+      if (fits && may_improve(objective, best)) {
+        // A food below the least grams, or one too many foods
+        size_t num_in = 0;
+        size_t num_positive = 0;
+        int branch = -1;
+        double branch_score = -1;
+        for (size_t food = 0; food < num_foods; ++food) {
+          if (node.fixed[food] == Fixed::IN) { ++num_in; }
+          if (amounts[food] <= epsilon) { continue; }
+          ++num_positive;
+
+          if (node.fixed[food] == Fixed::FREE &&
+              amounts[food] < min_amount - epsilon) {
+            // Closest to halfway is the least decided
+            double const half = std::min(amounts[food],
+                                         min_amount - amounts[food]);
+            if (half > branch_score) {
+              branch = static_cast<int>(food);
+              branch_score = half;
+            }
+          }
+        }
+
+        if (branch < 0 && num_positive > max_foods) {
+          double smallest = infinity;
+          for (size_t food = 0; food < num_foods; ++food) {
+            if (node.fixed[food] != Fixed::FREE ||
+                amounts[food] <= epsilon || amounts[food] >= smallest) {
+              continue;
+            }
+            branch = static_cast<int>(food);
+            smallest = amounts[food];
+          }
+        }
+
+        if (branch < 0) {
+          feasible = true;
+        } else {
+          Node out = node;
+          out.bound = objective;
+          out.fixed[branch] = Fixed::OUT;
+          children.push_back(std::move(out));
+
+          if (num_in < max_foods) {
+            Node in = std::move(node);
+            in.bound = objective;
+            in.fixed[branch] = Fixed::IN;
+            if (num_in + 1 == max_foods) {
+              for (auto &fixed : in.fixed) {
+                if (fixed == Fixed::FREE) { fixed = Fixed::OUT; }
+              }
+            }
+            children.push_back(std::move(in));
+          }
+
+          // Rounds to the largest foods for a plan to prune with early on
+          std::iota(begin(order), end(order), 0);
+          std::sort(begin(order), end(order), [&](size_t a, size_t b) {
+            return amounts[a] > amounts[b];
+          });
+          std::fill(begin(rounded), end(rounded), 0.0);
+          for (size_t i = 0; i < max_foods; ++i) {
+            size_t const food = order[i];
+            if (amounts[food] <= epsilon) { break; }
+            rounded[food] =
+                std::clamp(amounts[food], min_amount, max_amount);
+          }
+        }
+      }
+
+      lock.lock();
+      --search.active;
+      ++search.nodes;
+
+      if (feasible) {
+        offer(amounts);
+      } else if (!children.empty()) {
+        offer(rounded);
+      }
+
+      for (auto &child : children) {
+        search.open.push_back(std::move(child));
+        std::push_heap(begin(search.open), end(search.open), BestFirst());
+      }
+
+      if (search.nodes >= limits.max_nodes ||
+          std::chrono::steady_clock::now() - start >= limits.time_limit) {
+        search.stopped = true;
+      }
+      search.changed.notify_all();
+    }
+
+    search.changed.notify_all();
+  };
+
+  size_t num_threads = limits.num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  plan.nodes = search.nodes;
+  plan.optimal = search.open.empty() && !search.stopped;
+  if (search.best_amounts.empty()) { return plan; }
+
+  for (size_t food = 0; food < num_foods; ++food) {
+    double const amount = search.best_amounts[food];
+    if (amount <= epsilon) { continue; }
+
+    size_t const row = rows[food];
+    plan.portions.push_back({table_.ids()[row], amount * 100});
+
+    Macronutrients portion = table_.macronutrients(row);
+    portion *= amount;
+    plan.macronutrients += portion;
+    plan.kcal += kcal_[row] * amount;
+  }
+
+  std::sort(begin(plan.portions), end(plan.portions),
+            [](Portion const &a, Portion const &b) {
+              return a.food_id < b.food_id;
+            });
+
+  plan.deviation = search.best;
+  plan.within_tolerance = within_tolerance(search.best_amounts.data());
+  return plan;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file MicronutrientMatrix.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Vitamins, minerals and amino acids of many foods stored as a sparse
+ *        matrix, with the totals of a day computed in one product
+ *
+ * The row loop uses omp simd for a scatter: the compiler can not prove the
+ * nutrients of a row are distinct, push_back guarantees it. Compiled with
+ * -fopenmp-simd like MacroTable.cpp.
+ */
+
+#include "food/MicronutrientMatrix.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+food::MicronutrientMatrix::MicronutrientMatrix(size_t num_nutrients)
+    : num_nutrients_{num_nutrients}
+{}
+
+void food::MicronutrientMatrix::push_back(int id,
+                                          std::vector<NutrientAmount> amounts)
+{
+  if (!ids_.empty() && id <= ids_.back()) {
+    throw std::runtime_error("Foods must be added in increasing id order");
+  }
+
+  auto const by_nutrient = [](NutrientAmount const &a,
+                              NutrientAmount const &b) {
+    return a.nutrient < b.nutrient;
+  };
+  std::sort(begin(amounts), end(amounts), by_nutrient);
+
+  if (!amounts.empty() && amounts.back().nutrient >= num_nutrients_) {
+    throw std::runtime_error("Nutrient is not a column of the matrix");
+  }
+
+  if (nutrients_.size() + amounts.size() >
+      std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Too many amounts for the row offsets");
+  }
+
+  // A nutrient listed twice is stored once, with the sum of its amounts
+  for (size_t i = 0; i < amounts.size();) {
+    uint32_t const nutrient = amounts[i].nutrient;
+    float amount = 0;
+    for (; i < amounts.size() && amounts[i].nutrient == nutrient; ++i) {
+      amount += amounts[i].amount;
+    }
+
+    if (amount == 0) { continue; }
+    nutrients_.push_back(nutrient);
+    amounts_.push_back(amount);
+  }
+
+  ids_.push_back(id);
+  row_offsets_.push_back(static_cast<uint32_t>(nutrients_.size()));
+}
+
+void food::MicronutrientMatrix::reserve(size_t num_foods, size_t num_amounts)
+{
+  ids_.reserve(num_foods);
+  row_offsets_.reserve(num_foods + 1);
+  nutrients_.reserve(num_amounts);
+  amounts_.reserve(num_amounts);
+}
+
+auto food::MicronutrientMatrix::size() const -> size_t
+{
+  return ids_.size();
+}
+
+auto food::MicronutrientMatrix::num_nutrients() const -> size_t
+{
+  return num_nutrients_;
+}
+
+auto food::MicronutrientMatrix::num_amounts() const -> size_t
+{
+  return amounts_.size();
+}
+
+auto food::MicronutrientMatrix::row(int id) const -> size_t
+{
+  auto const found = std::lower_bound(begin(ids_), end(ids_), id);
+  if (found == end(ids_) || *found != id) { return this->size(); }
+
+  return static_cast<size_t>(found - begin(ids_));
+}
+
+auto food::MicronutrientMatrix::amount(int id, uint32_t nutrient) const
+    -> float
+{
+  size_t const row = this->row(id);
+  if (row == this->size()) { return 0; }
+
+  // The nutrients of a row are sorted
+  auto const first = begin(nutrients_) + row_offsets_[row];
+  auto const last = begin(nutrients_) + row_offsets_[row + 1];
+  auto const found = std::lower_bound(first, last, nutrient);
+  if (found == last || *found != nutrient) { return 0; }
+
+  return amounts_[static_cast<size_t>(found - begin(nutrients_))];
+}
+
+auto food::MicronutrientMatrix::ids() const -> std::vector<int> const &
+{
+  return ids_;
+}
+
+auto food::MicronutrientMatrix::row_offsets() const
+    -> std::vector<uint32_t> const &
+{
+  return row_offsets_;
+}
+
+auto food::MicronutrientMatrix::nutrients() const
+    -> std::vector<uint32_t> const &
+{
+  return nutrients_;
+}
+
+auto food::MicronutrientMatrix::amounts() const -> std::vector<float> const &
+{
+  return amounts_;
+}
+
+auto food::MicronutrientMatrix::totals(std::vector<double> const &grams) const
+    -> std::vector<double>
+{
+  std::vector<double> totals(num_nutrients_);
+
+  size_t const size = this->size();
+  double const *portion = grams.data();
+  for (size_t row = 0; row < size; ++row) {
+    if (portion[row] == 0) { continue; }
+    this->accumulate(row, portion[row], totals.data());
+  }
+
+  return totals;
+}
+
+auto food::MicronutrientMatrix::totals(
+    std::vector<Portion> const &portions) const -> std::vector<double>
+{
+  std::vector<double> totals(num_nutrients_);
+
+  for (auto const &portion : portions) {
+    size_t const row = this->row(portion.food_id);
+    if (row == this->size()) { continue; }
+    this->accumulate(row, portion.grams, totals.data());
+  }
+
+  return totals;
+}
+
+void food::MicronutrientMatrix::accumulate(size_t row, double grams,
+                                           double *totals) const
+{
+  uint32_t const first = row_offsets_[row];
+  uint32_t const last = row_offsets_[row + 1];
+  uint32_t const *nutrient = nutrients_.data();
+  float const *amount = amounts_.data();
+
+  // Amounts are per 100g of food
+  double const scale = grams / 100;
+
+#pragma omp simd
+  for (uint32_t i = first; i < last; ++i) {
+    totals[nutrient[i]] += scale * amount[i];
+  }
+}
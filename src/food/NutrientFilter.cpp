@@ -0,0 +1,53 @@
+/**
+ * @file NutrientFilter.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Filters the foods by nutrient ranges, kept up to date with the food
+ *        table
+ */
+
+#include "food/NutrientFilter.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+
+food::NutrientFilter::NutrientFilter()
+{
+  namespace utils = database::utils;
+
+  food_listener_ = utils::Subscription<Food>(
+      [this](Food const &food, utils::Change change) {
+        this->on_food(food, change);
+      });
+
+  this->rebuild();
+}
+
+auto food::NutrientFilter::filter(
+    std::vector<NutrientRange> const &ranges) const -> std::vector<int>
+{
+  TRACKER_TRACE_SCOPE("food", "NutrientFilter::filter");
+
+  // Sorted like the Food cache so the ids can be looked up with lower_bound
+  auto food_ids = index_.filter(ranges);
+  std::sort(begin(food_ids), end(food_ids));
+  return food_ids;
+}
+
+void food::NutrientFilter::rebuild()
+{
+  TRACKER_TRACE_SCOPE("food", "NutrientFilter::rebuild");
+
+  index_ = NutrientIndex::from(database::utils::retrieve_all<Food>());
+}
+
+void food::NutrientFilter::on_food(Food const &food,
+                                   database::utils::Change change)
+{
+  if (change == database::utils::Change::DELETED) {
+    index_.erase(food.id());
+    return;
+  }
+
+  index_.insert(food.id(), food.macronutrients());
+}
@@ -0,0 +1,422 @@
+/**
+ * @file NutrientIndex.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Finds the foods whose nutrients fall in ranges, e.g. protein of at
+ *        least 25g and fat of at most 5g per 100g
+ */
+
+#include "food/NutrientIndex.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Bins have at least min_bin_rows rows when the index is built,
+ *        unless there are max_bins of them
+ */
+constexpr size_t max_bins = 256;
+constexpr size_t min_bin_rows = 64;
+
+/**
+ * @brief The quantiles are taken from at most this many values
+ */
+constexpr size_t max_samples = 32 * max_bins;
+
+/**
+ * @brief The index is not built again before it has this many rows
+ */
+constexpr size_t min_rebuild_rows = 64;
+
+/**
+ * @brief Rows of a range covering at most 1 in this many rows are checked
+ *        one by one instead of turned into a bitmap
+ */
+constexpr size_t rows_per_checked_row = 256;
+
+/**
+ * @brief Checking a row reads a cache line of a column, marking one reads 4
+ *        bytes of its bin and writes to a bitmap that stays in cache. This
+ *        is about how many rows can be marked for the cost of checking one.
+ */
+constexpr size_t marked_rows_per_checked_row = 8;
+
+auto is_set(std::vector<uint64_t> const &bits, size_t row) -> bool
+{
+  return (bits[row / 64] >> (row % 64)) & 1;
+}
+
+void set(std::vector<uint64_t> &bits, size_t row)
+{
+  if (row % 64 == 0) { bits.push_back(0); }
+  bits[row / 64] |= uint64_t{1} << (row % 64);
+}
+
+/**
+ * @brief Bit tricks that do not need a popcount instruction, which is not
+ *        there without -mpopcnt and is a function call per word instead
+ */
+auto popcount(uint64_t word) -> size_t
+{
+  word -= (word >> 1) & 0x5555555555555555;
+  word = (word & 0x3333333333333333) + ((word >> 2) & 0x3333333333333333);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0f;
+  return static_cast<size_t>((word * 0x0101010101010101) >> 56);
+}
+
+constexpr uint64_t de_bruijn = 0x03f79d71b4cb0a89;
+
+/**
+ * @brief The position of a bit by the top 6 bits of the bit times de_bruijn,
+ *        which differ for every bit
+ */
+constexpr auto bit_positions = [] {
+  std::array<uint8_t, 64> positions{};
+  for (size_t bit = 0; bit < 64; ++bit) {
+    positions[((uint64_t{1} << bit) * de_bruijn) >> 58] =
+        static_cast<uint8_t>(bit);
+  }
+  return positions;
+}();
+
+/**
+ * @return The position of the lowest set bit of a word that is not 0
+ */
+auto lowest_bit(uint64_t word) -> size_t
+{
+  return bit_positions[((word & (~word + 1)) * de_bruijn) >> 58];
+}
+
+auto count(std::vector<uint64_t> const &bits) -> size_t
+{
+  size_t total = 0;
+  for (uint64_t const word : bits) {
+    total += popcount(word);
+  }
+  return total;
+}
+
+/**
+ * @return The bin a value goes in, given the lowest value of every bin
+ */
+auto bin_of(std::vector<double> const &lowest, double value) -> size_t
+{
+  auto const above = std::upper_bound(begin(lowest), end(lowest), value);
+  return static_cast<size_t>(above - begin(lowest)) - 1;
+}
+
+} // namespace
+
+void food::NutrientIndex::build(std::vector<int> const &food_ids,
+                                std::vector<Macronutrients> const &macros)
+{
+  TRACKER_TRACE_SCOPE("food", "NutrientIndex::build");
+
+  this->clear();
+
+  food_ids_.reserve(food_ids.size());
+  for (auto &column : columns_) {
+    column.reserve(food_ids.size());
+  }
+  rows_.reserve(food_ids.size());
+
+  for (size_t i = 0; i < food_ids.size(); ++i) {
+    this->append(food_ids[i], macros[i]);
+  }
+
+  this->rebuild();
+}
+
+void food::NutrientIndex::append(int food_id, Macronutrients const &macros)
+{
+  auto const row = static_cast<uint32_t>(food_ids_.size());
+
+  food_ids_.push_back(food_id);
+  columns_[static_cast<size_t>(Nutrient::FAT)].push_back(macros.fat());
+  columns_[static_cast<size_t>(Nutrient::CARBOHYDRATE)].push_back(
+      macros.carbohydrate());
+  columns_[static_cast<size_t>(Nutrient::FIBER)].push_back(macros.fiber());
+  columns_[static_cast<size_t>(Nutrient::PROTEIN)].push_back(macros.protein());
+  columns_[static_cast<size_t>(Nutrient::KCAL)].push_back(macros.kcal());
+
+  // The row is the last one, the rows of every bin stay in order
+  for (size_t nutrient = 0; nutrient < num_nutrients; ++nutrient) {
+    auto &bins = bins_[nutrient];
+    if (bins.lowest.empty()) {
+      bins.lowest.push_back(-infinity);
+      bins.rows.emplace_back();
+    }
+    bins.rows[bin_of(bins.lowest, columns_[nutrient].back())].push_back(row);
+  }
+
+  set(alive_, row);
+  rows_[food_id] = row;
+}
+
+void food::NutrientIndex::kill(uint32_t row)
+{
+  alive_[row / 64] &= ~(uint64_t{1} << (row % 64));
+  ++num_dead_;
+}
+
+void food::NutrientIndex::insert(int food_id, Macronutrients const &macros)
+{
+  auto const found = rows_.find(food_id);
+  if (found != end(rows_)) { this->kill(found->second); }
+
+  this->append(food_id, macros);
+
+  // Quantiles taken from fewer rows than there are now may leave most rows
+  // in a few bins
+  size_t const num_rows = food_ids_.size();
+  if (num_dead_ * 2 > num_rows ||
+      num_rows > std::max(2 * num_built_, min_rebuild_rows)) {
+    this->rebuild();
+  }
+}
+
+auto food::NutrientIndex::erase(int food_id) -> bool
+{
+  auto const found = rows_.find(food_id);
+  if (found == end(rows_)) { return false; }
+
+  this->kill(found->second);
+  rows_.erase(found);
+
+  if (num_dead_ * 2 > food_ids_.size()) { this->rebuild(); }
+
+  return true;
+}
+
+void food::NutrientIndex::rebuild()
+{
+  TRACKER_TRACE_SCOPE("food", "NutrientIndex::rebuild");
+
+  if (num_dead_ > 0) {
+    Bitmap alive;
+    size_t kept = 0;
+    for (size_t row = 0; row < food_ids_.size(); ++row) {
+      if (!is_set(alive_, row)) { continue; }
+
+      food_ids_[kept] = food_ids_[row];
+      for (auto &column : columns_) {
+        column[kept] = column[row];
+      }
+      rows_[food_ids_[kept]] = static_cast<uint32_t>(kept);
+      set(alive, kept);
+      ++kept;
+    }
+
+    food_ids_.resize(kept);
+    for (auto &column : columns_) {
+      column.resize(kept);
+    }
+    alive_ = std::move(alive);
+    num_dead_ = 0;
+  }
+
+  num_built_ = food_ids_.size();
+  size_t const num_bins =
+      std::clamp(num_built_ / min_bin_rows, size_t{1}, max_bins);
+  size_t const step = std::max(size_t{1}, num_built_ / max_samples);
+
+  std::vector<double> samples;
+  for (size_t nutrient = 0; nutrient < num_nutrients; ++nutrient) {
+    auto const &column = columns_[nutrient];
+
+    samples.clear();
+    for (size_t row = 0; row < column.size(); row += step) {
+      samples.push_back(column[row]);
+    }
+    std::sort(begin(samples), end(samples));
+
+    // Many foods share a value such as 0g of fiber, they all go in one bin
+    Bins bins;
+    bins.lowest.push_back(-infinity);
+    for (size_t bin = 1; bin < num_bins; ++bin) {
+      double const lowest = samples[bin * samples.size() / num_bins];
+      if (lowest > bins.lowest.back()) { bins.lowest.push_back(lowest); }
+    }
+
+    bins.rows.resize(bins.lowest.size());
+    for (auto &rows : bins.rows) {
+      rows.reserve(2 * num_built_ / bins.lowest.size());
+    }
+    for (size_t row = 0; row < column.size(); ++row) {
+      bins.rows[bin_of(bins.lowest, column[row])].push_back(
+          static_cast<uint32_t>(row));
+    }
+
+    bins_[nutrient] = std::move(bins);
+  }
+}
+
+auto food::NutrientIndex::cover(NutrientRange const &range) const -> Cover
+{
+  auto const &bins = bins_[static_cast<size_t>(range.nutrient)];
+
+  // A first bin after the last one covers nothing
+  if (bins.lowest.empty() || !(range.min <= range.max)) {
+    return {range, 1, 0, 0};
+  }
+
+  Cover cover{range, bin_of(bins.lowest, range.min),
+              bin_of(bins.lowest, range.max), 0};
+  for (size_t bin = cover.first; bin <= cover.last; ++bin) {
+    cover.num_rows += bins.rows[bin].size();
+  }
+  return cover;
+}
+
+auto food::NutrientIndex::covers(Cover const &cover, size_t bin) const -> bool
+{
+  auto const &lowest = bins_[static_cast<size_t>(cover.range.nutrient)].lowest;
+
+  // Bins before the last one only hold values below its lowest
+  return (bin > cover.first || lowest[bin] >= cover.range.min) &&
+         (bin < cover.last || cover.range.max == infinity);
+}
+
+auto food::NutrientIndex::within(uint32_t row, NutrientRange const &range) const
+    -> bool
+{
+  double const value = columns_[static_cast<size_t>(range.nutrient)][row];
+  return value >= range.min && value <= range.max;
+}
+
+void food::NutrientIndex::mark(Cover const &cover, bool complement,
+                               Bitmap &rows) const
+{
+  auto const &bins = bins_[static_cast<size_t>(cover.range.nutrient)];
+  uint64_t *bits = rows.data();
+
+  for (size_t bin = 0; bin < bins.rows.size(); ++bin) {
+    uint32_t const *bin_rows = bins.rows[bin].data();
+    size_t const size = bins.rows[bin].size();
+
+    bool const in_cover = bin >= cover.first && bin <= cover.last;
+    if (in_cover && !this->covers(cover, bin)) {
+      for (size_t i = 0; i < size; ++i) {
+        if (this->within(bin_rows[i], cover.range) != complement) {
+          bits[bin_rows[i] / 64] |= uint64_t{1} << (bin_rows[i] % 64);
+        }
+      }
+    } else if (in_cover != complement) {
+      for (size_t i = 0; i < size; ++i) {
+        bits[bin_rows[i] / 64] |= uint64_t{1} << (bin_rows[i] % 64);
+      }
+    }
+  }
+}
+
+auto food::NutrientIndex::filter(std::vector<NutrientRange> const &ranges) const
+    -> std::vector<int>
+{
+  TRACKER_TRACE_SCOPE("food", "NutrientIndex::filter");
+
+  std::vector<int> food_ids;
+  size_t const num_rows = food_ids_.size();
+
+  if (ranges.empty()) {
+    food_ids.reserve(this->size());
+    for (size_t row = 0; row < num_rows; ++row) {
+      if (is_set(alive_, row)) { food_ids.push_back(food_ids_[row]); }
+    }
+    return food_ids;
+  }
+
+  std::vector<Cover> covers;
+  covers.reserve(ranges.size());
+  for (auto const &range : ranges) {
+    covers.push_back(this->cover(range));
+  }
+  std::sort(begin(covers), end(covers), [](auto const &a, auto const &b) {
+    return a.num_rows < b.num_rows;
+  });
+
+  auto const &fewest = covers.front();
+
+  if (fewest.num_rows * rows_per_checked_row <= num_rows) {
+    auto const &bins = bins_[static_cast<size_t>(fewest.range.nutrient)];
+    for (size_t bin = fewest.first; bin <= fewest.last; ++bin) {
+      for (uint32_t const row : bins.rows[bin]) {
+        bool const matches =
+            is_set(alive_, row) &&
+            std::all_of(begin(ranges), end(ranges), [&](auto const &range) {
+              return this->within(row, range);
+            });
+        if (matches) { food_ids.push_back(food_ids_[row]); }
+      }
+    }
+    return food_ids;
+  }
+
+  size_t const num_words = alive_.size();
+
+  Bitmap rows(num_words, 0);
+  this->mark(fewest, false, rows);
+  for (size_t word = 0; word < num_words; ++word) {
+    rows[word] &= alive_[word];
+  }
+
+  // A range is ANDed in if marking it costs less than checking the rows
+  // left for it, marking the rows outside it if there are fewer of those
+  Bitmap other(num_words);
+  std::vector<NutrientRange> unchecked;
+  size_t candidates = count(rows);
+  for (size_t i = 1; i < covers.size(); ++i) {
+    size_t const inside = covers[i].num_rows;
+    size_t const outside = num_rows - inside;
+
+    if (std::min(inside, outside) >= candidates * marked_rows_per_checked_row) {
+      unchecked.push_back(covers[i].range);
+      continue;
+    }
+
+    std::fill(begin(other), end(other), 0);
+    this->mark(covers[i], outside < inside, other);
+    for (size_t word = 0; word < num_words; ++word) {
+      rows[word] &= outside < inside ? ~other[word] : other[word];
+    }
+    candidates = count(rows);
+  }
+
+  for (size_t word = 0; word < num_words; ++word) {
+    for (uint64_t bits = rows[word]; bits != 0; bits &= bits - 1) {
+      auto const row = static_cast<uint32_t>(word * 64 + lowest_bit(bits));
+
+      bool const matches =
+          std::all_of(begin(unchecked), end(unchecked), [&](auto const &range) {
+            return this->within(row, range);
+          });
+      if (matches) { food_ids.push_back(food_ids_[row]); }
+    }
+  }
+
+  return food_ids;
+}
+
+auto food::NutrientIndex::size() const -> size_t
+{
+  return rows_.size();
+}
+
+void food::NutrientIndex::clear()
+{
+  food_ids_.clear();
+  for (auto &column : columns_) {
+    column.clear();
+  }
+  for (auto &bins : bins_) {
+    bins = Bins();
+  }
+  alive_.clear();
+  num_dead_ = 0;
+  num_built_ = 0;
+  rows_.clear();
+}
@@ -0,0 +1,382 @@
+/**
+ * @file ProfileTree.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A k-d tree over the macronutrient profiles of foods, for finding
+ *        the foods most alike
+ */
+
+#include "food/ProfileTree.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+constexpr size_t num_axes = 4;
+
+/**
+ * @brief The most profiles a leaf holds before it splits
+ */
+constexpr size_t bucket_capacity = 64;
+
+} // namespace
+
+auto food::profile(Macronutrients const &macros) -> Profile
+{
+  double const fat = macros.fat();
+  double const sugar_and_starch = macros.carbohydrate() - macros.fiber();
+  double const fiber = macros.fiber();
+  double const protein = macros.protein();
+
+  double const total = fat + sugar_and_starch + fiber + protein;
+  if (total <= 0) { return {}; }
+
+  return {static_cast<float>(fat / total),
+          static_cast<float>(sugar_and_starch / total),
+          static_cast<float>(fiber / total),
+          static_cast<float>(protein / total)};
+}
+
+void food::ProfileTree::build(std::vector<int> const &food_ids,
+                              std::vector<Profile> const &profiles)
+{
+  TRACKER_TRACE_SCOPE("food", "ProfileTree::build");
+
+  this->clear();
+
+  std::vector<std::pair<int, Profile>> entries;
+  entries.reserve(food_ids.size());
+  for (size_t i = 0; i < food_ids.size(); ++i) {
+    entries.emplace_back(food_ids[i], profiles[i]);
+  }
+
+  locations_.reserve(entries.size());
+  this->build(entries, 0, entries.size());
+}
+
+auto food::ProfileTree::build(std::vector<std::pair<int, Profile>> &entries,
+                              size_t first, size_t last) -> int
+{
+  // Reserved before the children are built, the root ends up at 0
+  int const node = static_cast<int>(nodes_.size());
+  nodes_.emplace_back();
+
+  Profile lowest;
+  Profile highest;
+  lowest.fill(1);
+  highest.fill(0);
+  for (size_t i = first; i < last; ++i) {
+    for (size_t axis = 0; axis < num_axes; ++axis) {
+      lowest[axis] = std::min(lowest[axis], entries[i].second[axis]);
+      highest[axis] = std::max(highest[axis], entries[i].second[axis]);
+    }
+  }
+
+  size_t axis = 0;
+  for (size_t candidate = 1; candidate < num_axes; ++candidate) {
+    if (highest[candidate] - lowest[candidate] >
+        highest[axis] - lowest[axis]) {
+      axis = candidate;
+    }
+  }
+
+  if (last - first <= bucket_capacity || highest[axis] <= lowest[axis]) {
+    int const bucket = static_cast<int>(buckets_.size());
+    buckets_.emplace_back();
+    nodes_[node].bucket = bucket;
+
+    for (size_t i = first; i < last; ++i) {
+      this->append(bucket, entries[i].first, entries[i].second);
+    }
+    return node;
+  }
+
+  // Every profile left of the median is at most the split, every one right
+  // of it at least
+  size_t const middle = first + (last - first) / 2;
+  std::nth_element(begin(entries) + first, begin(entries) + middle,
+                   begin(entries) + last, [axis](auto const &a, auto const &b) {
+                     return a.second[axis] < b.second[axis];
+                   });
+
+  float const split = entries[middle].second[axis];
+  int const left = this->build(entries, first, middle);
+  int const right = this->build(entries, middle, last);
+
+  nodes_[node].axis = static_cast<int>(axis);
+  nodes_[node].split = split;
+  nodes_[node].left = left;
+  nodes_[node].right = right;
+  return node;
+}
+
+auto food::ProfileTree::make_leaf() -> int
+{
+  Node leaf;
+  leaf.bucket = static_cast<int>(buckets_.size());
+  buckets_.emplace_back();
+  nodes_.push_back(leaf);
+  return static_cast<int>(nodes_.size()) - 1;
+}
+
+void food::ProfileTree::append(int bucket, int food_id, Profile const &profile)
+{
+  auto &stored = buckets_[bucket];
+  locations_[food_id] = {bucket, static_cast<int>(stored.food_ids.size())};
+
+  stored.food_ids.push_back(food_id);
+  for (size_t axis = 0; axis < num_axes; ++axis) {
+    stored.columns[axis].push_back(profile[axis]);
+  }
+}
+
+void food::ProfileTree::insert(int food_id, Profile const &profile)
+{
+  // Moving a food only counts as one change
+  auto found = locations_.find(food_id);
+  if (found != end(locations_)) { this->take_out(found); }
+
+  if (nodes_.empty()) { this->make_leaf(); }
+
+  int node = 0;
+  while (nodes_[node].bucket < 0) {
+    auto const &inner = nodes_[node];
+    node = profile[inner.axis] < inner.split ? inner.left : inner.right;
+  }
+
+  this->append(nodes_[node].bucket, food_id, profile);
+
+  if (buckets_[nodes_[node].bucket].food_ids.size() > bucket_capacity) {
+    this->split(node);
+  }
+
+  // Splits keep leaves small but not the tree balanced, profiles inserted in
+  // order grow one branch
+  if (++changes_ > std::max(this->size(), bucket_capacity)) {
+    this->rebalance();
+  }
+}
+
+void food::ProfileTree::split(int node)
+{
+  int const bucket = nodes_[node].bucket;
+
+  size_t axis = 0;
+  float widest = 0;
+  float lowest = 0;
+  float highest = 0;
+  for (size_t candidate = 0; candidate < num_axes; ++candidate) {
+    auto const &column = buckets_[bucket].columns[candidate];
+    auto const [low, high] = std::minmax_element(begin(column), end(column));
+    if (*high - *low > widest) {
+      axis = candidate;
+      widest = *high - *low;
+      lowest = *low;
+      highest = *high;
+    }
+  }
+
+  if (widest <= 0) { return; }
+
+  std::vector<float> values = buckets_[bucket].columns[axis];
+  auto const middle = begin(values) + values.size() / 2;
+  std::nth_element(begin(values), middle, end(values));
+
+  // Many equal profiles can put the median at the lowest value, which would
+  // leave the left side empty
+  float split = *middle;
+  if (split <= lowest) { split = lowest + (highest - lowest) / 2; }
+  if (split <= lowest) { split = highest; }
+
+  // Taken out of the tree, then appended to the two new leaves. The left
+  // one keeps the bucket.
+  Bucket full = std::move(buckets_[bucket]);
+  buckets_[bucket] = Bucket();
+
+  Node left_leaf;
+  left_leaf.bucket = bucket;
+  nodes_.push_back(left_leaf);
+  int const left = static_cast<int>(nodes_.size()) - 1;
+  int const right = this->make_leaf();
+
+  auto &inner = nodes_[node];
+  inner.axis = static_cast<int>(axis);
+  inner.split = split;
+  inner.left = left;
+  inner.right = right;
+  inner.bucket = -1;
+
+  for (size_t slot = 0; slot < full.food_ids.size(); ++slot) {
+    Profile profile;
+    for (size_t i = 0; i < num_axes; ++i) {
+      profile[i] = full.columns[i][slot];
+    }
+
+    int const leaf = profile[axis] < split ? left : right;
+    this->append(nodes_[leaf].bucket, full.food_ids[slot], profile);
+  }
+}
+
+void food::ProfileTree::rebalance()
+{
+  TRACKER_TRACE_SCOPE("food", "ProfileTree::rebalance");
+
+  std::vector<int> food_ids;
+  std::vector<Profile> profiles;
+  food_ids.reserve(this->size());
+  profiles.reserve(this->size());
+
+  for (auto const &stored : buckets_) {
+    for (size_t i = 0; i < stored.food_ids.size(); ++i) {
+      food_ids.push_back(stored.food_ids[i]);
+      profiles.push_back({stored.columns[0][i], stored.columns[1][i],
+                          stored.columns[2][i], stored.columns[3][i]});
+    }
+  }
+
+  this->build(food_ids, profiles);
+}
+
+auto food::ProfileTree::erase(int food_id) -> bool
+{
+  auto found = locations_.find(food_id);
+  if (found == end(locations_)) { return false; }
+
+  this->take_out(found);
+
+  // Leaves emptied by removals are still visited
+  if (++changes_ > std::max(this->size(), bucket_capacity)) {
+    this->rebalance();
+  }
+
+  return true;
+}
+
+void food::ProfileTree::take_out(
+    std::unordered_map<int, Location>::iterator found)
+{
+  auto const [bucket, slot] = found->second;
+  auto &stored = buckets_[bucket];
+  locations_.erase(found);
+
+  // The last profile of the bucket fills the gap
+  size_t const last = stored.food_ids.size() - 1;
+  if (static_cast<size_t>(slot) != last) {
+    stored.food_ids[slot] = stored.food_ids[last];
+    for (auto &column : stored.columns) {
+      column[slot] = column[last];
+    }
+    locations_[stored.food_ids[slot]].slot = slot;
+  }
+
+  stored.food_ids.pop_back();
+  for (auto &column : stored.columns) {
+    column.pop_back();
+  }
+}
+
+auto food::ProfileTree::find(int food_id) const -> std::optional<Profile>
+{
+  auto found = locations_.find(food_id);
+  if (found == end(locations_)) { return std::nullopt; }
+
+  auto const [bucket, slot] = found->second;
+  auto const &columns = buckets_[bucket].columns;
+  return Profile{columns[0][slot], columns[1][slot], columns[2][slot],
+                 columns[3][slot]};
+}
+
+auto food::ProfileTree::nearest(Profile const &profile, size_t k,
+                                int excluded_food_id) const
+    -> std::vector<Neighbour>
+{
+  if (k == 0 || nodes_.empty()) { return {}; }
+
+  std::vector<Candidate> heap;
+  heap.reserve(k + 1);
+  std::vector<float> distances;
+  distances.reserve(bucket_capacity);
+
+  this->search(0, profile, k, excluded_food_id, heap, distances);
+
+  std::sort_heap(begin(heap), end(heap));
+
+  std::vector<Neighbour> neighbours;
+  neighbours.reserve(heap.size());
+  for (auto const &candidate : heap) {
+    neighbours.push_back(
+        {candidate.food_id, std::sqrt(candidate.distance_squared)});
+  }
+  return neighbours;
+}
+
+void food::ProfileTree::search(int node, Profile const &profile, size_t k,
+                               int excluded_food_id,
+                               std::vector<Candidate> &heap,
+                               std::vector<float> &distances) const
+{
+  auto const &current = nodes_[node];
+
+  if (current.bucket >= 0) {
+    auto const &stored = buckets_[current.bucket];
+    size_t const size = stored.food_ids.size();
+    distances.resize(size);
+
+    float *out = distances.data();
+    float const *fat = stored.columns[0].data();
+    float const *carbohydrate = stored.columns[1].data();
+    float const *fiber = stored.columns[2].data();
+    float const *protein = stored.columns[3].data();
+
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      float const a = fat[i] - profile[0];
+      float const b = carbohydrate[i] - profile[1];
+      float const c = fiber[i] - profile[2];
+      float const d = protein[i] - profile[3];
+      out[i] = a * a + b * b + c * c + d * d;
+    }
+
+    // Max heap of the k best so far, its top is the one to beat
+    for (size_t i = 0; i < size; ++i) {
+      Candidate const candidate{out[i], stored.food_ids[i]};
+      if (candidate.food_id == excluded_food_id) { continue; }
+      if (heap.size() == k && !(candidate < heap.front())) { continue; }
+
+      heap.push_back(candidate);
+      std::push_heap(begin(heap), end(heap));
+      if (heap.size() > k) {
+        std::pop_heap(begin(heap), end(heap));
+        heap.pop_back();
+      }
+    }
+    return;
+  }
+
+  float const offset = profile[current.axis] - current.split;
+  int const near = offset < 0 ? current.left : current.right;
+  int const far = offset < 0 ? current.right : current.left;
+
+  this->search(near, profile, k, excluded_food_id, heap, distances);
+
+  // Everything across the plane is at least offset away
+  if (heap.size() < k || offset * offset <= heap.front().distance_squared) {
+    this->search(far, profile, k, excluded_food_id, heap, distances);
+  }
+}
+
+auto food::ProfileTree::size() const -> size_t
+{
+  return locations_.size();
+}
+
+void food::ProfileTree::clear()
+{
+  nodes_.clear();
+  buckets_.clear();
+  locations_.clear();
+  changes_ = 0;
+}
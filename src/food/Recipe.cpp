@@ -0,0 +1,302 @@
+/**
+ * @file Recipe.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief A food made of other foods, with macronutrients derived from its
+ *        ingredients
+ */
+
+#include "food/Recipe.hpp"
+#include "database/Data.hpp"
+#include "database/Memory.hpp"
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "trace/Trace.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @return The cached food with id, nullptr if there is none
+ */
+auto find_food(int food_id) -> food::Food *
+{
+  auto &all_food = database::utils::retrieve_all<food::Food>();
+
+  auto const compare = [](food::Food const &food, int id) {
+    return food.id() < id;
+  };
+  auto found = std::lower_bound(begin(all_food), end(all_food), food_id,
+                                compare);
+
+  if (found == end(all_food) || found->id() != food_id) { return nullptr; }
+  return &*found;
+}
+
+/**
+ * @return true if the food with food_id is a recipe that contains target,
+ *         directly or through other recipes
+ */
+auto made_from(int food_id, int target) -> bool
+{
+  std::unordered_map<int, food::Recipe const *> recipe_of;
+  for (auto const &recipe : database::utils::retrieve_all<food::Recipe>()) {
+    recipe_of.emplace(recipe.food_id(), &recipe);
+  }
+
+  std::vector<int> to_visit = {food_id};
+  std::unordered_set<int> visited;
+  while (!to_visit.empty()) {
+    int const current = to_visit.back();
+    to_visit.pop_back();
+
+    if (current == target) { return true; }
+    if (!visited.insert(current).second) { continue; }
+
+    auto const found = recipe_of.find(current);
+    if (found == end(recipe_of)) { continue; }
+
+    for (auto const &ingredient : found->second->ingredients()) {
+      to_visit.push_back(ingredient.food_id);
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Throws if an ingredient is not a food, or is made from the food of
+ *        the recipe. food_id is 0 for a recipe that has no food yet.
+ */
+void check_ingredients(std::vector<food::Ingredient> const &ingredients,
+                       int food_id)
+{
+  for (auto const &ingredient : ingredients) {
+    if (!find_food(ingredient.food_id)) {
+      std::cerr << "No food with id " << ingredient.food_id << std::endl;
+      throw std::runtime_error("Ingredients must be existing foods");
+    }
+
+    if (food_id != 0 && made_from(ingredient.food_id, food_id)) {
+      std::cerr << "Food " << ingredient.food_id << " is made from food "
+                << food_id << std::endl;
+      throw std::runtime_error("A recipe can not contain itself");
+    }
+  }
+}
+
+} // namespace
+
+food::Recipe::Recipe(int id) : id_{id} {}
+
+food::Recipe::Recipe(int id, int food_id, std::vector<Ingredient> ingredients)
+    : id_{id}, food_id_{food_id}, ingredients_{std::move(ingredients)}
+{}
+
+food::Recipe::Recipe(std::vector<database::ColumnProperties> const &schema,
+                     database::Row const &data)
+{
+  this->set_data(schema, data);
+}
+
+auto food::Recipe::name() const -> std::string_view
+{
+  Food const *food = find_food(this->food_id());
+  if (!food) { return ""; }
+  return food->name();
+}
+
+void food::Recipe::set_name(std::string_view name)
+{
+  Food *food = find_food(this->food_id());
+  if (!food) {
+    std::cerr << "No food with id " << this->food_id() << std::endl;
+    throw std::runtime_error("Recipe must be backed by an existing food");
+  }
+
+  food->set_name(name);
+}
+
+auto food::Recipe::food_id() const -> int
+{
+  return this->food_id_;
+}
+
+auto food::Recipe::ingredients() const -> std::vector<Ingredient> const &
+{
+  return this->ingredients_;
+}
+
+void food::Recipe::set_ingredients(std::vector<Ingredient> ingredients)
+{
+  TRACKER_TRACE_SCOPE("food", "Recipe::set_ingredients");
+
+  check_ingredients(ingredients, this->food_id());
+  auto previous = std::exchange(this->ingredients_, std::move(ingredients));
+
+  try {
+    database::utils::batch([this] {
+      database::utils::update(*this);
+
+      // Recipes made from this one follow through a RecipeGraph
+      if (Food *food = find_food(this->food_id())) {
+        food->set_macronutrients(recipe_macronutrients(this->ingredients()));
+      }
+    });
+  } catch (...) {
+    // The batch only restores the cached recipe, this may be a copy
+    this->ingredients_ = std::move(previous);
+    throw;
+  }
+}
+
+auto food::Recipe::grams() const -> double
+{
+  double grams = 0;
+  for (auto const &ingredient : this->ingredients()) {
+    grams += ingredient.grams;
+  }
+  return grams;
+}
+
+auto food::Recipe::get_data() const -> database::Data const
+{
+  TRACKER_TRACE_SCOPE("food", "Recipe::get_data");
+
+  database::Data data;
+  data.table_name = "Recipe";
+
+  // Recipe ID|food_id|ingredients
+  size_t num_columns = 3;
+  data.schema.reserve(num_columns);
+
+  // The properties of a single column;
+  database::ColumnProperties column_properties;
+
+  // Recipe_id column begin
+  column_properties.name = data.table_name + "_id";
+  column_properties.data_type = database::DataType::INTEGER;
+  column_properties.constraint = database::Constraint::PRIMARY_KEY;
+  data.schema.emplace_back(column_properties);
+
+  database::Row new_row;
+  new_row.row_data.reserve(num_columns);
+
+  // std::variant to hold multiple data types. Defined in Data.hpp.
+  database::Row::row_data_t row_data = this->id();
+  new_row.row_data.emplace_back(row_data);
+
+  // The rest of the columns from hereon will be NOT NULL constraint
+  column_properties.constraint = database::Constraint::NOT_NULL;
+
+  column_properties.name = "food_id";
+  column_properties.data_type = database::DataType::INTEGER;
+  data.schema.emplace_back(column_properties);
+  row_data = this->food_id();
+  new_row.row_data.emplace_back(row_data);
+
+  // A view of the ingredients, bound without a copy
+  column_properties.name = "ingredients";
+  column_properties.data_type = database::DataType::BLOB;
+  data.schema.emplace_back(column_properties);
+  row_data = database::ByteView::of(this->ingredients_);
+  new_row.row_data.emplace_back(row_data);
+
+  data.rows.emplace_back(std::move(new_row));
+
+  return data;
+}
+
+void food::Recipe::set_data(
+    std::vector<database::ColumnProperties> const &schema,
+    database::Row const &row)
+{
+  TRACKER_TRACE_SCOPE("food", "Recipe::set_data");
+
+  // Points into the row rather than copying it, nothing leaves the arena
+  database::StackArena<1024> arena;
+  std::pmr::unordered_map<std::string_view, database::Row::row_data_t const *>
+      organized_data(&arena);
+
+  for (auto const &[first, second] : ranges::view::zip(schema, row.row_data)) {
+    organized_data[first.name] = &second;
+  }
+
+  this->id_ = std::get<int>(*organized_data.at("Recipe_id"));
+  this->food_id_ = std::get<int>(*organized_data.at("food_id"));
+  this->ingredients_ =
+      std::get<database::ByteView>(*organized_data.at("ingredients"))
+          .to_vector<Ingredient>();
+}
+
+auto food::Recipe::str() const -> std::string
+{
+  std::stringstream ss;
+  ss << this->id();
+
+  auto const delimeter = "|";
+  ss << delimeter << this->food_id();
+  ss << delimeter;
+
+  auto separator = "";
+  for (auto const &ingredient : this->ingredients()) {
+    ss << separator << ingredient.food_id << ":" << ingredient.grams;
+    separator = ",";
+  }
+
+  return ss.str();
+}
+
+auto food::make_recipe(std::string_view name,
+                       std::vector<Ingredient> ingredients) -> Recipe &
+{
+  TRACKER_TRACE_SCOPE("food", "make_recipe");
+
+  // The food is new, nothing can be made from it yet
+  check_ingredients(ingredients, 0);
+
+  Recipe *recipe = nullptr;
+  database::utils::batch([&] {
+    auto const macros = recipe_macronutrients(ingredients);
+    int const food_id = database::utils::make<Food>(name, macros).id();
+    recipe = &database::utils::make<Recipe>(food_id, std::move(ingredients));
+  });
+
+  return *recipe;
+}
+
+auto food::recipe_macronutrients(std::vector<Ingredient> const &ingredients,
+                                 int missing_food_id) -> Macronutrients
+{
+  Macronutrients total;
+  double grams = 0;
+
+  for (auto const &ingredient : ingredients) {
+    grams += ingredient.grams;
+
+    if (ingredient.food_id == missing_food_id) { continue; }
+
+    Food const *food = find_food(ingredient.food_id);
+    if (!food) { continue; }
+
+    Macronutrients portion = food->macronutrients();
+    portion *= ingredient.grams / 100.0;
+    total += portion;
+  }
+
+  if (grams <= 0) { return Macronutrients(); }
+
+  total *= 100 / grams;
+  return total;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file RecipeGraph.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Keeps the macronutrients of recipes up to date as their ingredients
+ *        change
+ */
+
+#include "food/RecipeGraph.hpp"
+#include "database/utils.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+food::RecipeGraph::RecipeGraph()
+{
+  namespace utils = database::utils;
+
+  recipe_listener_ = utils::Subscription<Recipe>(
+      [this](Recipe const &recipe, utils::Change change) {
+        this->on_recipe(recipe, change);
+      });
+
+  food_listener_ = utils::Subscription<Food>(
+      [this](Food const &food, utils::Change change) {
+        this->on_food(food, change);
+      });
+
+  this->rebuild();
+}
+
+auto food::RecipeGraph::dependents(int food_id) const -> std::vector<int>
+{
+  auto const found = dependents_.find(food_id);
+  if (found == end(dependents_)) { return {}; }
+  return found->second;
+}
+
+auto food::RecipeGraph::recompute(int food_id) -> size_t
+{
+  return this->propagate(food_id, 0);
+}
+
+auto food::RecipeGraph::recomputations() const -> size_t
+{
+  return recomputations_;
+}
+
+void food::RecipeGraph::rebuild()
+{
+  TRACKER_TRACE_SCOPE("food", "RecipeGraph::rebuild");
+
+  nodes_.clear();
+  dependents_.clear();
+
+  for (auto const &recipe : database::utils::retrieve_all<Recipe>()) {
+    this->on_recipe(recipe, database::utils::Change::INSERTED);
+  }
+}
+
+void food::RecipeGraph::on_recipe(Recipe const &recipe,
+                                  database::utils::Change change)
+{
+  this->remove(recipe.id());
+
+  if (change == database::utils::Change::DELETED) { return; }
+
+  Node node;
+  node.food_id = recipe.food_id();
+  for (auto const &ingredient : recipe.ingredients()) {
+    node.ingredients.push_back(ingredient.food_id);
+  }
+
+  std::sort(begin(node.ingredients), end(node.ingredients));
+  node.ingredients.erase(
+      std::unique(begin(node.ingredients), end(node.ingredients)),
+      end(node.ingredients));
+
+  for (int const food_id : node.ingredients) {
+    dependents_[food_id].push_back(recipe.id());
+  }
+
+  nodes_[recipe.id()] = std::move(node);
+}
+
+void food::RecipeGraph::on_food(Food const &food,
+                                database::utils::Change change)
+{
+  if (writing_) { return; }
+
+  // A deleted food is still in the cache, it has to be left out explicitly
+  int const missing_food_id =
+      change == database::utils::Change::DELETED ? food.id() : 0;
+  this->propagate(food.id(), missing_food_id);
+}
+
+auto food::RecipeGraph::propagate(int food_id, int missing_food_id) -> size_t
+{
+  auto const order = this->affected(food_id);
+  if (order.empty()) { return 0; }
+
+  TRACKER_TRACE_SCOPE("food", "RecipeGraph::propagate");
+
+  auto const &all_recipes = database::utils::retrieve_all<Recipe>();
+  auto &all_food = database::utils::retrieve_all<Food>();
+
+  auto const recipe_compare = [](Recipe const &recipe, int id) {
+    return recipe.id() < id;
+  };
+  auto const food_compare = [](Food const &food, int id) {
+    return food.id() < id;
+  };
+
+  writing_ = true;
+  try {
+    database::utils::batch([&] {
+      for (int const recipe_id : order) {
+        auto const recipe = std::lower_bound(
+            begin(all_recipes), end(all_recipes), recipe_id, recipe_compare);
+        if (recipe == end(all_recipes) || recipe->id() != recipe_id) {
+          continue;
+        }
+
+        auto food = std::lower_bound(begin(all_food), end(all_food),
+                                     recipe->food_id(), food_compare);
+        if (food == end(all_food) || food->id() != recipe->food_id()) {
+          continue;
+        }
+
+        food->set_macronutrients(
+            recipe_macronutrients(recipe->ingredients(), missing_food_id));
+      }
+    });
+  } catch (...) {
+    writing_ = false;
+    throw;
+  }
+  writing_ = false;
+
+  recomputations_ += order.size();
+  return order.size();
+}
+
+void food::RecipeGraph::remove(int recipe_id)
+{
+  auto found = nodes_.find(recipe_id);
+  if (found == end(nodes_)) { return; }
+
+  for (int const food_id : found->second.ingredients) {
+    auto &recipes = dependents_[food_id];
+    recipes.erase(std::remove(begin(recipes), end(recipes), recipe_id),
+                  end(recipes));
+    if (recipes.empty()) { dependents_.erase(food_id); }
+  }
+
+  nodes_.erase(found);
+}
+
+auto food::RecipeGraph::affected(int food_id) const -> std::vector<int>
+{
+  static std::vector<int> const none;
+  auto const dependents_of = [this](int id) -> std::vector<int> const & {
+    auto const found = dependents_.find(id);
+    return found == end(dependents_) ? none : found->second;
+  };
+
+  // Depth first from the food. A recipe is finished once every recipe made
+  // from it is, so reversing the finishing order puts each recipe after the
+  // ones it is made of.
+  std::vector<int> order;
+  std::unordered_set<int> visited;
+  std::vector<std::pair<int, size_t>> stack;
+
+  for (int const root : dependents_of(food_id)) {
+    if (!visited.insert(root).second) { continue; }
+    stack.emplace_back(root, 0);
+
+    while (!stack.empty()) {
+      auto const [recipe_id, next] = stack.back();
+      auto const &made_from_it = dependents_of(nodes_.at(recipe_id).food_id);
+
+      if (next < made_from_it.size()) {
+        ++stack.back().second;
+
+        int const dependent = made_from_it[next];
+        if (visited.insert(dependent).second) {
+          stack.emplace_back(dependent, 0);
+        }
+        continue;
+      }
+
+      order.push_back(recipe_id);
+      stack.pop_back();
+    }
+  }
+
+  std::reverse(begin(order), end(order));
+  return order;
+}
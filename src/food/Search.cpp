@@ -0,0 +1,98 @@
+/**
+ * @file Search.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Type-ahead search over food names that refines the previous result
+ *        when the query grows
+ */
+
+#include "food/Search.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Names searched between polls of is_cancelled
+ */
+size_t const cancel_check_interval = 1024;
+
+auto split_words(std::string_view text) -> std::vector<std::string_view>
+{
+  std::vector<std::string_view> words;
+
+  size_t first = text.find_first_not_of(" \t");
+  while (first != std::string_view::npos) {
+    size_t const last = text.find_first_of(" \t", first);
+    words.push_back(text.substr(first, last - first));
+    first = text.find_first_not_of(" \t", last);
+  }
+
+  return words;
+}
+
+auto contains_all(std::string_view name,
+                  std::vector<std::string_view> const &words) -> bool
+{
+  return std::all_of(begin(words), end(words), [name](std::string_view word) {
+    return name.find(word) != std::string_view::npos;
+  });
+}
+
+} // namespace
+
+auto food::fold_case(std::string_view text) -> std::string
+{
+  std::string folded(text);
+  for (auto &character : folded) {
+    if (character >= 'A' && character <= 'Z') { character += 'a' - 'A'; }
+  }
+  return folded;
+}
+
+auto food::search(std::vector<std::string> const &names,
+                  std::string_view query, SearchResult const *previous,
+                  std::function<bool()> const &is_cancelled)
+    -> std::optional<SearchResult>
+{
+  SearchResult result;
+  result.query = fold_case(query);
+  auto const words = split_words(result.query);
+
+  // Every word of the previous query is part of a word of this one, so a
+  // name that did not match then can not match now
+  bool const refines =
+      previous != nullptr &&
+      result.query.compare(0, previous->query.size(), previous->query) == 0;
+
+  size_t const num_candidates =
+      refines ? previous->matches.size() : names.size();
+
+  for (size_t i = 0; i < num_candidates; ++i) {
+    if (i % cancel_check_interval == 0 && is_cancelled()) {
+      return std::nullopt;
+    }
+
+    size_t const index = refines ? previous->matches[i] : i;
+    if (contains_all(names[index], words)) { result.matches.push_back(index); }
+  }
+
+  return result;
+}
+
+auto food::rank(std::vector<std::string> const &names,
+                SearchResult const &result) -> std::vector<size_t>
+{
+  std::vector<size_t> ranked = result.matches;
+
+  auto const words = split_words(result.query);
+  if (words.empty()) { return ranked; }
+
+  std::stable_partition(begin(ranked), end(ranked),
+                        [&names, first = words.front()](size_t index) {
+                          return names[index].compare(0, first.size(),
+                                                      first) == 0;
+                        });
+
+  return ranked;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file SimilarFoods.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Finds the foods most alike a food, kept up to date with the food
+ *        table
+ */
+
+#include "food/SimilarFoods.hpp"
+#include "trace/Trace.hpp"
+
+food::SimilarFoods::SimilarFoods()
+{
+  namespace utils = database::utils;
+
+  food_listener_ = utils::Subscription<Food>(
+      [this](Food const &food, utils::Change change) {
+        this->on_food(food, change);
+      });
+
+  this->rebuild();
+}
+
+auto food::SimilarFoods::similar(int food_id, size_t k) const
+    -> std::vector<Neighbour>
+{
+  TRACKER_TRACE_SCOPE("food", "SimilarFoods::similar");
+
+  auto const found = tree_.find(food_id);
+  if (!found) { return {}; }
+
+  return tree_.nearest(*found, k, food_id);
+}
+
+auto food::SimilarFoods::similar(Macronutrients const &macros, size_t k) const
+    -> std::vector<Neighbour>
+{
+  TRACKER_TRACE_SCOPE("food", "SimilarFoods::similar");
+
+  return tree_.nearest(profile(macros), k);
+}
+
+void food::SimilarFoods::rebuild()
+{
+  TRACKER_TRACE_SCOPE("food", "SimilarFoods::rebuild");
+
+  tree_ = ProfileTree::from(database::utils::retrieve_all<Food>());
+}
+
+void food::SimilarFoods::on_food(Food const &food,
+                                 database::utils::Change change)
+{
+  if (change == database::utils::Change::DELETED) {
+    tree_.erase(food.id());
+    return;
+  }
+
+  tree_.insert(food.id(), profile(food.macronutrients()));
+}
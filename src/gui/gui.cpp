@@ -1,22 +1,50 @@
+#include "trace/Trace.hpp"
+
 #include <QApplication>
 #include <QFontDatabase>
+#include <QQuickWindow>
 #include <QStringList>
 #include <QTextStream>
 #include <QtQml/QQmlApplicationEngine>
 
+#include <iostream>
+#include <memory>
+
 namespace gui {
 int app(int argc, char *argv[])
 {
+  // Startup milestones are measured from here, see trace::milestone
+  trace::now();
+
   QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
   QApplication app(argc, argv);
 
   int font_id = QFontDatabase::addApplicationFont(":/fonts/Ubuntu-R.ttf");
   if (font_id) { app.setFont(QFont("Ubuntu", 11, QFont::Normal, false)); }
 
+  // Data is loaded in the background by the models, the window is shown
+  // before it is ready
   QQmlApplicationEngine engine;
   engine.load(QUrl("qrc:///qml/main.qml"));
   if (engine.rootObjects().isEmpty()) { return -1; }
 
-  return app.exec();
+  if (auto *window = qobject_cast<QQuickWindow *>(engine.rootObjects()[0])) {
+    // May be emitted on the render thread
+    auto first_frame = std::make_shared<QMetaObject::Connection>();
+    *first_frame =
+        QObject::connect(window, &QQuickWindow::frameSwapped, [first_frame] {
+          QObject::disconnect(*first_frame);
+          std::clog << "First frame after "
+                    << trace::milestone("gui", "startup::first_frame")
+                    << " ms" << std::endl;
+        });
+  }
+
+  int const status = app.exec();
+
+  // Spans are only recorded when TRACKER_TRACE is set or tracing was turned on
+  if (trace::is_enabled()) { trace::flush(); }
+
+  return status;
 }
 } // namespace gui
@@ -0,0 +1,243 @@
+#include "gui/plugins/chart/ChartModel.hpp"
+#include "body/WeightEntry.hpp"
+#include "database/utils.hpp"
+#include "food/IntakeRollup.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief The weigh-ins as kg per day
+ */
+auto weight_series() -> std::vector<chart::Point>
+{
+  std::vector<chart::Point> points;
+
+  auto const &weights = database::utils::retrieve_all<body::WeightEntry>();
+  points.reserve(weights.size());
+  for (auto const &weight : weights) {
+    points.push_back({static_cast<double>(weight.day()), weight.kg()});
+  }
+
+  // The cache is sorted by id, not by day
+  std::sort(begin(points), end(points),
+            [](chart::Point const &lhs, chart::Point const &rhs) {
+              return lhs.x < rhs.x;
+            });
+  return points;
+}
+
+/**
+ * @brief The kcal eaten on every day with entries
+ */
+auto intake_series(food::IntakeRollup const &intake)
+    -> std::vector<chart::Point>
+{
+  auto const days = intake.days();
+
+  std::vector<chart::Point> points;
+  points.reserve(days.size());
+  for (long long const day : days) {
+    points.push_back(
+        {static_cast<double>(day), intake.total(day, day).kcal()});
+  }
+  return points;
+}
+
+} // namespace
+
+gui::ChartModel::ChartModel(QObject *parent) : QAbstractListModel(parent) {}
+
+auto gui::ChartModel::rowCount(QModelIndex const &parent) const -> int
+{
+  if (parent.isValid()) { return 0; }
+  return static_cast<int>(m_shown.size());
+}
+
+auto gui::ChartModel::data(QModelIndex const &index, int role) const
+    -> QVariant
+{
+  if (!index.isValid() || index.row() >= this->rowCount()) {
+    return QVariant();
+  }
+
+  auto const &point = m_shown[index.row()];
+  switch (role) {
+  case XRole:
+    return point.x;
+  case YRole:
+    return point.y;
+  default:
+    return QVariant();
+  }
+}
+
+auto gui::ChartModel::roleNames() const -> QHash<int, QByteArray>
+{
+  return {{XRole, "x"}, {YRole, "y"}};
+}
+
+QPointF gui::ChartModel::at(int row) const
+{
+  if (row < 0 || row >= this->rowCount()) { return QPointF(); }
+  return QPointF(m_shown[row].x, m_shown[row].y);
+}
+
+void gui::ChartModel::setRange(double x_min, double x_max)
+{
+  if (!(x_min < x_max)) { return; }
+
+  m_x_min = x_min;
+  m_x_max = x_max;
+  this->recompute();
+}
+
+void gui::ChartModel::showAll()
+{
+  auto const &points = m_downsampler.points();
+  if (points.empty()) { return; }
+
+  // A single point still needs a range around it
+  this->setRange(points.front().x - 1, points.back().x + 1);
+}
+
+auto gui::ChartModel::series() const -> QString
+{
+  return m_series;
+}
+
+auto gui::ChartModel::pixels() const -> int
+{
+  return m_pixels;
+}
+
+auto gui::ChartModel::xMin() const -> double
+{
+  return m_x_min;
+}
+
+auto gui::ChartModel::xMax() const -> double
+{
+  return m_x_max;
+}
+
+auto gui::ChartModel::yMin() const -> double
+{
+  return m_y_min;
+}
+
+auto gui::ChartModel::yMax() const -> double
+{
+  return m_y_max;
+}
+
+auto gui::ChartModel::count() const -> int
+{
+  return this->rowCount();
+}
+
+void gui::ChartModel::setSeries(QString const &series)
+{
+  if (series == m_series) { return; }
+
+  m_series = series;
+  emit seriesChanged(series);
+
+  this->reload();
+  this->subscribe();
+  this->showAll();
+}
+
+void gui::ChartModel::setPixels(int pixels)
+{
+  if (pixels == m_pixels) { return; }
+
+  m_pixels = pixels;
+  emit pixelsChanged(pixels);
+  this->recompute();
+}
+
+void gui::ChartModel::reload()
+{
+  TRACKER_TRACE_SCOPE("gui", "ChartModel::reload");
+
+  if (m_series == "weight") {
+    m_downsampler.set_points(weight_series());
+  } else if (m_series == "intake") {
+    if (m_intake) {
+      m_intake->rebuild();
+    } else {
+      m_intake = std::make_unique<food::IntakeRollup>();
+    }
+    m_downsampler.set_points(intake_series(*m_intake));
+  } else {
+    m_downsampler.set_points({});
+  }
+
+  this->recompute();
+}
+
+void gui::ChartModel::recompute()
+{
+  TRACKER_TRACE_SCOPE("gui", "ChartModel::recompute");
+
+  beginResetModel();
+  m_shown = m_downsampler.window(m_x_min, m_x_max, std::max(m_pixels, 0));
+  endResetModel();
+
+  if (!m_shown.empty()) {
+    auto const [lowest, highest] = std::minmax_element(
+        begin(m_shown), end(m_shown),
+        [](chart::Point const &lhs, chart::Point const &rhs) {
+          return lhs.y < rhs.y;
+        });
+    m_y_min = lowest->y;
+    m_y_max = highest->y;
+  }
+
+  emit windowChanged();
+}
+
+void gui::ChartModel::subscribe()
+{
+  namespace utils = database::utils;
+
+  m_weight_listener.reset();
+  if (m_series != "intake") { m_intake.reset(); }
+
+  if (m_series == "weight") {
+    // New weigh-ins only recompute the buckets around them
+    m_weight_listener = utils::Subscription<body::WeightEntry>(
+        [this](body::WeightEntry const &weight, utils::Change change) {
+          if (change == utils::Change::INSERTED) {
+            m_downsampler.insert(
+                {static_cast<double>(weight.day()), weight.kg()});
+            this->recompute();
+          } else {
+            this->reload();
+          }
+        });
+  } else if (m_intake) {
+    m_intake->set_listener([this](std::vector<long long> const &days) {
+      this->on_intake_days(days);
+    });
+  }
+}
+
+void gui::ChartModel::on_intake_days(std::vector<long long> const &days)
+{
+  TRACKER_TRACE_SCOPE("gui", "ChartModel::on_intake_days");
+
+  for (long long const day : days) {
+    auto const x = static_cast<double>(day);
+    if (m_intake->has_entries(day)) {
+      m_downsampler.update({x, m_intake->total(day, day).kcal()});
+    } else {
+      m_downsampler.erase(x);
+    }
+  }
+
+  this->recompute();
+}
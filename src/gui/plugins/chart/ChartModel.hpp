@@ -0,0 +1,128 @@
+#pragma once
+
+#include "body/WeightEntry.hpp"
+#include "chart/Downsample.hpp"
+#include "database/utils.hpp"
+#include "food/IntakeRollup.hpp"
+
+#include <QAbstractListModel>
+#include <QPointF>
+#include <QtCore>
+
+#include <memory>
+#include <vector>
+
+namespace gui {
+/**
+ * @brief The downsampled points of a weight or intake series for the visible
+ *        range of a chart
+ *
+ * Holds at most one point per pixel of the chart. Panning and zooming only
+ * downsample the buckets that were not visible before, see
+ * chart::Downsampler. The intake series is read from a food::IntakeRollup,
+ * a change of the diary or of a food only updates the days it touched.
+ *
+ * Usage:
+ * @n ChartModel {
+ * @n   series: "weight"
+ * @n   pixels: chart.width
+ * @n }
+ */
+class ChartModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_DISABLE_COPY(ChartModel)
+  Q_PROPERTY(QString series READ series WRITE setSeries NOTIFY seriesChanged)
+  Q_PROPERTY(int pixels READ pixels WRITE setPixels NOTIFY pixelsChanged)
+  Q_PROPERTY(double xMin READ xMin NOTIFY windowChanged)
+  Q_PROPERTY(double xMax READ xMax NOTIFY windowChanged)
+  Q_PROPERTY(double yMin READ yMin NOTIFY windowChanged)
+  Q_PROPERTY(double yMax READ yMax NOTIFY windowChanged)
+  Q_PROPERTY(int count READ count NOTIFY windowChanged)
+
+public:
+  enum Roles { XRole = Qt::UserRole + 1, YRole };
+
+  ChartModel(QObject *parent = nullptr);
+
+  auto rowCount(QModelIndex const &parent = QModelIndex()) const
+      -> int override;
+  auto data(QModelIndex const &index, int role = Qt::DisplayRole) const
+      -> QVariant override;
+  auto roleNames() const -> QHash<int, QByteArray> override;
+
+  /**
+   * @return The point in row, for drawing without delegates
+   */
+  Q_INVOKABLE QPointF at(int row) const;
+
+  /**
+   * @brief Shows x_min to x_max, in days since the epoch
+   */
+  Q_INVOKABLE void setRange(double x_min, double x_max);
+
+  /**
+   * @brief Shows the whole series
+   */
+  Q_INVOKABLE void showAll();
+
+  auto series() const -> QString;
+  auto pixels() const -> int;
+  auto xMin() const -> double;
+  auto xMax() const -> double;
+  auto yMin() const -> double;
+  auto yMax() const -> double;
+  auto count() const -> int;
+
+public slots:
+  /**
+   * @param series "weight" for the weigh-ins in kg or "intake" for the
+   *               daily energy eaten in kcal
+   */
+  void setSeries(QString const &series);
+  void setPixels(int pixels);
+
+  /**
+   * @brief Reads the series from the database again
+   */
+  void reload();
+
+signals:
+  void seriesChanged(QString const &arg);
+  void pixelsChanged(int arg);
+  void windowChanged();
+
+private:
+  /**
+   * @brief Downsamples the visible range again
+   */
+  void recompute();
+
+  /**
+   * @brief Listens to the changes of the current series only
+   */
+  void subscribe();
+
+  /**
+   * @brief Updates the points of days from the intake rollup
+   */
+  void on_intake_days(std::vector<long long> const &days);
+
+  chart::Downsampler m_downsampler;
+  std::vector<chart::Point> m_shown;
+
+  QString m_series;
+  int m_pixels = 0;
+  double m_x_min = 0;
+  double m_x_max = 0;
+  double m_y_min = 0;
+  double m_y_max = 0;
+
+  database::utils::Subscription<body::WeightEntry> m_weight_listener;
+
+  /**
+   * @brief Only kept while the intake series is shown, calls this back on
+   *        every change so it is destroyed first
+   */
+  std::unique_ptr<food::IntakeRollup> m_intake;
+};
+} // namespace gui
@@ -0,0 +1,10 @@
+#include "ChartPlugin.hpp"
+#include "ChartModel.hpp"
+
+#include <qqml.h>
+
+void ChartPlugin::registerTypes(const char *uri)
+{
+  // @uri org.example.io
+  qmlRegisterType<gui::ChartModel>(uri, 1, 0, "ChartModel");
+}
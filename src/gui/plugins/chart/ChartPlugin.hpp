@@ -0,0 +1,11 @@
+#pragma once
+
+#include <QQmlExtensionPlugin>
+
+class ChartPlugin : public QQmlExtensionPlugin {
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "org.qt-project.Qt.QQmlExtensionInterface")
+
+public:
+  void registerTypes(const char *uri) override;
+};
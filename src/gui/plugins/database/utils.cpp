@@ -1,15 +1,27 @@
-#include "database/utils.hpp"
 #include "gui/plugins/database/utils.hpp"
+#include "gui/plugins/food/FoodListModel.hpp"
 
-gui::utils::utils(QObject *parent) : QObject(parent)
-{
-  m_data["Food"] = loadDatabase<food::Food, gui::Food>(parent);
-}
+#include <iostream>
+
+gui::utils::utils(QObject *parent) : QObject(parent) {}
 
 gui::utils::~utils() = default;
 
-// auto gui::utils::getData(QString const &table_name) -> QList<QObject *>
-QList<QObject *> gui::utils::getData(QString const &table_name)
+QAbstractItemModel *gui::utils::model(QString const &table_name)
 {
-  return m_data[table_name];
+  if (auto found = m_models.find(table_name); found != m_models.end()) {
+    return *found;
+  }
+
+  QAbstractItemModel *new_model = nullptr;
+  if (table_name == "Food") {
+    new_model = new FoodListModel(this);
+  } else {
+    std::cerr << "No model for table " << table_name.toStdString()
+              << std::endl;
+    return nullptr;
+  }
+
+  m_models.insert(table_name, new_model);
+  return new_model;
 }
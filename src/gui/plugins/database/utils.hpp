@@ -1,10 +1,6 @@
 #pragma once
 
-#include "database/Storable.hpp"
-#include "database/utils.hpp"
-#include "food/Food.hpp"
-#include "gui/plugins/food/Food.hpp"
-
+#include <QAbstractItemModel>
 #include <QtCore>
 
 namespace gui {
@@ -15,35 +11,16 @@ public:
   utils(QObject *parent = nullptr);
   ~utils() override;
 
-  // Q_INVOKABLE auto getData(QString const &table_name) -> QList<QObject *>;
-  Q_INVOKABLE QList<QObject *> getData(QString const &table_name);
+  /**
+   * @return A model of every row of the table, owned by this object. The
+   *         rows are read from the database::utils cache as they are shown.
+   *
+   * Usage:
+   * @n TableView { model: database.model("Food") }
+   */
+  Q_INVOKABLE QAbstractItemModel *model(QString const &table_name);
 
 private:
-  template <typename Storable, typename StorablePlugin,
-            typename std::enable_if_t<
-                std::is_base_of_v<database::Storable, std::decay_t<Storable>>,
-                int> = 0>
-  auto loadDatabase(QObject *parent) -> QList<QObject *>;
-
-  QHash<QString, QList<QObject *>> m_data;
+  QHash<QString, QAbstractItemModel *> m_models;
 };
 } // namespace gui
-
-// template implementation
-
-template <
-    typename Storable, typename StorablePlugin,
-    typename std::enable_if_t<
-        std::is_base_of_v<database::Storable, std::decay_t<Storable>>, int>>
-auto gui::utils::loadDatabase(QObject *parent) -> QList<QObject *>
-{
-  auto &data = database::utils::retrieve_all<Storable>();
-  QList<QObject *> new_data;
-
-  new_data.reserve(data.size());
-  for (Storable &storable : data) {
-    auto new_storable = new StorablePlugin(storable, parent);
-    new_data.append(new_storable);
-  }
-  return new_data;
-}
@@ -2,6 +2,7 @@
 #include "database/utils.hpp"
 #include "food/Macronutrients.hpp"
 #include "gui/plugins/food/Food.hpp"
+#include "trace/Trace.hpp"
 
 gui::Food::Food(QObject *parent) : QObject(parent)
 {
@@ -22,7 +23,8 @@ auto gui::Food::key() -> int const
 
 auto gui::Food::name() -> QString const
 {
-  return m_food->name().c_str();
+  auto const name = m_food->name();
+  return QString::fromUtf8(name.data(), static_cast<int>(name.size()));
 }
 
 auto gui::Food::fat() -> double const
@@ -47,12 +49,16 @@ auto gui::Food::protein() -> double const
 
 void gui::Food::setName(QString const &name)
 {
+  TRACKER_TRACE_SCOPE("gui", "Food::setName");
+
   m_food->set_name(name.toStdString());
   emit nameChanged(name);
 }
 
 void gui::Food::setFat(double fat)
 {
+  TRACKER_TRACE_SCOPE("gui", "Food::setFat");
+
   food::Macronutrients macros = m_food->macronutrients();
   macros.set_fat(fat);
   m_food->set_macronutrients(macros);
@@ -61,6 +67,8 @@ void gui::Food::setFat(double fat)
 
 void gui::Food::setCarbohydrate(double carbohydrate)
 {
+  TRACKER_TRACE_SCOPE("gui", "Food::setCarbohydrate");
+
   food::Macronutrients macros = m_food->macronutrients();
   macros.set_carbohydrate(carbohydrate);
   m_food->set_macronutrients(macros);
@@ -69,6 +77,8 @@ void gui::Food::setCarbohydrate(double carbohydrate)
 
 void gui::Food::setFiber(double fiber)
 {
+  TRACKER_TRACE_SCOPE("gui", "Food::setFiber");
+
   food::Macronutrients macros = m_food->macronutrients();
   macros.set_fiber(fiber);
   m_food->set_macronutrients(macros);
@@ -77,6 +87,8 @@ void gui::Food::setFiber(double fiber)
 
 void gui::Food::setProtein(double protein)
 {
+  TRACKER_TRACE_SCOPE("gui", "Food::setProtein");
+
   food::Macronutrients macros = m_food->macronutrients();
   macros.set_protein(protein);
   m_food->set_macronutrients(macros);
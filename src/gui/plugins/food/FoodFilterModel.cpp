@@ -0,0 +1,417 @@
+#include "gui/plugins/food/FoodFilterModel.hpp"
+#include "trace/Trace.hpp"
+
+#include <QRunnable>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Milliseconds from a source change to the search it triggers
+ */
+int const refresh_delay = 100;
+
+/**
+ * @brief Runs a function on a QThreadPool
+ */
+class Task : public QRunnable {
+public:
+  explicit Task(std::function<void()> function)
+      : function_{std::move(function)}
+  {}
+
+  void run() override
+  {
+    function_();
+  }
+
+private:
+  std::function<void()> function_;
+};
+
+/**
+ * @return The row a source row moves to once the removed rows from first are
+ *         replaced with inserted rows, none if it was removed
+ */
+auto moved_row(size_t row, size_t first, size_t removed, size_t inserted)
+    -> std::optional<size_t>
+{
+  // Replaced rows keep their place, like names changed in place
+  if (row < first + std::min(removed, inserted)) { return row; }
+  if (row < first + removed) { return std::nullopt; }
+
+  return row - removed + inserted;
+}
+
+/**
+ * @brief Moves rows of the source along with a change of the source, rows
+ *        removed from it are erased
+ */
+void move_rows(std::vector<size_t> &rows, size_t first, size_t removed,
+               size_t inserted)
+{
+  auto const moved = [=](size_t row) {
+    return moved_row(row, first, removed, inserted);
+  };
+
+  rows.erase(std::remove_if(begin(rows), end(rows),
+                            [&](size_t row) { return !moved(row); }),
+             end(rows));
+
+  for (auto &row : rows) {
+    row = *moved(row);
+  }
+}
+
+} // namespace
+
+gui::FoodFilterModel::FoodFilterModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+  // A newer query waits for the older one to notice it was cancelled
+  // instead of competing with it
+  m_pool.setMaxThreadCount(1);
+
+  m_refresh.setSingleShot(true);
+  m_refresh.setInterval(refresh_delay);
+  connect(&m_refresh, &QTimer::timeout, this, &FoodFilterModel::search);
+}
+
+gui::FoodFilterModel::~FoodFilterModel()
+{
+  ++m_generation;
+  m_pool.waitForDone();
+}
+
+auto gui::FoodFilterModel::rowCount(QModelIndex const &parent) const -> int
+{
+  if (parent.isValid()) { return 0; }
+  return static_cast<int>(m_rows.size());
+}
+
+auto gui::FoodFilterModel::data(QModelIndex const &index, int role) const
+    -> QVariant
+{
+  int const source_row = this->sourceRow(index.row());
+  if (!index.isValid() || source_row < 0) { return QVariant(); }
+
+  return m_source->data(m_source->index(source_row, 0), role);
+}
+
+auto gui::FoodFilterModel::setData(QModelIndex const &index,
+                                   QVariant const &value, int role) -> bool
+{
+  int const source_row = this->sourceRow(index.row());
+  if (!index.isValid() || source_row < 0) { return false; }
+
+  return m_source->setData(m_source->index(source_row, 0), value, role);
+}
+
+auto gui::FoodFilterModel::flags(QModelIndex const &index) const
+    -> Qt::ItemFlags
+{
+  int const source_row = this->sourceRow(index.row());
+  if (!index.isValid() || source_row < 0) { return Qt::NoItemFlags; }
+
+  return m_source->flags(m_source->index(source_row, 0));
+}
+
+auto gui::FoodFilterModel::roleNames() const -> QHash<int, QByteArray>
+{
+  if (!m_source) { return {}; }
+  return m_source->roleNames();
+}
+
+auto gui::FoodFilterModel::sourceModel() const -> QAbstractItemModel *
+{
+  return m_source;
+}
+
+auto gui::FoodFilterModel::query() const -> QString
+{
+  return m_query;
+}
+
+auto gui::FoodFilterModel::searching() const -> bool
+{
+  return m_searching;
+}
+
+void gui::FoodFilterModel::setSourceModel(QAbstractItemModel *source_model)
+{
+  if (source_model == m_source) { return; }
+
+  if (m_source) { disconnect(m_source, nullptr, this, nullptr); }
+  m_source = source_model;
+
+  if (m_source) {
+    connect(m_source, &QAbstractItemModel::rowsInserted, this,
+            &FoodFilterModel::on_rows_inserted);
+    connect(m_source, &QAbstractItemModel::rowsRemoved, this,
+            &FoodFilterModel::on_rows_removed);
+    connect(m_source, &QAbstractItemModel::dataChanged, this,
+            &FoodFilterModel::on_data_changed);
+    connect(m_source, &QAbstractItemModel::rowsMoved, this,
+            &FoodFilterModel::on_source_reset);
+    connect(m_source, &QAbstractItemModel::modelReset, this,
+            &FoodFilterModel::on_source_reset);
+  }
+
+  emit sourceModelChanged(source_model);
+
+  // Shown rows belong to the old source
+  beginResetModel();
+  m_rows.clear();
+  m_last_result.reset();
+  endResetModel();
+
+  if (m_source) { this->reset_names(); }
+  this->search();
+}
+
+void gui::FoodFilterModel::setQuery(QString const &query)
+{
+  if (query == m_query) { return; }
+
+  m_query = query;
+  emit queryChanged(query);
+
+  this->search();
+}
+
+int gui::FoodFilterModel::sourceRow(int row) const
+{
+  if (!m_source || row < 0 || row >= static_cast<int>(m_rows.size())) {
+    return -1;
+  }
+
+  // The source may have shrunk since the result was published
+  int const source_row = static_cast<int>(m_rows[row]);
+  if (source_row >= m_source->rowCount()) { return -1; }
+
+  return source_row;
+}
+
+void gui::FoodFilterModel::search()
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodFilterModel::search");
+
+  m_refresh.stop();
+  if (!m_source) { return; }
+
+  // The last result holds rows of the names before the changes
+  if (!m_pending.empty()) { m_last_result.reset(); }
+
+  std::vector<Splice> splices;
+  splices.swap(m_pending);
+
+  // Cancels the query still running, if any
+  size_t const generation = ++m_generation;
+  this->set_searching(true);
+
+  m_pool.start(new Task([this, generation, splices = std::move(splices),
+                         previous = m_last_result,
+                         query = m_query.toStdString()]() mutable {
+    TRACKER_TRACE_SCOPE("gui", "FoodFilterModel::evaluate");
+
+    // Applied even if cancelled, the next search builds on them
+    for (auto &splice : splices) {
+      this->apply(splice);
+    }
+
+    auto result = food::search(m_names, query, previous.get(), [&] {
+      return m_generation != generation;
+    });
+    if (!result) { return; }
+
+    auto rows = food::rank(m_names, *result);
+    auto shared = std::make_shared<food::SearchResult const>(
+        std::move(*result));
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, shared, rows = std::move(rows)]() mutable {
+          this->publish(generation, shared, std::move(rows));
+        },
+        Qt::QueuedConnection);
+  }));
+}
+
+void gui::FoodFilterModel::publish(
+    size_t generation, std::shared_ptr<food::SearchResult const> result,
+    std::vector<size_t> rows)
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodFilterModel::publish");
+
+  if (generation != m_generation) { return; }
+
+  // The source changed while the result was evaluated
+  for (auto const &splice : m_pending) {
+    move_rows(rows, splice.first, splice.removed, splice.names.size());
+  }
+
+  beginResetModel();
+  m_rows = std::move(rows);
+  m_last_result = std::move(result);
+  endResetModel();
+
+  this->set_searching(false);
+}
+
+void gui::FoodFilterModel::apply(Splice &splice)
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodFilterModel::apply");
+
+  size_t const first = std::min(splice.first, m_names.size());
+  size_t const removed = std::min(splice.removed, m_names.size() - first);
+
+  for (auto &name : splice.names) {
+    name = food::fold_case(name);
+  }
+
+  // Changed names are assigned in place, only a difference in size shifts
+  // the names after them
+  size_t const assigned = std::min(removed, splice.names.size());
+  auto const at = begin(m_names) + static_cast<std::ptrdiff_t>(first);
+  auto const names = begin(splice.names);
+  std::move(names, names + static_cast<std::ptrdiff_t>(assigned), at);
+
+  auto const rest = at + static_cast<std::ptrdiff_t>(assigned);
+  if (removed > assigned) {
+    m_names.erase(rest, rest + static_cast<std::ptrdiff_t>(removed - assigned));
+  } else {
+    m_names.insert(rest,
+                   std::make_move_iterator(
+                       names + static_cast<std::ptrdiff_t>(assigned)),
+                   std::make_move_iterator(end(splice.names)));
+  }
+}
+
+auto gui::FoodFilterModel::read_names(int first, int last) const
+    -> std::vector<std::string>
+{
+  std::vector<std::string> names;
+  names.reserve(static_cast<size_t>(std::max(last - first + 1, 0)));
+
+  for (int row = first; row <= last; ++row) {
+    auto const name = m_source->data(m_source->index(row, 0), m_name_role);
+    names.push_back(name.toString().toStdString());
+  }
+
+  return names;
+}
+
+void gui::FoodFilterModel::move_shown_rows(size_t first, size_t removed,
+                                           size_t inserted)
+{
+  auto const is_removed = [=](size_t row) {
+    return !moved_row(row, first, removed, inserted);
+  };
+
+  // Removed back to front, each run of shown rows removed at once
+  size_t row = m_rows.size();
+  while (row > 0) {
+    if (!is_removed(m_rows[row - 1])) {
+      --row;
+      continue;
+    }
+
+    size_t const last = row - 1;
+    while (row > 0 && is_removed(m_rows[row - 1])) {
+      --row;
+    }
+
+    auto const at = begin(m_rows) + static_cast<std::ptrdiff_t>(row);
+    beginRemoveRows(QModelIndex(), static_cast<int>(row),
+                    static_cast<int>(last));
+    m_rows.erase(at, at + static_cast<std::ptrdiff_t>(last - row + 1));
+    endRemoveRows();
+  }
+
+  // The rows left show the same foods, their data did not change
+  move_rows(m_rows, first, removed, inserted);
+}
+
+void gui::FoodFilterModel::on_source_reset()
+{
+  // Shown rows and the search running belong to the old rows of the source
+  ++m_generation;
+
+  beginResetModel();
+  m_rows.clear();
+  m_last_result.reset();
+  endResetModel();
+
+  this->reset_names();
+}
+
+void gui::FoodFilterModel::reset_names()
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodFilterModel::reset_names");
+
+  m_name_role =
+      m_source->roleNames().key("name", static_cast<int>(Qt::DisplayRole));
+
+  // Earlier changes are replaced along with every name
+  m_pending.clear();
+  this->on_source_changed(
+      {0, std::numeric_limits<size_t>::max(),
+       this->read_names(0, m_source->rowCount() - 1)});
+}
+
+void gui::FoodFilterModel::on_rows_inserted(QModelIndex const &parent,
+                                            int first, int last)
+{
+  if (parent.isValid()) { return; }
+
+  this->move_shown_rows(static_cast<size_t>(first), 0,
+                        static_cast<size_t>(last - first + 1));
+  this->on_source_changed(
+      {static_cast<size_t>(first), 0, this->read_names(first, last)});
+}
+
+void gui::FoodFilterModel::on_rows_removed(QModelIndex const &parent,
+                                           int first, int last)
+{
+  if (parent.isValid()) { return; }
+
+  this->move_shown_rows(static_cast<size_t>(first),
+                        static_cast<size_t>(last - first + 1), 0);
+  this->on_source_changed(
+      {static_cast<size_t>(first), static_cast<size_t>(last - first + 1), {}});
+}
+
+void gui::FoodFilterModel::on_data_changed(QModelIndex const &top_left,
+                                           QModelIndex const &bottom_right,
+                                           QVector<int> const &roles)
+{
+  if (!roles.isEmpty() && !roles.contains(m_name_role)) { return; }
+
+  int const first = top_left.row();
+  int const last = bottom_right.row();
+  this->on_source_changed({static_cast<size_t>(first),
+                           static_cast<size_t>(last - first + 1),
+                           this->read_names(first, last)});
+}
+
+void gui::FoodFilterModel::on_source_changed(Splice splice)
+{
+  m_pending.push_back(std::move(splice));
+
+  // Not restarted, a table being loaded is searched as it grows
+  if (!m_refresh.isActive()) { m_refresh.start(); }
+}
+
+void gui::FoodFilterModel::set_searching(bool searching)
+{
+  if (searching == m_searching) { return; }
+
+  m_searching = searching;
+  emit searchingChanged(searching);
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "food/Search.hpp"
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtCore>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gui {
+/**
+ * @brief The rows of a food model whose name contains every word of a query,
+ *        names starting with the first word first
+ *
+ * Queries are evaluated on a worker thread over a copy of the names, so
+ * typing never waits on a search. The copy is kept up to date with the
+ * names of the rows each change of the source touches, only a reset of the
+ * source reads every name again. Every new query cancels the one still
+ * running, and a query that extends the last one (e.g. "chick" after "chi")
+ * only searches the last matches. Results replace the rows in a single model
+ * reset, views never see a half applied result. Rows removed from the
+ * source leave the shown rows right away, the other rows keep showing the
+ * same foods until the next result.
+ *
+ * Usage:
+ * @n FoodFilterModel {
+ * @n   id: filtered
+ * @n   sourceModel: database.model("Food")
+ * @n   query: search.text
+ * @n }
+ * @n TableView { model: filtered }
+ */
+class FoodFilterModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_DISABLE_COPY(FoodFilterModel)
+
+  Q_PROPERTY(QAbstractItemModel *sourceModel READ sourceModel WRITE
+                 setSourceModel NOTIFY sourceModelChanged)
+  Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+  Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged)
+
+public:
+  FoodFilterModel(QObject *parent = nullptr);
+  ~FoodFilterModel() override;
+
+  auto rowCount(QModelIndex const &parent = QModelIndex()) const
+      -> int override;
+  auto data(QModelIndex const &index, int role = Qt::DisplayRole) const
+      -> QVariant override;
+  auto setData(QModelIndex const &index, QVariant const &value,
+               int role = Qt::EditRole) -> bool override;
+  auto flags(QModelIndex const &index) const -> Qt::ItemFlags override;
+  auto roleNames() const -> QHash<int, QByteArray> override;
+
+  auto sourceModel() const -> QAbstractItemModel *;
+  auto query() const -> QString;
+
+  /**
+   * @return true while a query is being evaluated
+   */
+  auto searching() const -> bool;
+
+  void setSourceModel(QAbstractItemModel *source_model);
+  void setQuery(QString const &query);
+
+  /**
+   * @return The row of the source model shown in row, -1 if there is none
+   */
+  Q_INVOKABLE int sourceRow(int row) const;
+
+signals:
+  void sourceModelChanged(QAbstractItemModel *source_model);
+  void queryChanged(QString const &query);
+  void searchingChanged(bool searching);
+
+private:
+  /**
+   * @brief Replaces removed names from first with names, which are not case
+   *        folded yet
+   */
+  struct Splice {
+    size_t first = 0;
+    size_t removed = 0;
+    std::vector<std::string> names;
+  };
+
+  /**
+   * @brief Starts evaluating the query on the worker thread
+   */
+  void search();
+
+  /**
+   * @brief Replaces the rows with a finished result, unless a newer query
+   *        was started since
+   */
+  void publish(size_t generation,
+               std::shared_ptr<food::SearchResult const> result,
+               std::vector<size_t> rows);
+
+  /**
+   * @brief Applies a change of the source to the names, on the worker thread
+   */
+  void apply(Splice &splice);
+
+  /**
+   * @return The names of the source rows from first to last, both included
+   */
+  auto read_names(int first, int last) const -> std::vector<std::string>;
+
+  /**
+   * @brief Replaces every name with the names of the source
+   */
+  void reset_names();
+
+  /**
+   * @brief Moves the shown rows along with rows inserted into or removed
+   *        from the source, removing the shown rows that were removed
+   */
+  void move_shown_rows(size_t first, size_t removed, size_t inserted);
+
+  /**
+   * @brief Clears the shown rows and reads every name again
+   */
+  void on_source_reset();
+
+  void on_rows_inserted(QModelIndex const &parent, int first, int last);
+  void on_rows_removed(QModelIndex const &parent, int first, int last);
+  void on_data_changed(QModelIndex const &top_left,
+                       QModelIndex const &bottom_right,
+                       QVector<int> const &roles);
+
+  /**
+   * @brief Queues a change of the names for the next search, which runs
+   *        from scratch shortly after
+   */
+  void on_source_changed(Splice splice);
+
+  void set_searching(bool searching);
+
+  QPointer<QAbstractItemModel> m_source;
+  QString m_query;
+  bool m_searching = false;
+
+  /**
+   * @brief The rows of the source model shown, in display order
+   */
+  std::vector<size_t> m_rows;
+
+  /**
+   * @brief The role of the source holding the name of a row
+   */
+  int m_name_role = Qt::DisplayRole;
+
+  /**
+   * @brief Changes of the source since the last search started
+   */
+  std::vector<Splice> m_pending;
+
+  /**
+   * @brief The case folded names of the source, only used on the worker
+   *        thread. Searches run one at a time in the order they started,
+   *        each applies the changes made before it.
+   */
+  std::vector<std::string> m_names;
+
+  /**
+   * @brief The last result published, the next query may refine it
+   */
+  std::shared_ptr<food::SearchResult const> m_last_result;
+
+  /**
+   * @brief Incremented for every query, searches for older generations stop
+   */
+  std::atomic<size_t> m_generation{0};
+
+  /**
+   * @brief Coalesces bursts of source changes, like a table being loaded
+   *        chunk by chunk, into one search per refresh delay
+   */
+  QTimer m_refresh;
+
+  QThreadPool m_pool;
+};
+} // namespace gui
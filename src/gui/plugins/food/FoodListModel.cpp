@@ -0,0 +1,285 @@
+#include "gui/plugins/food/FoodListModel.hpp"
+#include "database/utils.hpp"
+#include "food/Macronutrients.hpp"
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief The first chunk is small so the first rows show up right away, each
+ *        chunk after that doubles up to this size
+ */
+size_t const max_chunk_size = 16384;
+size_t const first_chunk_size = 256;
+
+} // namespace
+
+gui::FoodListModel::FoodListModel(QObject *parent) : QAbstractListModel(parent)
+{
+  m_listener = database::utils::Subscription<food::Food>(
+      [this](food::Food const &food, database::utils::Change change) {
+        this->on_food(food, change);
+      });
+
+  if (database::utils::is_cached<food::Food>()) {
+    auto const &all_food = database::utils::retrieve_all<food::Food>();
+    m_rows = static_cast<int>(all_food.size());
+    m_total = all_food.size();
+    m_loaded = true;
+  } else {
+    this->load();
+  }
+}
+
+gui::FoodListModel::~FoodListModel()
+{
+  m_cancelled = true;
+  if (m_loader) { m_loader->wait(); }
+
+  // A partly read table must not pass for the whole table
+  if (!m_loaded) { database::utils::clear_cache<food::Food>(); }
+}
+
+auto gui::FoodListModel::rowCount(QModelIndex const &parent) const -> int
+{
+  if (parent.isValid()) { return 0; }
+  return m_rows;
+}
+
+auto gui::FoodListModel::data(QModelIndex const &index, int role) const
+    -> QVariant
+{
+  if (!index.isValid() || index.row() >= m_rows) { return QVariant(); }
+
+  auto const &food = this->food(index.row());
+
+  switch (role) {
+  case KeyRole:
+    return food.id();
+  case Qt::DisplayRole:
+  case NameRole: {
+    auto const name = food.name();
+    return QString::fromUtf8(name.data(), static_cast<int>(name.size()));
+  }
+  case FatRole:
+    return food.macronutrients().fat();
+  case CarbohydrateRole:
+    return food.macronutrients().carbohydrate();
+  case FiberRole:
+    return food.macronutrients().fiber();
+  case ProteinRole:
+    return food.macronutrients().protein();
+  default:
+    return QVariant();
+  }
+}
+
+auto gui::FoodListModel::setData(QModelIndex const &index,
+                                 QVariant const &value, int role) -> bool
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodListModel::setData");
+
+  if (!m_loaded || !index.isValid() || index.row() >= m_rows) {
+    return false;
+  }
+
+  auto &food = this->food(index.row());
+
+  // The setters update the database, which reports the changed row
+  if (role == NameRole || role == Qt::EditRole) {
+    food.set_name(value.toString().toStdString());
+    return true;
+  }
+
+  bool is_number = false;
+  double const quantity = value.toDouble(&is_number);
+  if (!is_number) { return false; }
+
+  food::Macronutrients macros = food.macronutrients();
+  switch (role) {
+  case FatRole:
+    macros.set_fat(quantity);
+    break;
+  case CarbohydrateRole:
+    macros.set_carbohydrate(quantity);
+    break;
+  case FiberRole:
+    macros.set_fiber(quantity);
+    break;
+  case ProteinRole:
+    macros.set_protein(quantity);
+    break;
+  default:
+    return false;
+  }
+
+  food.set_macronutrients(macros);
+  return true;
+}
+
+auto gui::FoodListModel::flags(QModelIndex const &index) const
+    -> Qt::ItemFlags
+{
+  if (!index.isValid()) { return Qt::NoItemFlags; }
+  if (!m_loaded) { return QAbstractListModel::flags(index); }
+  return QAbstractListModel::flags(index) | Qt::ItemIsEditable;
+}
+
+auto gui::FoodListModel::roleNames() const -> QHash<int, QByteArray>
+{
+  return {{KeyRole, "key"},
+          {NameRole, "name"},
+          {FatRole, "fat"},
+          {CarbohydrateRole, "carbohydrate"},
+          {FiberRole, "fiber"},
+          {ProteinRole, "protein"}};
+}
+
+auto gui::FoodListModel::loaded() const -> bool
+{
+  return m_loaded;
+}
+
+auto gui::FoodListModel::progress() const -> double
+{
+  if (m_loaded) { return 1; }
+
+  size_t const total = m_total;
+  if (total == 0) { return 0; }
+  return std::min(1.0, static_cast<double>(m_rows) / total);
+}
+
+void gui::FoodListModel::load()
+{
+  // Rows are shown as their chunk arrives, retrieve_all must not read the
+  // whole table in the meantime
+  database::utils::cache_chunk<food::Food>({});
+
+  m_loader = QThread::create([this] {
+    TRACKER_TRACE_SCOPE("gui", "FoodListModel::load");
+
+    try {
+      m_total = database::utils::count_rows<food::Food>();
+      QMetaObject::invokeMethod(
+          this, [this] { emit progressChanged(); }, Qt::QueuedConnection);
+
+      int last_id = 0;
+      size_t chunk_size = first_chunk_size;
+      while (!m_cancelled) {
+        auto chunk =
+            database::utils::retrieve_chunk<food::Food>(last_id, chunk_size);
+        if (chunk.empty()) { break; }
+
+        last_id = chunk.back().id();
+        {
+          std::lock_guard lock(m_pending_mutex);
+          m_pending.emplace_back(std::move(chunk));
+        }
+
+        // The cache belongs to the GUI thread
+        QMetaObject::invokeMethod(
+            this, [this] { this->take_chunks(); }, Qt::QueuedConnection);
+
+        chunk_size = std::min(chunk_size * 2, max_chunk_size);
+      }
+    } catch (std::runtime_error const &error) {
+      std::cerr << "Stopped loading foods: " << error.what() << std::endl;
+    }
+
+    QMetaObject::invokeMethod(
+        this, [this] { this->finish_loading(); }, Qt::QueuedConnection);
+  });
+
+  m_loader->setParent(this);
+  m_loader->start();
+}
+
+void gui::FoodListModel::take_chunks()
+{
+  TRACKER_TRACE_SCOPE("gui", "FoodListModel::take_chunks");
+
+  std::vector<food_vector_t> chunks;
+  {
+    std::lock_guard lock(m_pending_mutex);
+    chunks.swap(m_pending);
+  }
+
+  if (chunks.empty()) { return; }
+
+  for (auto &chunk : chunks) {
+    int const count = static_cast<int>(chunk.size());
+
+    beginInsertRows(QModelIndex(), m_rows, m_rows + count - 1);
+    database::utils::cache_chunk<food::Food>(std::move(chunk));
+    m_rows += count;
+    endInsertRows();
+  }
+
+  emit progressChanged();
+}
+
+void gui::FoodListModel::finish_loading()
+{
+  this->take_chunks();
+  m_loader->wait();
+
+  m_loaded = true;
+  emit progressChanged();
+  emit loadedChanged();
+
+  std::clog << "Foods ready after "
+            << trace::milestone("gui", "startup::data_ready") << " ms"
+            << std::endl;
+}
+
+auto gui::FoodListModel::food(int row) const -> food::Food &
+{
+  auto &all_food = database::utils::retrieve_all<food::Food>();
+
+  // Skip over a deleted food that is still being erased
+  bool const is_erasing = static_cast<int>(all_food.size()) > m_rows;
+  if (is_erasing && m_removed_row && row >= *m_removed_row) { ++row; }
+
+  return all_food[row];
+}
+
+auto gui::FoodListModel::row_of(int id) const -> int
+{
+  auto const &all_food = database::utils::retrieve_all<food::Food>();
+
+  auto const compare = [](food::Food const &food, int id) {
+    return food.id() < id;
+  };
+  auto found = std::lower_bound(begin(all_food), end(all_food), id, compare);
+  return static_cast<int>(found - begin(all_food));
+}
+
+void gui::FoodListModel::on_food(food::Food const &food,
+                                 database::utils::Change change)
+{
+  using database::utils::Change;
+
+  int const row = this->row_of(food.id());
+
+  switch (change) {
+  case Change::INSERTED:
+    beginInsertRows(QModelIndex(), row, row);
+    ++m_rows;
+    endInsertRows();
+    break;
+  case Change::UPDATED:
+    emit dataChanged(this->index(row), this->index(row));
+    break;
+  case Change::DELETED:
+    // Called before the food is erased from the cache
+    m_removed_row = row;
+    beginRemoveRows(QModelIndex(), row, row);
+    --m_rows;
+    endRemoveRows();
+    break;
+  }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+
+#include <QAbstractListModel>
+#include <QThread>
+#include <QtCore>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace gui {
+/**
+ * @brief Every food in the database as a list model
+ *
+ * Rows are read straight from the database::utils cache when a delegate asks
+ * for them, so only the visible rows ever exist as QML objects. Changes made
+ * through database::utils are reported as inserted, removed or changed rows.
+ *
+ * If the foods are not cached yet, they are read on a background thread and
+ * inserted a chunk at a time, so the window shows up before the table is
+ * read. Until loaded is true the connection belongs to that thread, edits
+ * are refused and nothing else should use the database.
+ *
+ * Usage:
+ * @n TableView {
+ * @n   model: FoodListModel {}
+ * @n   delegate: TableCell { text: name }
+ * @n }
+ */
+class FoodListModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_DISABLE_COPY(FoodListModel)
+
+  Q_PROPERTY(bool loaded READ loaded NOTIFY loadedChanged)
+  Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+
+public:
+  enum Roles {
+    KeyRole = Qt::UserRole + 1,
+    NameRole,
+    FatRole,
+    CarbohydrateRole,
+    FiberRole,
+    ProteinRole
+  };
+
+  FoodListModel(QObject *parent = nullptr);
+  ~FoodListModel() override;
+
+  auto rowCount(QModelIndex const &parent = QModelIndex()) const
+      -> int override;
+  auto data(QModelIndex const &index, int role = Qt::DisplayRole) const
+      -> QVariant override;
+  auto setData(QModelIndex const &index, QVariant const &value,
+               int role = Qt::EditRole) -> bool override;
+  auto flags(QModelIndex const &index) const -> Qt::ItemFlags override;
+  auto roleNames() const -> QHash<int, QByteArray> override;
+
+  /**
+   * @return true once every food has been read from the database
+   */
+  auto loaded() const -> bool;
+
+  /**
+   * @return The fraction of foods read from the database, from 0 to 1
+   */
+  auto progress() const -> double;
+
+signals:
+  void loadedChanged();
+  void progressChanged();
+
+private:
+  using food_vector_t = std::vector<food::Food, food::Food::Allocator>;
+
+  /**
+   * @brief Starts reading the foods in chunks on a background thread
+   */
+  void load();
+
+  /**
+   * @brief Moves the chunks read so far into the cache and inserts their rows
+   */
+  void take_chunks();
+
+  void finish_loading();
+
+  /**
+   * @return The cached food shown in row
+   */
+  auto food(int row) const -> food::Food &;
+
+  /**
+   * @return The row of the food with id in the cache
+   */
+  auto row_of(int id) const -> int;
+
+  void on_food(food::Food const &food, database::utils::Change change);
+
+  /**
+   * @brief The number of rows views were told about. Differs from the cache
+   *        while a deleted food is being erased from it.
+   */
+  int m_rows = 0;
+
+  /**
+   * @brief The row of a deleted food still in the cache
+   */
+  std::optional<int> m_removed_row;
+
+  database::utils::Subscription<food::Food> m_listener;
+
+  bool m_loaded = false;
+
+  /**
+   * @brief The number of foods in the table, counted by the loading thread
+   */
+  std::atomic<size_t> m_total{0};
+
+  /**
+   * @brief Set to stop the loading thread early
+   */
+  std::atomic<bool> m_cancelled{false};
+
+  QThread *m_loader = nullptr;
+
+  /**
+   * @brief Chunks read by the loading thread, waiting to be cached
+   */
+  std::vector<food_vector_t> m_pending;
+  std::mutex m_pending_mutex;
+};
+} // namespace gui
@@ -1,5 +1,7 @@
 #include "FoodPlugin.hpp"
 #include "Food.hpp"
+#include "FoodFilterModel.hpp"
+#include "FoodListModel.hpp"
 
 #include <qqml.h>
 
@@ -7,4 +9,6 @@ void FoodPlugin::registerTypes(const char *uri)
 {
   // @uri org.example.io
   qmlRegisterType<gui::Food>(uri, 1, 0, "Food");
+  qmlRegisterType<gui::FoodFilterModel>(uri, 1, 0, "FoodFilterModel");
+  qmlRegisterType<gui::FoodListModel>(uri, 1, 0, "FoodListModel");
 }
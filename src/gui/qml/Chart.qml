@@ -0,0 +1,60 @@
+import QtQuick 2.12
+
+import tracker.chart 1.0
+
+// Line chart of a weight or intake series. Drag to pan, scroll to zoom.
+Item {
+    id: root
+    property alias series: points.series
+    property color color: "steelblue"
+
+    ChartModel {
+        id: points
+        pixels: root.width
+        onWindowChanged: canvas.requestPaint()
+    }
+
+    Canvas {
+        id: canvas
+        anchors.fill: parent
+
+        onPaint: {
+            var ctx = getContext("2d");
+            ctx.reset();
+            if (points.count < 2) { return; }
+
+            var xScale = width / (points.xMax - points.xMin);
+            var yRange = (points.yMax - points.yMin) || 1;
+
+            ctx.strokeStyle = root.color;
+            ctx.lineWidth = 1;
+            ctx.beginPath();
+            for (var i = 0; i < points.count; ++i) {
+                var point = points.at(i);
+                var x = (point.x - points.xMin) * xScale;
+                var y = height - (point.y - points.yMin) / yRange * height;
+                if (i === 0) { ctx.moveTo(x, y); } else { ctx.lineTo(x, y); }
+            }
+            ctx.stroke();
+        }
+    }
+
+    MouseArea {
+        anchors.fill: parent
+        property real lastX: 0
+
+        onPressed: lastX = mouse.x
+        onPositionChanged: {
+            var days = (lastX - mouse.x) / width * (points.xMax - points.xMin);
+            points.setRange(points.xMin + days, points.xMax + days);
+            lastX = mouse.x;
+        }
+        onWheel: {
+            var factor = wheel.angleDelta.y > 0 ? 0.8 : 1.25;
+            var center = points.xMin + wheel.x / width * (points.xMax - points.xMin);
+            points.setRange(center - (center - points.xMin) * factor,
+                            center + (points.xMax - center) * factor);
+        }
+        onDoubleClicked: points.showAll()
+    }
+}
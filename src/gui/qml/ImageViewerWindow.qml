@@ -6,6 +6,8 @@ import tracker.food 1.0
 import tracker.database 1.0
 
 ApplicationWindow {
+    property alias foods: filtered.sourceModel
+
     visible: true
     title: qsTr("Tracker")
     background: Rectangle {
@@ -16,21 +18,40 @@ ApplicationWindow {
         id: database
     }
 
+    // Searched on a worker thread as the text changes
+    FoodFilterModel {
+        id: filtered
+        sourceModel: database.model("Food")
+        query: search.text
+    }
+
+    TextField {
+        id: search
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.right: parent.right
+        placeholderText: qsTr("Search foods")
+    }
+
     TableView {
         id: view
-        anchors.fill: parent
+        anchors.top: search.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        height: parent.height / 2 - search.height
         columnWidthProvider: function (column) { return 100; }
         rowHeightProvider: function (column) { return 40; }
 
-        model: database.getData("Food")
+        // Delegates only exist for the visible rows
+        model: filtered
         delegate: Rectangle {
             Row {
                 spacing: 1
-                TableCell { text: modelData.name }
-                TableCell { text: modelData.fat }
-                TableCell { text: modelData.carbohydrate }
-                TableCell { text: modelData.fiber }
-                TableCell { text: modelData.protein }
+                TableCell { text: name }
+                TableCell { text: fat }
+                TableCell { text: carbohydrate }
+                TableCell { text: fiber }
+                TableCell { text: protein }
             }
         }
 
@@ -38,4 +59,13 @@ ApplicationWindow {
         ScrollIndicator.horizontal: ScrollIndicator { width: 10 }
 
     }
+
+    // Foods are read in the background, rows show up as they arrive
+    ProgressBar {
+        anchors.top: view.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        visible: !foods.loaded
+        value: foods.progress
+    }
 }
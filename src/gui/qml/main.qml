@@ -23,7 +23,7 @@ ImageViewerWindow {
         text: qsTr("&Open")
         shortcut: StandardKey.Open
         onTriggered: {
-            utils.foodData[0].name = "not tacos"
+            root.foods.setData(root.foods.index(0, 0), "not tacos")
         }
     }
 
@@ -33,6 +33,31 @@ ImageViewerWindow {
         onTriggered: Qt.quit();
     }
 
+    // The charts read the database on this thread, they are created once the
+    // foods are done loading in the background
+    Loader {
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        height: parent.height / 2
+        active: root.foods.loaded
+
+        sourceComponent: Column {
+            Chart {
+                width: parent.width
+                height: parent.height / 2
+                series: "weight"
+            }
+
+            Chart {
+                width: parent.width
+                height: parent.height / 2
+                series: "intake"
+                color: "darkorange"
+            }
+        }
+    }
+
     menuBar: MenuBar {
         Menu {
             title: qsTr("&File")
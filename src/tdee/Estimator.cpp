@@ -0,0 +1,85 @@
+/**
+ * @file Estimator.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Estimates total daily energy expenditure (TDEE) from daily intake and
+ *        weight, one day at a time
+ */
+
+#include "tdee/Estimator.hpp"
+
+tdee::Estimator::Estimator(Settings settings)
+    : settings_{settings}, tdee_{settings.initial_tdee},
+      variance_{settings.initial_variance}
+{}
+
+void tdee::Estimator::update(Day const &day)
+{
+  ++days_;
+
+  // Predict, the real TDEE drifts a little every day
+  variance_ += settings_.process_variance;
+
+  if (day.intake) {
+    interval_intake_ += *day.intake;
+    ++interval_days_;
+  } else {
+    interval_broken_ = true;
+  }
+
+  if (!day.weight) { return; }
+
+  if (has_weight_) {
+    trend_weight_ += settings_.smoothing * (*day.weight - trend_weight_);
+  } else {
+    trend_weight_ = *day.weight;
+    has_weight_ = true;
+  }
+
+  // Correct with the TDEE implied by the energy balance since the last
+  // weigh-in. Averaging n days divides the measurement noise by n.
+  if (!interval_broken_ && interval_days_ > 0) {
+    double const stored =
+        settings_.kcal_per_kg * (trend_weight_ - interval_weight_);
+    double const implied = (interval_intake_ - stored) / interval_days_;
+    double const noise = settings_.measurement_variance / interval_days_;
+
+    double const gain = variance_ / (variance_ + noise);
+    tdee_ += gain * (implied - tdee_);
+    variance_ *= 1 - gain;
+  }
+
+  interval_weight_ = trend_weight_;
+  interval_intake_ = 0;
+  interval_days_ = 0;
+  interval_broken_ = false;
+}
+
+auto tdee::Estimator::backfill(std::vector<Day> const &days)
+    -> std::vector<Estimate>
+{
+  std::vector<Estimate> estimates;
+  estimates.reserve(days.size());
+
+  for (auto const &day : days) {
+    this->update(day);
+    estimates.push_back(this->estimate());
+  }
+
+  return estimates;
+}
+
+auto tdee::Estimator::estimate() const -> Estimate
+{
+  return {trend_weight_, tdee_, variance_};
+}
+
+auto tdee::Estimator::days() const -> size_t
+{
+  return days_;
+}
+
+auto tdee::Estimator::settings() const -> Settings const &
+{
+  return settings_;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file Trace.cpp
+ * @author Manuel G. Meraz
+ * @date 10/19/2026
+ * @brief Lightweight span recorder that writes Chrome Trace Event json
+ */
+
+#include "trace/Trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The spans of a single thread, oldest spans are overwritten first
+ */
+struct Buffer {
+  /**
+   * @brief Enough for a few seconds of busy database work per thread
+   */
+  static constexpr size_t capacity = 8192;
+
+  std::array<trace::Span, capacity> spans;
+
+  /**
+   * @brief Total number of spans recorded since the last flush
+   */
+  size_t count = 0;
+
+  /**
+   * @brief Only contended while flushing
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief The tid shown in the trace viewer
+   */
+  int thread_id = 0;
+};
+
+auto environment_path() -> char const *
+{
+  return std::getenv("TRACKER_TRACE");
+}
+
+std::atomic<bool> enabled{environment_path() != nullptr};
+
+auto start_time() -> std::chrono::steady_clock::time_point
+{
+  static auto const start = std::chrono::steady_clock::now();
+  return start;
+}
+
+/**
+ * @brief Every buffer ever created, kept alive after their threads exit so
+ *        spans of short lived threads make it into the trace.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Buffer>> buffers;
+};
+
+auto registry() -> Registry &
+{
+  static Registry registry;
+  return registry;
+}
+
+auto thread_buffer() -> Buffer &
+{
+  thread_local std::shared_ptr<Buffer> buffer = [] {
+    auto new_buffer = std::make_shared<Buffer>();
+
+    auto &all = registry();
+    std::lock_guard lock(all.mutex);
+    new_buffer->thread_id = static_cast<int>(all.buffers.size()) + 1;
+    all.buffers.push_back(new_buffer);
+
+    return new_buffer;
+  }();
+
+  return *buffer;
+}
+
+/**
+ * @brief Names and categories are literals from our own code, escape them
+ *        anyway so the json is always valid
+ */
+void write_escaped(std::ofstream &out, char const *text)
+{
+  for (; *text != '\0'; ++text) {
+    if (*text == '"' || *text == '\\') { out << '\\'; }
+    out << *text;
+  }
+}
+
+} // namespace
+
+auto trace::is_enabled() -> bool
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void trace::set_enabled(bool enable)
+{
+  // Pin the start time before the first span begins
+  start_time();
+  enabled.store(enable, std::memory_order_relaxed);
+}
+
+auto trace::now() -> std::int64_t
+{
+  auto const elapsed = std::chrono::steady_clock::now() - start_time();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+void trace::record(Span const &span)
+{
+  auto &buffer = thread_buffer();
+
+  std::lock_guard lock(buffer.mutex);
+  buffer.spans[buffer.count % Buffer::capacity] = span;
+  ++buffer.count;
+}
+
+auto trace::milestone(char const *category, char const *name) -> double
+{
+  auto const end = now();
+  if (is_enabled()) { record({category, name, 0, end}); }
+
+  return static_cast<double>(end) / 1e6;
+}
+
+void trace::flush(std::string const &path)
+{
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("Attempt to open trace file " + path +
+                             " failed!");
+  }
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  auto delimeter = "\n";
+  auto &all = registry();
+  std::lock_guard registry_lock(all.mutex);
+  for (auto const &buffer : all.buffers) {
+    std::lock_guard buffer_lock(buffer->mutex);
+
+    size_t const size = std::min(buffer->count, Buffer::capacity);
+    size_t const first = buffer->count - size;
+    for (size_t i = first; i < buffer->count; ++i) {
+      auto const &span = buffer->spans[i % Buffer::capacity];
+
+      // Chrome trace timestamps are in microseconds
+      out << delimeter << "{\"ph\":\"X\",\"pid\":1,\"tid\":"
+          << buffer->thread_id << ",\"cat\":\"";
+      write_escaped(out, span.category);
+      out << "\",\"name\":\"";
+      write_escaped(out, span.name);
+      out << "\",\"ts\":" << span.begin / 1000.0
+          << ",\"dur\":" << (span.end - span.begin) / 1000.0 << "}";
+
+      delimeter = ",\n";
+    }
+
+    buffer->count = 0;
+  }
+
+  out << "\n]}\n";
+
+  if (!out) {
+    throw std::runtime_error("Attempt to write trace file " + path +
+                             " failed!");
+  }
+}
+
+void trace::flush()
+{
+  char const *path = environment_path();
+  trace::flush(path != nullptr && *path != '\0' ? path : "tracker_trace.json");
+}
@@ -0,0 +1,151 @@
+#include "body/Date.hpp"
+#include "body/WeightEntry.hpp"
+#include "body/WeightRollups.hpp"
+#include "database/Interner.hpp"
+#include "database/utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace body;
+namespace utils = database::utils;
+
+namespace {
+
+class Weight : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<WeightEntry>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<WeightEntry>();
+  }
+};
+
+/**
+ * @brief The summary of every weigh-in from first_day to last_day, computed
+ *        from the cache
+ */
+auto summarize(int first_day, int last_day) -> WeightSummary
+{
+  WeightSummary summary{first_day, last_day, 1e9, -1e9, 0, 0};
+
+  double sum = 0;
+  for (auto const &weight : utils::retrieve_all<WeightEntry>()) {
+    if (weight.day() < first_day || weight.day() > last_day) { continue; }
+
+    summary.min = std::min(summary.min, weight.kg());
+    summary.max = std::max(summary.max, weight.kg());
+    sum += weight.kg();
+    ++summary.count;
+  }
+
+  summary.mean = static_cast<float>(sum / summary.count);
+  return summary;
+}
+
+void expect_matches(std::vector<WeightSummary> const &summaries)
+{
+  for (auto const &summary : summaries) {
+    auto const expected = summarize(summary.first_day, summary.last_day);
+    EXPECT_EQ(summary.count, expected.count)
+        << "Wrong count for " << to_string(to_date(summary.first_day));
+    EXPECT_FLOAT_EQ(summary.min, expected.min);
+    EXPECT_FLOAT_EQ(summary.max, expected.max);
+    EXPECT_FLOAT_EQ(summary.mean, expected.mean);
+  }
+}
+
+} // namespace
+
+TEST(Date, RoundTrip)
+{
+  EXPECT_EQ(to_epoch_day({1970, 1, 1}), 0);
+  EXPECT_EQ(to_epoch_day({2000, 3, 1}), 11017);
+  EXPECT_EQ(to_string(to_date(19000)), "2022-01-08");
+
+  for (int day = -1000; day < 100000; ++day) {
+    ASSERT_EQ(to_epoch_day(to_date(day)), day);
+  }
+
+  EXPECT_FALSE(parse_date("2019/04/01"));
+}
+
+TEST(Date, Buckets)
+{
+  // Monday 2019-04-01 to Sunday 2019-04-07
+  int const monday = to_epoch_day({2019, 4, 1});
+  EXPECT_EQ(WeightRollups::bucket_of(Resolution::WEEK, monday),
+            WeightRollups::bucket_of(Resolution::WEEK, monday + 6));
+  EXPECT_NE(WeightRollups::bucket_of(Resolution::WEEK, monday),
+            WeightRollups::bucket_of(Resolution::WEEK, monday - 1));
+  EXPECT_EQ(WeightRollups::first_day_of(
+                Resolution::WEEK,
+                WeightRollups::bucket_of(Resolution::WEEK, monday + 3)),
+            monday);
+
+  int const month =
+      WeightRollups::bucket_of(Resolution::MONTH, to_epoch_day({2020, 2, 29}));
+  EXPECT_EQ(WeightRollups::first_day_of(Resolution::MONTH, month),
+            to_epoch_day({2020, 2, 1}));
+}
+
+TEST_F(Weight, NameIsItsDay)
+{
+  auto &interner = database::name_interner();
+  size_t const num_interned = interner.size();
+
+  auto &weight = utils::make<WeightEntry>(to_epoch_day({2019, 4, 1}), 80.0f);
+  EXPECT_EQ(weight.name(), "2019-04-01");
+
+  weight.set_name("2019-04-02");
+  EXPECT_EQ(weight.day(), to_epoch_day({2019, 4, 2}));
+  EXPECT_EQ(weight.name(), "2019-04-02");
+  EXPECT_EQ(interner.size(), num_interned)
+      << "Dates must not be interned for good.";
+}
+
+TEST_F(Weight, Rollups)
+{
+  int const first_day = to_epoch_day({2019, 1, 1});
+
+  // Half of the weigh-ins exist before the rollups, half are made after
+  for (int day = 0; day < 60; ++day) {
+    utils::make<WeightEntry>(first_day + day, 80.0f - day * 0.1f);
+  }
+
+  WeightRollups rollups;
+
+  for (int day = 60; day < 120; ++day) {
+    utils::make<WeightEntry>(first_day + day, 74.0f + (day % 5) * 0.3f);
+  }
+
+  auto const months =
+      rollups.summaries(Resolution::MONTH, first_day, first_day + 119);
+  ASSERT_EQ(months.size(), 4) << "Expected January to April.";
+  expect_matches(months);
+  expect_matches(
+      rollups.summaries(Resolution::WEEK, first_day, first_day + 119));
+
+  // Summaries with updated or deleted weigh-ins must be recomputed
+  auto &weights = utils::retrieve_all<WeightEntry>();
+  weights[30].set_kg(60);
+  utils::delete_storable(weights[0]);
+  weights[10].set_day(first_day + 100);
+
+  expect_matches(
+      rollups.summaries(Resolution::MONTH, first_day, first_day + 119));
+  expect_matches(
+      rollups.summaries(Resolution::WEEK, first_day, first_day + 119));
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
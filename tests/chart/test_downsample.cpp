@@ -0,0 +1,171 @@
+#include "chart/Downsample.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace chart;
+
+namespace {
+
+/**
+ * @brief Ten years of daily weights with a single outlier
+ */
+auto make_series() -> std::vector<Point>
+{
+  std::vector<Point> series;
+  for (int day = 0; day < 3650; ++day) {
+    series.push_back({static_cast<double>(day), 80 + std::sin(day / 30.0)});
+  }
+  series[1234].y = 120;
+  return series;
+}
+
+} // namespace
+
+TEST(Lttb, KeepsShape)
+{
+  auto const series = make_series();
+  auto const sampled = lttb(series.data(), series.size(), 100);
+
+  ASSERT_EQ(sampled.size(), 100);
+  EXPECT_DOUBLE_EQ(sampled.front().x, series.front().x);
+  EXPECT_DOUBLE_EQ(sampled.back().x, series.back().x);
+
+  bool has_outlier = false;
+  for (size_t i = 1; i < sampled.size(); ++i) {
+    EXPECT_LT(sampled[i - 1].x, sampled[i].x) << "Points must stay sorted.";
+    has_outlier = has_outlier || sampled[i].y == 120;
+  }
+  EXPECT_TRUE(has_outlier) << "The outlier is the largest triangle.";
+
+  EXPECT_EQ(lttb(series.data(), 50, 100).size(), 50)
+      << "Fewer points than the threshold must be returned as is.";
+}
+
+TEST(Downsampler, OnePointPerPixel)
+{
+  Downsampler downsampler;
+  downsampler.set_points(make_series());
+
+  for (size_t pixels : {10, 200, 800, 5000}) {
+    auto const shown = downsampler.window(100, 3000, pixels);
+
+    size_t inside = 0;
+    for (auto const &point : shown) {
+      if (point.x >= 100 && point.x <= 3000) { ++inside; }
+    }
+
+    EXPECT_LE(inside, pixels) << "More points than pixels at " << pixels;
+    EXPECT_LT(shown.front().x, 100) << "Line must reach the left edge.";
+    EXPECT_GT(shown.back().x, 3000) << "Line must reach the right edge.";
+  }
+}
+
+TEST(Downsampler, PanReusesBuckets)
+{
+  Downsampler downsampler;
+  downsampler.set_points(make_series());
+
+  auto const before = downsampler.window(0, 2000, 300);
+  auto const after = downsampler.window(500, 2500, 300);
+
+  // Same width, so the overlap is downsampled to the same points
+  auto const overlap = [](std::vector<Point> const &points) {
+    std::vector<double> xs;
+    for (auto const &point : points) {
+      if (point.x >= 600 && point.x <= 1900) { xs.push_back(point.x); }
+    }
+    return xs;
+  };
+
+  EXPECT_FALSE(overlap(before).empty());
+  EXPECT_EQ(overlap(before), overlap(after));
+}
+
+TEST(Downsampler, InsertMatchesRebuild)
+{
+  auto series = make_series();
+
+  Downsampler incremental;
+  incremental.set_points(series);
+  incremental.window(0, 3650, 400);
+
+  Point const point{1000.5, 50};
+  incremental.insert(point);
+
+  series.insert(series.begin() + 1001, point);
+  Downsampler rebuilt;
+  rebuilt.set_points(series);
+
+  auto const expected = rebuilt.window(0, 3650, 400);
+  auto const actual = incremental.window(0, 3650, 400);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_DOUBLE_EQ(actual[i].x, expected[i].x);
+    EXPECT_DOUBLE_EQ(actual[i].y, expected[i].y);
+  }
+}
+
+TEST(Downsampler, InsertNextToGap)
+{
+  // A month without weigh-ins, the buckets around it choose their points
+  // with the closest point across it
+  auto series = make_series();
+  series.erase(series.begin() + 1500, series.begin() + 1530);
+
+  Downsampler incremental;
+  incremental.set_points(series);
+  incremental.window(0, 3650, 1000);
+
+  Point const point{1529, 150};
+  incremental.insert(point);
+
+  series.insert(series.begin() + 1500, point);
+  Downsampler rebuilt;
+  rebuilt.set_points(series);
+
+  auto const expected = rebuilt.window(0, 3650, 1000);
+  auto const actual = incremental.window(0, 3650, 1000);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_DOUBLE_EQ(actual[i].x, expected[i].x);
+    EXPECT_DOUBLE_EQ(actual[i].y, expected[i].y);
+  }
+}
+
+TEST(Downsampler, UpdateAndEraseMatchRebuild)
+{
+  auto series = make_series();
+
+  Downsampler incremental;
+  incremental.set_points(series);
+  incremental.window(0, 3650, 400);
+
+  incremental.update({2000, 150});
+  incremental.erase(2500);
+  incremental.update({2500.5, 60});
+
+  series[2000].y = 150;
+  series[2500] = {2500.5, 60};
+  Downsampler rebuilt;
+  rebuilt.set_points(series);
+
+  auto const expected = rebuilt.window(0, 3650, 400);
+  auto const actual = incremental.window(0, 3650, 400);
+
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_DOUBLE_EQ(actual[i].x, expected[i].x);
+    EXPECT_DOUBLE_EQ(actual[i].y, expected[i].y);
+  }
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
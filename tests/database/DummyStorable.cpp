@@ -1,9 +1,11 @@
 #include "DummyStorable.hpp"
 #include "database/Data.hpp"
+#include "database/Memory.hpp"
 #include "database/utils.hpp"
 
 #include <range/v3/all.hpp>
 
+#include <memory_resource>
 #include <sstream>
 #include <unordered_map>
 
@@ -20,12 +22,7 @@ DummyStorable::DummyStorable(
   this->set_data(schema, data);
 }
 
-auto DummyStorable::id() const -> int
-{
-  return this->id_;
-}
-
-auto DummyStorable::name() const -> std::string const
+auto DummyStorable::name() const -> std::string_view
 {
   return this->name_;
 }
@@ -54,15 +51,14 @@ auto DummyStorable::get_data() const -> database::Data const
   column_properties.constraint = database::Constraint::PRIMARY_KEY;
   data.schema.emplace_back(column_properties);
 
-  std::vector<database::Row::row_data_t> new_row;
-  new_row.reserve(num_columns);
+  database::Row new_row;
+  new_row.row_data.reserve(num_columns);
 
   // std::variant to hold multiple data types. Defined in Data.hpp.
   database::Row::row_data_t row_data = this->id();
-  new_row.emplace_back(row_data);
+  new_row.row_data.emplace_back(row_data);
 
   // name column Begin
-  // The name of the table needs to be in single quotes for the SQL command
   column_properties.name = "name";
   column_properties.data_type = database::DataType::TEXT;
 
@@ -70,12 +66,10 @@ auto DummyStorable::get_data() const -> database::Data const
   column_properties.constraint = database::Constraint::NOT_NULL;
   data.schema.emplace_back(column_properties);
 
-  std::stringstream quoted_name;
-  quoted_name << "'" << this->name() << "'";
-  row_data = quoted_name.str();
-  new_row.emplace_back(row_data);
+  row_data = std::string(this->name());
+  new_row.row_data.emplace_back(row_data);
 
-  data.rows.emplace_back(database::Row{new_row});
+  data.rows.emplace_back(std::move(new_row));
 
   return data;
 }
@@ -84,17 +78,17 @@ void DummyStorable::set_data(
     std::vector<database::ColumnProperties> const &schema,
     database::Row const &row)
 {
-  std::unordered_map<std::string_view, database::Row::row_data_t>
-      organized_data;
+  database::StackArena<1024> arena;
+  std::pmr::unordered_map<std::string_view, database::Row::row_data_t const *>
+      organized_data(&arena);
 
-  auto data = row.row_data;
-  for (auto const &[first, second] : ranges::view::zip(schema, data)) {
-    organized_data[first.name] = second;
+  for (auto const &[first, second] : ranges::view::zip(schema, row.row_data)) {
+    organized_data[first.name] = &second;
   }
 
-  this->id_ = std::get<int>(organized_data["DummyStorable_id"]);
+  this->id_ = std::get<int>(*organized_data.at("DummyStorable_id"));
 
-  this->name_ = std::get<std::string>(organized_data["name"]);
+  this->name_ = std::get<std::string>(*organized_data.at("name"));
 }
 
 auto DummyStorable::str() const -> std::string
@@ -8,7 +8,7 @@
 #include <string>
 #include <string_view>
 
-class DummyStorable : public database::Storable {
+class DummyStorable final : public database::Storable {
 public:
   DummyStorable(DummyStorable &&f) = default;
   DummyStorable &operator=(DummyStorable const &f) = default;
@@ -16,8 +16,11 @@ public:
   ~DummyStorable() override = default;
 
   auto get_data() const -> database::Data const override;
-  auto id() const -> int override;
-  auto name() const -> std::string const override;
+  auto id() const -> int override
+  {
+    return this->id_;
+  }
+  auto name() const -> std::string_view override;
   auto str() const -> std::string override;
 
   void set_name(std::string_view name) override;
@@ -0,0 +1,116 @@
+#include "DummyStorable.hpp"
+#include "database/BoundedCache.hpp"
+#include "database/utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace utils = database::utils;
+using Cache = database::BoundedCache<DummyStorable>;
+
+namespace {
+
+class BoundedCache : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<DummyStorable>();
+    for (int i = 1; i <= 10; ++i) {
+      utils::make<DummyStorable>("dummy " + std::to_string(i));
+    }
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<DummyStorable>();
+  }
+};
+
+} // namespace
+
+TEST_F(BoundedCache, FetchesOnDemand)
+{
+  Cache cache(3 * Cache::entry_bytes);
+  EXPECT_EQ(cache.capacity(), 3);
+
+  auto const first = cache.get(1);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->name(), "dummy 1");
+  EXPECT_EQ(cache.misses(), 1);
+
+  EXPECT_EQ(cache.get(1), first);
+  EXPECT_EQ(cache.hits(), 1);
+
+  EXPECT_FALSE(cache.get(11)) << "There is no storable with id 11.";
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(BoundedCache, StaysWithinBudget)
+{
+  Cache cache(3 * Cache::entry_bytes);
+  for (int id = 1; id <= 10; ++id) {
+    cache.get(id);
+  }
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.bytes(), 3 * Cache::entry_bytes);
+
+  cache.set_budget(Cache::entry_bytes);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.bytes(), Cache::entry_bytes);
+}
+
+TEST_F(BoundedCache, RecentlyUsedGetSecondChance)
+{
+  Cache cache(3 * Cache::entry_bytes);
+  cache.get(1);
+  cache.get(2);
+  cache.get(3);
+
+  // Every object was used, the hand goes around once and evicts the first
+  cache.get(4);
+  EXPECT_FALSE(cache.contains(1));
+
+  // 2 is used again before the hand reaches it, 3 is evicted instead
+  cache.get(2);
+  cache.get(5);
+  EXPECT_TRUE(cache.contains(2));
+  EXPECT_FALSE(cache.contains(3));
+}
+
+TEST_F(BoundedCache, PinnedObjectsAreKept)
+{
+  Cache cache(Cache::entry_bytes);
+
+  auto pinned = cache.get(1);
+  cache.get(2);
+  EXPECT_TRUE(cache.contains(1)) << "A held object must not be evicted.";
+  EXPECT_EQ(cache.size(), 2);
+
+  // Released, the cache goes back within budget
+  pinned.reset();
+  cache.get(3);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_TRUE(cache.contains(3));
+}
+
+TEST_F(BoundedCache, ChangesInvalidate)
+{
+  Cache cache(3 * Cache::entry_bytes);
+  auto const before = cache.get(1);
+
+  utils::retrieve_all<DummyStorable>().front().set_name("updated");
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(before->name(), "dummy 1") << "Holders keep the object as it was.";
+  EXPECT_EQ(cache.get(1)->name(), "updated");
+
+  utils::delete_storable(utils::retrieve_all<DummyStorable>().front());
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_FALSE(cache.get(1));
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
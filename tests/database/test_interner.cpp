@@ -0,0 +1,75 @@
+#include "database/Interner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+TEST(Interner, SameViewForEqualStrings)
+{
+  database::Interner interner;
+
+  std::string taco = "taco";
+  auto const first = interner.intern(taco);
+
+  // The view does not point into the string it was made from
+  taco = "burrito";
+  EXPECT_EQ(first, "taco");
+
+  auto const second = interner.intern(std::string("taco"));
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ(interner.size(), 1);
+  EXPECT_EQ(interner.bytes(), 4);
+
+  EXPECT_NE(interner.intern(taco).data(), first.data());
+  EXPECT_EQ(interner.size(), 2);
+
+  EXPECT_TRUE(interner.intern("").empty());
+}
+
+TEST(Interner, ViewsOutliveNewBlocks)
+{
+  database::Interner interner;
+  auto const first = interner.intern("first");
+
+  // Enough strings to fill several blocks, plus one longer than a block
+  for (int i = 0; i < 20000; ++i) {
+    interner.intern("food number " + std::to_string(i));
+  }
+  std::string const long_name(100000, 'x');
+  auto const long_view = interner.intern(long_name);
+  auto const after = interner.intern("after");
+
+  EXPECT_EQ(first, "first");
+  EXPECT_EQ(long_view, long_name);
+  EXPECT_EQ(after, "after");
+  EXPECT_EQ(interner.intern("food number 123"), "food number 123");
+  EXPECT_EQ(interner.size(), 20003);
+}
+
+TEST(Interner, OwnedNamesWhileInScope)
+{
+  auto &interner = database::name_interner();
+  database::OwnedNames names;
+  std::string_view owned;
+  {
+    database::OwnedNames::Scope scope(names);
+    owned = database::intern_name("only in a bounded cache");
+    EXPECT_NE(owned.data(), database::intern_name(owned).data())
+        << "Owned names are not shared.";
+  }
+  EXPECT_EQ(owned, "only in a bounded cache");
+  EXPECT_GE(names.bytes(), 2 * owned.size());
+
+  size_t const num_interned = interner.size();
+  EXPECT_EQ(database::intern_name("interned").data(),
+            interner.intern("interned").data())
+      << "Out of a scope names are interned.";
+  EXPECT_EQ(interner.size(), num_interned + 1);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+#include "database/Database.hpp"
+#include "database/Statement.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+TEST(ByteView, RoundTrip)
+{
+  std::vector<float> const amounts = {0.5f, 12.f, 0.f, 3.25f};
+
+  auto const bytes = database::ByteView::of(amounts);
+  EXPECT_EQ(bytes.size(), amounts.size() * sizeof(float));
+  EXPECT_EQ(bytes.to_vector<float>(), amounts);
+
+  // Trailing bytes that do not make up a whole value are ignored
+  database::ByteView const partial(bytes.data(), bytes.size() - 1);
+  EXPECT_EQ(partial.to_vector<float>().size(), amounts.size() - 1);
+
+  EXPECT_TRUE(database::ByteView().empty());
+  EXPECT_TRUE(database::ByteView().to_vector<float>().empty());
+}
+
+TEST(Statement, Blob)
+{
+  auto &sql_connection = database::Database::get_connection();
+
+  {
+    database::Statement statement(sql_connection,
+                                  "CREATE TABLE IF NOT EXISTS StatementTest "
+                                  "(id INTEGER PRIMARY KEY, name TEXT, "
+                                  "amounts BLOB)");
+    statement.bind({});
+    while (statement.step()) {}
+  }
+
+  std::vector<float> const amounts = {0.5f, 12.f, 0.f, 3.25f};
+  std::vector<database::Row::row_data_t> const values = {
+      1, std::string("Taco's"), database::ByteView::of(amounts)};
+  {
+    database::Statement statement(sql_connection,
+                                  "INSERT INTO StatementTest (id, name, "
+                                  "amounts) VALUES (:id, :name, :amounts)");
+    statement.bind(values);
+    EXPECT_FALSE(statement.step());
+  }
+
+  std::vector<database::Row::row_data_t> const id = {1};
+  {
+    database::Statement statement(
+        sql_connection, "SELECT id, name, amounts FROM StatementTest WHERE "
+                        "id = :id");
+    statement.bind(id);
+
+    ASSERT_TRUE(statement.step());
+    ASSERT_EQ(statement.column_count(), 3);
+    EXPECT_EQ(statement.column_name(2), "amounts");
+    EXPECT_EQ(std::get<int>(statement.column(0)), 1);
+    EXPECT_EQ(std::get<std::string>(statement.column(1)), "Taco's");
+
+    auto const read = std::get<database::ByteView>(statement.column(2));
+    EXPECT_EQ(read.to_vector<float>(), amounts);
+
+    EXPECT_FALSE(statement.step());
+  }
+
+  database::Statement statement(sql_connection, "DROP TABLE StatementTest");
+  statement.bind({});
+  while (statement.step()) {}
+}
+
+TEST(Statement, Timestamp)
+{
+  auto &sql_connection = database::Database::get_connection();
+
+  {
+    database::Statement statement(sql_connection,
+                                  "CREATE TABLE IF NOT EXISTS TimestampTest "
+                                  "(id INTEGER PRIMARY KEY, eaten TIMESTAMP)");
+    statement.bind({});
+    while (statement.step()) {}
+  }
+
+  // Before the epoch, before and after 2038
+  std::vector<database::Timestamp> const times = {
+      {-86400}, {1554076800}, {4102444800}};
+  for (size_t i = 0; i < times.size(); ++i) {
+    std::vector<database::Row::row_data_t> const values = {
+        static_cast<int>(i) + 1, times[i]};
+    database::Statement statement(sql_connection,
+                                  "INSERT INTO TimestampTest (id, eaten) "
+                                  "VALUES (:id, :eaten)");
+    statement.bind(values);
+    statement.step();
+  }
+
+  // Compared as integers, not as text
+  std::vector<database::Row::row_data_t> const bounds = {
+      database::Timestamp{0}, database::Timestamp{4102444801}};
+  {
+    database::Statement statement(
+        sql_connection, "SELECT eaten, typeof(eaten) FROM TimestampTest "
+                        "WHERE eaten >= :lower AND eaten < :upper "
+                        "ORDER BY eaten");
+    statement.bind(bounds);
+
+    std::vector<database::Timestamp> read;
+    while (statement.step()) {
+      read.push_back(std::get<database::Timestamp>(statement.column(0)));
+      EXPECT_EQ(std::get<std::string>(statement.column(1)), "integer");
+    }
+    EXPECT_EQ(read, (std::vector<database::Timestamp>{times[1], times[2]}));
+  }
+
+  database::Statement statement(sql_connection, "DROP TABLE TimestampTest");
+  statement.bind({});
+  while (statement.step()) {}
+
+  static_assert(database::Timestamp{86399}.day() == 0);
+  static_assert(database::Timestamp{86400}.day() == 1);
+  static_assert(database::Timestamp{-1}.day() == -1);
+  static_assert(database::Timestamp{-86400}.day() == -1);
+  static_assert(database::Timestamp{1} < database::Timestamp{2});
+}
+
+TEST(Statement, DeclaredTypesIgnoreCase)
+{
+  auto &sql_connection = database::Database::get_connection();
+
+  {
+    database::Statement statement(sql_connection,
+                                  "CREATE TABLE IF NOT EXISTS KindTest "
+                                  "(eaten Timestamp, total bigInt, count int)");
+    statement.bind({});
+    while (statement.step()) {}
+  }
+  {
+    database::Statement statement(sql_connection,
+                                  "INSERT INTO KindTest VALUES (1, 2, 3), "
+                                  "(4, 5, 6)");
+    statement.bind({});
+    while (statement.step()) {}
+  }
+  {
+    // The kinds read on the first row hold for the next ones
+    database::Statement statement(sql_connection,
+                                  "SELECT * FROM KindTest ORDER BY eaten");
+    statement.bind({});
+    for (int first : {1, 4}) {
+      ASSERT_TRUE(statement.step());
+      EXPECT_EQ(std::get<database::Timestamp>(statement.column(0)).seconds,
+                first);
+      EXPECT_EQ(std::get<long long>(statement.column(1)), first + 1);
+      EXPECT_EQ(std::get<int>(statement.column(2)), first + 2);
+    }
+  }
+
+  database::Statement statement(sql_connection, "DROP TABLE KindTest");
+  statement.bind({});
+  while (statement.step()) {}
+}
+
+TEST(Statement, Errors)
+{
+  auto &sql_connection = database::Database::get_connection();
+
+  EXPECT_THROW(database::Statement(sql_connection, "SELEC 1"),
+               std::runtime_error);
+
+  database::Statement statement(sql_connection, "SELECT :value");
+  EXPECT_THROW(statement.bind({}), std::runtime_error);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+TEST(Statement, BindsRowInPlace)
+{
+  auto &sql_connection = database::Database::get_connection();
+
+  {
+    database::Statement statement(sql_connection,
+                                  "CREATE TABLE IF NOT EXISTS StatementTest "
+                                  "(id INTEGER PRIMARY KEY, name TEXT)");
+    statement.bind({});
+    while (statement.step()) {}
+  }
+
+  database::Row row;
+  row.row_data.emplace_back(1);
+  row.row_data.emplace_back(std::string("Taco's"));
+  {
+    database::Statement statement(sql_connection,
+                                  "INSERT INTO StatementTest (id, name) "
+                                  "VALUES (:id, :name)");
+    statement.bind(row.row_data);
+    EXPECT_FALSE(statement.step());
+  }
+
+  // Numbered placeholders bind the columns of the row out of order
+  row.row_data[1] = std::string("Burrito");
+  {
+    database::Statement statement(sql_connection,
+                                  "UPDATE StatementTest SET name = ?2 "
+                                  "WHERE id = ?1");
+    statement.bind(row.row_data);
+    EXPECT_FALSE(statement.step());
+  }
+
+  {
+    database::Statement statement(sql_connection,
+                                  "SELECT name FROM StatementTest WHERE "
+                                  "id = :id");
+    statement.bind({1});
+
+    ASSERT_TRUE(statement.step());
+    EXPECT_EQ(std::get<std::string>(statement.column(0)), "Burrito");
+  }
+
+  database::Statement statement(sql_connection, "DROP TABLE StatementTest");
+  statement.bind({});
+  while (statement.step()) {}
+}
@@ -1,10 +1,21 @@
 #include "DummyStorable.hpp"
 #include "database/Data.hpp"
+#include "database/Memory.hpp"
+#include "database/SlowQueryLog.hpp"
 #include "database/utils.hpp"
 
 #include <gtest/gtest.h>
 #include <range/v3/all.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace utils = database::utils;
@@ -117,9 +128,11 @@ TEST_F(Utils, Enums)
   std::vector<std::string_view> enum_strings = {
       utils::enum_to_string(database::DataType::REAL),
       utils::enum_to_string(database::DataType::INTEGER),
+      utils::enum_to_string(database::DataType::BIGINT),
       utils::enum_to_string(database::DataType::TEXT),
       utils::enum_to_string(database::DataType::NULL_),
       utils::enum_to_string(database::DataType::BLOB),
+      utils::enum_to_string(database::DataType::TIMESTAMP),
       utils::enum_to_string(database::Constraint::PRIMARY_KEY),
       utils::enum_to_string(database::Constraint::UNIQUE),
       utils::enum_to_string(database::Constraint::NOT_NULL),
@@ -127,8 +140,8 @@ TEST_F(Utils, Enums)
   };
 
   std::vector<std::string_view> expected_values = {
-      "REAL",        "INTEGER", "TEXT",     "NULL", "BLOB",
-      "PRIMARY KEY", "UNIQUE",  "NOT NULL", "CHECK"};
+      "REAL",      "INTEGER",     "BIGINT", "TEXT",     "NULL", "BLOB",
+      "TIMESTAMP", "PRIMARY KEY", "UNIQUE", "NOT NULL", "CHECK"};
 
   for (auto const &[enum_string, expected] :
        ranges::view::zip(enum_strings, expected_values)) {
@@ -144,6 +157,162 @@ TEST_F(Utils, TypeToString)
       << "expected: DummyStorable type_to_string: " << type_string;
 }
 
+TEST_F(Utils, TableName)
+{
+  static_assert(utils::table_name<DummyStorable>() == "DummyStorable");
+  static_assert(utils::enum_to_string(database::DataType::NULL_) == "NULL");
+}
+
+TEST_F(Utils, BoundValues)
+{
+  // Values are bound rather than written into the statement, quotes are
+  // stored as they are
+  auto &storable = utils::make<DummyStorable>("chef's salad");
+  storable.set_name("it's 'quoted'");
+
+  utils::clear_cache<DummyStorable>();
+  auto const &all_storables = utils::retrieve_all<DummyStorable>();
+  ASSERT_EQ(all_storables.size(), 1u);
+  EXPECT_EQ(all_storables.front().name(), "it's 'quoted'");
+}
+
+TEST_F(Utils, ParallelLoad)
+{
+  size_t const num_rows = 4 * database::utils::detail::min_partition_rows;
+  {
+    soci::transaction transaction(database::Database::get_connection());
+    for (size_t i = 0; i < num_rows; ++i) {
+      utils::make<DummyStorable>("dummy " + std::to_string(i + 1));
+    }
+    transaction.commit();
+  }
+
+  // A gap in the ids leaves one partition short
+  auto &all_storables = utils::retrieve_all<DummyStorable>();
+  for (int i = 0; i < 100; ++i) {
+    utils::delete_storable(all_storables[1000]);
+  }
+
+  utils::clear_cache<DummyStorable>();
+  utils::set_load_threads(4);
+  auto const &loaded = utils::retrieve_all<DummyStorable>();
+  utils::set_load_threads(1);
+
+  ASSERT_EQ(loaded.size(), num_rows - 100);
+  for (size_t i = 1; i < loaded.size(); ++i) {
+    ASSERT_LT(loaded[i - 1].id(), loaded[i].id()) << "Ids must stay sorted";
+  }
+  EXPECT_EQ(loaded.front().name(), "dummy 1");
+  EXPECT_EQ(loaded.back().name(), "dummy " + std::to_string(num_rows));
+}
+
+TEST_F(Utils, ParallelLoadExplainsSlowQueries)
+{
+  size_t const num_rows = 2 * database::utils::detail::min_partition_rows;
+  {
+    soci::transaction transaction(database::Database::get_connection());
+    for (size_t i = 0; i < num_rows; ++i) {
+      utils::make<DummyStorable>("dummy");
+    }
+    transaction.commit();
+  }
+
+  // Every statement is slow, each partition explains its own on its thread
+  auto const settings = database::SlowQueryLog::settings();
+  database::SlowQueryLog::Settings every_query = settings;
+  every_query.threshold = std::chrono::microseconds(0);
+  every_query.path = "test_utils_slow_queries.log";
+  std::remove(every_query.path.c_str());
+  database::SlowQueryLog::configure(every_query);
+
+  utils::clear_cache<DummyStorable>();
+  utils::set_load_threads(2);
+  auto const &loaded = utils::retrieve_all<DummyStorable>();
+  utils::set_load_threads(1);
+  database::SlowQueryLog::configure(settings);
+
+  EXPECT_EQ(loaded.size(), num_rows);
+
+  std::ifstream log(every_query.path);
+  std::string const text((std::istreambuf_iterator<char>(log)),
+                         std::istreambuf_iterator<char>());
+  EXPECT_EQ(text.find("EXPLAIN QUERY PLAN failed"), std::string::npos)
+      << text;
+  EXPECT_NE(text.find("USING INTEGER PRIMARY KEY"), std::string::npos)
+      << "The id range of a partition is not explained: " << text;
+  std::remove(every_query.path.c_str());
+}
+
+TEST_F(Utils, RetrieveChunk)
+{
+  for (size_t i = 0; i < 25; ++i) {
+    utils::make<DummyStorable>("dummy");
+  }
+
+  // Stream the table back in the way a background loader would
+  utils::clear_cache<DummyStorable>();
+  utils::cache_chunk<DummyStorable>({});
+  EXPECT_TRUE(utils::is_cached<DummyStorable>());
+  EXPECT_TRUE(utils::retrieve_all<DummyStorable>().empty())
+      << "Nothing should be read before the first chunk is cached";
+
+  int last_id = 0;
+  size_t num_chunks = 0;
+  auto chunk = utils::retrieve_chunk<DummyStorable>(last_id, 10);
+  while (!chunk.empty()) {
+    EXPECT_LE(chunk.size(), 10);
+    EXPECT_GT(chunk.front().id(), last_id);
+
+    last_id = chunk.back().id();
+    utils::cache_chunk<DummyStorable>(std::move(chunk));
+    chunk = utils::retrieve_chunk<DummyStorable>(last_id, 10);
+    ++num_chunks;
+  }
+
+  EXPECT_EQ(num_chunks, 3);
+
+  auto const &all_storables = utils::retrieve_all<DummyStorable>();
+  ASSERT_EQ(all_storables.size(), 25);
+  for (size_t i = 0; i < all_storables.size(); ++i) {
+    EXPECT_EQ(all_storables[i].id(), static_cast<int>(i + 1));
+  }
+
+  // Caching the first chunk again would leave the cache unsorted
+  EXPECT_THROW(utils::cache_chunk<DummyStorable>(
+                   utils::retrieve_chunk<DummyStorable>(0, 10)),
+               std::runtime_error);
+}
+
+TEST(Storable, IsStorable)
+{
+  EXPECT_TRUE(database::is_storable_v<DummyStorable>);
+  EXPECT_FALSE(database::is_storable_v<int>);
+  EXPECT_FALSE(database::is_storable_v<database::Row>);
+
+  // The interface alone has no cache to be stored in
+  EXPECT_FALSE(database::is_storable_v<database::Storable>);
+}
+
+TEST(Memory, RowsShareTheirArena)
+{
+  std::pmr::monotonic_buffer_resource arena;
+  std::pmr::vector<database::Row> rows(&arena);
+
+  auto &row = rows.emplace_back();
+  row.row_data.emplace_back(1);
+  EXPECT_EQ(row.row_data.get_allocator().resource(), &arena);
+
+  // Growing the vector moves rows into the arena instead of copying them out
+  rows.resize(100);
+  EXPECT_EQ(rows.front().row_data.get_allocator().resource(), &arena);
+  EXPECT_EQ(std::get<int>(rows.front().row_data.front()), 1);
+
+  // Copies outside of a container go back to the default resource
+  database::Row const copy = rows.front();
+  EXPECT_EQ(copy.row_data.get_allocator().resource(),
+            std::pmr::get_default_resource());
+}
+
 TEST_F(Utils, Update)
 {
   auto &all_storables = utils::retrieve_all<DummyStorable>();
@@ -157,11 +326,142 @@ TEST_F(Utils, Update)
 
   all_storables = utils::retrieve_all<DummyStorable>();
   for (auto &storable : all_storables) {
-    std::string const name = storable.name();
+    std::string const name(storable.name());
     EXPECT_EQ(name, "updated") << "expected: updated  actual: " << name;
   }
 }
 
+TEST_F(Utils, UpdateCopy)
+{
+  utils::make<DummyStorable>("dummy");
+  utils::make<DummyStorable>("dummy");
+
+  // A copy read past the cache, updated through set_name
+  auto copies = utils::retrieve_range<DummyStorable>("DummyStorable_id", 2, 3);
+  ASSERT_EQ(copies.size(), 1u);
+  copies.front().set_name("copied");
+
+  auto const &all_storables = utils::retrieve_all<DummyStorable>();
+  EXPECT_EQ(all_storables.back().name(), "copied")
+      << "The cached object must follow its updated copy.";
+  EXPECT_EQ(all_storables.front().name(), "dummy");
+}
+
+TEST_F(Utils, RetrieveRangeChecksColumn)
+{
+  utils::make<DummyStorable>("dummy");
+
+  EXPECT_EQ(utils::retrieve_range<DummyStorable>("name", "a", "z").size(), 1u);
+  EXPECT_THROW(utils::retrieve_range<DummyStorable>("grams", 0, 1),
+               std::runtime_error);
+  EXPECT_THROW(utils::retrieve_range<DummyStorable>(
+                   "name >= '' OR name", "a", "z"),
+               std::runtime_error)
+      << "Only a column name may be written into the statement.";
+}
+
+TEST_F(Utils, Subscription)
+{
+  size_t num_changes = 0;
+
+  utils::Subscription<DummyStorable> subscription(
+      [&num_changes](DummyStorable const &, utils::Change) { ++num_changes; });
+  utils::make<DummyStorable>("dummy");
+  EXPECT_EQ(num_changes, 1);
+
+  {
+    // Moved from subscriptions must not unsubscribe the listener
+    auto const moved = std::move(subscription);
+    utils::make<DummyStorable>("dummy");
+    EXPECT_EQ(num_changes, 2);
+  }
+
+  utils::make<DummyStorable>("dummy");
+  EXPECT_EQ(num_changes, 2) << "Listener must be gone with its subscription.";
+}
+
+TEST_F(Utils, FailedBatchRollsBackCaches)
+{
+  int const kept_id = utils::make<DummyStorable>("kept").id();
+  int const deleted_id = utils::make<DummyStorable>("deleted").id();
+
+  std::vector<utils::Change> changes;
+  utils::Subscription<DummyStorable> const subscription(
+      [&changes](DummyStorable const &, utils::Change change) {
+        changes.push_back(change);
+      });
+
+  auto const &all_storables = utils::retrieve_all<DummyStorable>();
+  auto const find = [&all_storables](int id) {
+    return std::find_if(
+        begin(all_storables), end(all_storables),
+        [id](DummyStorable const &storable) { return storable.id() == id; });
+  };
+
+  EXPECT_THROW(utils::batch([&] {
+                 utils::make<DummyStorable>("made");
+                 utils::retrieve_all<DummyStorable>().front().set_name(
+                     "renamed");
+                 utils::delete_storable(*find(deleted_id));
+                 throw std::runtime_error("failed");
+               }),
+               std::runtime_error);
+
+  ASSERT_EQ(all_storables.size(), 2u) << "Made object must leave the cache.";
+  EXPECT_EQ(find(kept_id)->name(), "kept") << "Update must be undone.";
+  EXPECT_NE(find(deleted_id), end(all_storables))
+      << "Deleted object must be back in the cache.";
+  EXPECT_EQ(utils::count_rows<DummyStorable>(), 2u);
+
+  // Listeners are told about every change undone, most recent first
+  std::vector<utils::Change> const expected = {
+      utils::Change::INSERTED, utils::Change::UPDATED,
+      utils::Change::DELETED,  utils::Change::INSERTED,
+      utils::Change::UPDATED,  utils::Change::DELETED};
+  EXPECT_EQ(changes, expected);
+
+  // Nothing is left to undo for the next batch
+  utils::batch([&] { utils::make<DummyStorable>("made"); });
+  EXPECT_EQ(utils::count_rows<DummyStorable>(), 3u);
+  EXPECT_EQ(all_storables.size(), 3u);
+}
+
+TEST_F(Utils, SubscribeWhileNotifying)
+{
+  size_t num_removed_changes = 0;
+  size_t num_added_changes = 0;
+
+  utils::Subscription<DummyStorable> removed;
+  utils::Subscription<DummyStorable> added;
+  bool is_added = false;
+
+  // Removes the listener after it and adds a new one on the first change
+  utils::Subscription<DummyStorable> const subscription(
+      [&](DummyStorable const &, utils::Change) {
+        removed.reset();
+        if (is_added) { return; }
+        is_added = true;
+        added = utils::Subscription<DummyStorable>(
+            [&num_added_changes](DummyStorable const &, utils::Change) {
+              ++num_added_changes;
+            });
+      });
+
+  removed = utils::Subscription<DummyStorable>(
+      [&num_removed_changes](DummyStorable const &, utils::Change) {
+        ++num_removed_changes;
+      });
+
+  utils::make<DummyStorable>("dummy");
+  EXPECT_EQ(num_removed_changes, 0) << "Removed listeners must not be called.";
+  EXPECT_EQ(num_added_changes, 0)
+      << "Added listeners must wait for the next change.";
+
+  utils::make<DummyStorable>("dummy");
+  EXPECT_EQ(num_removed_changes, 0);
+  EXPECT_EQ(num_added_changes, 1);
+}
+
 auto main(int argc, char **argv) -> int
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,159 @@
+#include "database/Database.hpp"
+#include "database/Interner.hpp"
+#include "database/utils.hpp"
+#include "food/Entry.hpp"
+#include "food/Food.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+class Diary : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+};
+
+// 2040-01-01T00:00:00Z, past the 32 bit limit
+constexpr std::time_t day = 2208988800;
+
+} // namespace
+
+TEST_F(Diary, MakeAndName)
+{
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+  auto &entry = utils::make<Entry>(taco.id(), 150.0, day, Meal::LUNCH);
+
+  EXPECT_EQ(entry.id(), 1) << "First entry must have an id of 1.";
+  EXPECT_EQ(entry.name(), "taco") << "Entry name is the name of its food.";
+
+  utils::clear_cache<Entry>();
+  auto const &entries = utils::retrieve_all<Entry>();
+  ASSERT_EQ(entries.size(), 1);
+  EXPECT_EQ(entries.front().timestamp(), day)
+      << "Timestamp past 2038 did not survive a round trip.";
+  EXPECT_EQ(entries.front().meal(), Meal::LUNCH);
+  EXPECT_DOUBLE_EQ(entries.front().grams(), 150);
+}
+
+TEST_F(Diary, RenamedFoodOwnsItsName)
+{
+  auto &interner = database::name_interner();
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+
+  size_t const num_interned = interner.size();
+  taco.set_name("fish taco");
+  taco.set_name("shrimp taco");
+
+  EXPECT_EQ(taco.name(), "shrimp taco");
+  EXPECT_EQ(interner.size(), num_interned)
+      << "Renamed foods must not intern their names for good.";
+
+  utils::clear_cache<Food>();
+  EXPECT_EQ(utils::retrieve_all<Food>().front().name(), "shrimp taco");
+}
+
+TEST_F(Diary, EntriesBetween)
+{
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+
+  // Three entries a day for ten days, made out of order
+  for (int d = 9; d >= 0; --d) {
+    for (int meal = 0; meal < 3; ++meal) {
+      utils::make<Entry>(taco.id(), 100.0, day + d * 86400 + meal * 3600,
+                         static_cast<Meal>(meal));
+    }
+  }
+
+  auto const third_day = entries_between(day + 2 * 86400, day + 3 * 86400);
+  ASSERT_EQ(third_day.size(), 3) << "Expected the entries of a single day.";
+
+  for (size_t i = 0; i < third_day.size(); ++i) {
+    EXPECT_EQ(third_day[i].timestamp(),
+              day + 2 * 86400 + static_cast<std::time_t>(i) * 3600)
+        << "Entries must be sorted by timestamp.";
+  }
+
+  EXPECT_TRUE(entries_between(day - 86400, day).empty())
+      << "End of range must be exclusive.";
+  EXPECT_EQ(entries_between(day, day + 10 * 86400).size(), 30);
+}
+
+TEST_F(Diary, RangeCopiesUpdateTheCache)
+{
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+  utils::make<Entry>(taco.id(), 100.0, day, Meal::LUNCH);
+  auto const &entries = utils::retrieve_all<Entry>();
+
+  auto today = entries_between(day, day + 86400);
+  ASSERT_EQ(today.size(), 1);
+  today.front().set_grams(250);
+  today.front().set_meal(Meal::DINNER);
+
+  EXPECT_DOUBLE_EQ(entries.front().grams(), 250)
+      << "The cached entry was left behind by its copy.";
+  EXPECT_EQ(entries.front().meal(), Meal::DINNER);
+  EXPECT_EQ(entries.front().timestamp(), day);
+}
+
+TEST_F(Diary, RangeUsesCoveringIndex)
+{
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+  utils::make<Entry>(taco.id(), 100.0, day, Meal::BREAKFAST);
+
+  auto &sql_connection = database::Database::get_connection();
+
+  soci::row step;
+  soci::statement statement =
+      (sql_connection.prepare
+           << "EXPLAIN QUERY PLAN SELECT * FROM Entry WHERE timestamp >= 0 "
+              "AND timestamp < 1 ORDER BY timestamp",
+       soci::into(step));
+  statement.execute();
+
+  std::string plan;
+  while (statement.fetch()) {
+    plan += step.get<std::string>(step.size() - 1);
+  }
+
+  EXPECT_NE(plan.find("COVERING INDEX Entry_timestamp"), std::string::npos)
+      << "Range query does not seek the covering index: " << plan;
+}
+
+TEST_F(Diary, IndexAddedToExistingTable)
+{
+  auto &taco = utils::make<Food>("taco", Macronutrients());
+  utils::make<Entry>(taco.id(), 100.0, day, Meal::BREAKFAST);
+
+  // A diary from before the index existed
+  utils::execute("DROP INDEX Entry_timestamp", {}, "Failed to drop index");
+  utils::clear_cache<Entry>();
+
+  utils::retrieve_all<Entry>();
+
+  int indexes = 0;
+  utils::execute("SELECT count(*) FROM sqlite_master WHERE type = 'index' "
+                 "AND name = 'Entry_timestamp'",
+                 {}, "Failed to count indexes", soci::into(indexes));
+  EXPECT_EQ(indexes, 1) << "Index must be made on first use of the table.";
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+#include "database/utils.hpp"
+#include "food/DailyTotals.hpp"
+#include "food/Entry.hpp"
+#include "food/Food.hpp"
+#include "food/IntakeRollup.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+class Rollup : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+};
+
+// 2019-04-01T00:00:00Z
+constexpr std::time_t april_first = 1554076800;
+
+} // namespace
+
+TEST(DailyTotals, MatchesLinearSum)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<long long> random_day(-50, 400);
+  std::uniform_real_distribution<double> random_grams(0, 100);
+
+  DailyTotals totals;
+  std::vector<double> fat(451);
+
+  // Days are added in random order so the tree grows in both directions
+  for (size_t i = 0; i < 2000; ++i) {
+    long long const day = random_day(generator);
+    double const grams = random_grams(generator);
+
+    totals.add(day, Macronutrients(Fat(grams), Carbohydrate(), Protein()));
+    fat[day + 50] += grams;
+  }
+
+  for (long long first = -60; first < 410; first += 37) {
+    for (long long last = first; last < 420; last += 53) {
+      double expected = 0;
+      for (long long day = std::max(first, -50LL); day <= std::min(last, 400LL);
+           ++day) {
+        expected += fat[day + 50];
+      }
+
+      EXPECT_NEAR(totals.total(first, last).fat(), expected, 1e-6)
+          << "Wrong total from day " << first << " to " << last;
+    }
+  }
+
+  EXPECT_NEAR(totals.day(7).fat(), fat[57], 1e-9);
+  EXPECT_EQ(totals.total(5, 4).fat(), 0) << "Empty range must be nothing.";
+}
+
+TEST(DailyTotals, Subtract)
+{
+  DailyTotals totals;
+  Macronutrients const macros(Fat(1), Carbohydrate(2, Fiber(1)), Protein(3));
+
+  totals.add(10, macros);
+  totals.add(12, macros);
+  totals.subtract(10, macros);
+
+  EXPECT_DOUBLE_EQ(totals.total(0, 20).protein(), 3);
+  EXPECT_DOUBLE_EQ(totals.total(0, 11).protein(), 0);
+}
+
+TEST(DailyTotals, FarDaysAreNotCovered)
+{
+  DailyTotals totals;
+  Macronutrients const macros(Fat(1), Carbohydrate(2, Fiber(1)), Protein(3));
+  long long const far_day = 1000000000;
+
+  // A mistyped year must not cover the billion days in between
+  totals.add(0, macros);
+  totals.add(far_day, macros);
+  totals.add(-far_day, macros);
+
+  EXPECT_DOUBLE_EQ(totals.day(far_day).protein(), 3);
+  EXPECT_DOUBLE_EQ(totals.total(-far_day, far_day).protein(), 9);
+  EXPECT_DOUBLE_EQ(totals.total(1, far_day).protein(), 3);
+  EXPECT_DOUBLE_EQ(totals.total(1, far_day - 1).protein(), 0);
+
+  // Covering up to a day that was not covered moves it into the covered days
+  long long const later = DailyTotals::max_covered_days - 1;
+  totals.add(later, macros);
+  totals.add(later / 2, macros);
+  totals.subtract(later, macros);
+
+  EXPECT_DOUBLE_EQ(totals.day(later).protein(), 0);
+  EXPECT_DOUBLE_EQ(totals.total(0, later).protein(), 6);
+  EXPECT_DOUBLE_EQ(totals.total(-far_day, far_day).protein(), 12);
+}
+
+TEST_F(Rollup, FollowsDiary)
+{
+  auto &rice = utils::make<Food>(
+      "rice", Macronutrients(Fat(0), Carbohydrate(80, Fiber(0)), Protein(10)));
+
+  utils::make<Entry>(rice.id(), 200.0, april_first, Meal::LUNCH);
+
+  IntakeRollup rollup;
+  long long const first_day = rollup.day_of(april_first);
+
+  EXPECT_DOUBLE_EQ(rollup.total(first_day, first_day).carbohydrate(), 160)
+      << "Existing entries must be loaded on construction.";
+
+  auto &dinner = utils::make<Entry>(rice.id(), 100.0,
+                                    april_first + 7 * 86400, Meal::DINNER);
+  EXPECT_DOUBLE_EQ(rollup.total(first_day, first_day + 6).carbohydrate(), 160);
+  EXPECT_DOUBLE_EQ(rollup.total(first_day, first_day + 7).carbohydrate(), 240)
+      << "Made entry is missing from the totals.";
+
+  dinner.set_grams(50);
+  EXPECT_DOUBLE_EQ(rollup.total(first_day, first_day + 7).carbohydrate(), 200)
+      << "Updated entry is not reflected in the totals.";
+
+  rice.set_macronutrients(
+      Macronutrients(Fat(0), Carbohydrate(40, Fiber(0)), Protein(10)));
+  EXPECT_DOUBLE_EQ(rollup.total(first_day, first_day + 7).carbohydrate(), 100)
+      << "Changed food is not reflected in the totals.";
+
+  utils::delete_storable(dinner);
+  EXPECT_NEAR(rollup.total(first_day + 1, first_day + 7).carbohydrate(), 0,
+              1e-9)
+      << "Deleted entry is still in the totals.";
+}
+
+TEST_F(Rollup, PassesOnChangedDays)
+{
+  auto &rice = utils::make<Food>(
+      "rice", Macronutrients(Fat(0), Carbohydrate(80, Fiber(0)), Protein(10)));
+
+  IntakeRollup rollup;
+  long long const first_day = rollup.day_of(april_first);
+
+  std::vector<std::vector<long long>> changes;
+  rollup.set_listener([&changes](std::vector<long long> const &days) {
+    changes.push_back(days);
+  });
+
+  auto &lunch = utils::make<Entry>(rice.id(), 200.0, april_first, Meal::LUNCH);
+  utils::make<Entry>(rice.id(), 100.0, april_first + 3600, Meal::DINNER);
+  EXPECT_EQ(rollup.days(), std::vector<long long>{first_day});
+
+  lunch.set_timestamp(april_first + 86400);
+  EXPECT_EQ(changes.back(), (std::vector<long long>{first_day, first_day + 1}))
+      << "A moved entry must change the day it left and the day it is on.";
+  EXPECT_EQ(rollup.days(),
+            (std::vector<long long>{first_day, first_day + 1}));
+
+  rice.set_macronutrients(
+      Macronutrients(Fat(0), Carbohydrate(40, Fiber(0)), Protein(10)));
+  EXPECT_EQ(changes.back(), (std::vector<long long>{first_day, first_day + 1}))
+      << "A changed food must change every day it was eaten on once.";
+
+  utils::delete_storable(lunch);
+  EXPECT_EQ(changes.back(), std::vector<long long>{first_day + 1});
+  EXPECT_FALSE(rollup.has_entries(first_day + 1));
+  EXPECT_TRUE(rollup.has_entries(first_day));
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include "food/MacroTable.hpp"
+#include "food/Macronutrients.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+auto make_table() -> MacroTable
+{
+  MacroTable table;
+  table.push_back(1, Macronutrients(Fat(10), Carbohydrate(20, Fiber(5)),
+                                    Protein(30)));
+  table.push_back(2, Macronutrients(Fat(0), Carbohydrate(100, Fiber(0)),
+                                    Protein(0)));
+  table.push_back(3, Macronutrients());
+  return table;
+}
+
+} // namespace
+
+TEST(MacroTable, Kcal)
+{
+  auto const table = make_table();
+  auto const kcal = table.kcal();
+
+  ASSERT_EQ(kcal.size(), table.size());
+
+  // 9 * 10 + 4 * (20 - 5) + 2 * 5 + 4 * 30
+  EXPECT_DOUBLE_EQ(kcal[0], 280);
+  EXPECT_DOUBLE_EQ(kcal[1], 400);
+  EXPECT_DOUBLE_EQ(kcal[2], 0);
+
+  for (size_t i = 0; i < table.size(); ++i) {
+    EXPECT_DOUBLE_EQ(kcal[i], table.macronutrients(i).kcal())
+        << "Table kcal differs from Macronutrients::kcal for row " << i;
+  }
+}
+
+TEST(MacroTable, Totals)
+{
+  auto const table = make_table();
+  std::vector<double> const grams = {50, 200, 1000};
+
+  auto const totals = table.totals(grams);
+  EXPECT_DOUBLE_EQ(totals.fat(), 5);
+  EXPECT_DOUBLE_EQ(totals.carbohydrate(), 210);
+  EXPECT_DOUBLE_EQ(totals.fiber(), 2.5);
+  EXPECT_DOUBLE_EQ(totals.protein(), 15);
+
+  EXPECT_DOUBLE_EQ(table.total_kcal(grams), totals.kcal());
+}
+
+TEST(MacroTable, Ratios)
+{
+  auto const table = make_table();
+  auto const ratios = table.ratios();
+
+  EXPECT_DOUBLE_EQ(ratios.fat[0], 90.0 / 280);
+  EXPECT_DOUBLE_EQ(ratios.carbohydrate[0], 70.0 / 280);
+  EXPECT_DOUBLE_EQ(ratios.protein[0], 120.0 / 280);
+
+  EXPECT_DOUBLE_EQ(ratios.carbohydrate[1], 1);
+
+  EXPECT_DOUBLE_EQ(ratios.fat[2], 0) << "Foods without energy have no ratio";
+  EXPECT_DOUBLE_EQ(ratios.carbohydrate[2], 0);
+  EXPECT_DOUBLE_EQ(ratios.protein[2], 0);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,188 @@
+#include "food/MacroTable.hpp"
+#include "food/Macronutrients.hpp"
+#include "food/MealPlanner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+auto macros(double fat, double carbohydrate, double fiber, double protein)
+    -> Macronutrients
+{
+  return Macronutrients(Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)),
+                        Protein(protein));
+}
+
+/**
+ * @brief A few real foods among many random ones, ids 1 - 4 are chicken,
+ *        rice, olive oil and broccoli
+ */
+auto make_catalogue(size_t num_foods, double max_protein = 30) -> MacroTable
+{
+  MacroTable table;
+  table.push_back(1, macros(3.6, 0, 0, 31));
+  table.push_back(2, macros(0.3, 28, 0.4, 2.7));
+  table.push_back(3, macros(100, 0, 0, 0));
+  table.push_back(4, macros(0.4, 7, 2.6, 2.8));
+
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> random(0, 1);
+  for (size_t i = 4; i < num_foods; ++i) {
+    double const fat = 40 * random(generator) * random(generator);
+    double const carbohydrate = 80 * random(generator) * random(generator);
+    double const fiber = carbohydrate * 0.2 * random(generator);
+    double const protein =
+        max_protein * random(generator) * random(generator);
+    table.push_back(static_cast<int>(i + 1),
+                    macros(fat, carbohydrate, fiber, protein));
+  }
+
+  return table;
+}
+
+/**
+ * @brief What 200g chicken, 250g rice, 20g oil and 150g broccoli add up to
+ */
+auto dinner_targets() -> MacroTargets
+{
+  std::vector<double> const grams = {200, 250, 20, 150};
+  MacroTable const foods = make_catalogue(4);
+
+  MacroTargets targets;
+  targets.kcal = foods.total_kcal(grams);
+  auto const totals = foods.totals(grams);
+  targets.fat = totals.fat();
+  targets.carbohydrate = totals.carbohydrate();
+  targets.fiber = totals.fiber();
+  targets.protein = totals.protein();
+  return targets;
+}
+
+void expect_within_limits(MealPlan const &plan, MealLimits const &limits)
+{
+  EXPECT_LE(plan.portions.size(), limits.max_foods);
+  for (auto const &portion : plan.portions) {
+    EXPECT_GE(portion.grams, limits.min_grams - 1e-6);
+    EXPECT_LE(portion.grams, limits.max_grams + 1e-6);
+    EXPECT_EQ(std::count(begin(limits.excluded_foods),
+                         end(limits.excluded_foods), portion.food_id),
+              0)
+        << "Excluded food " << portion.food_id << " is in the plan.";
+  }
+}
+
+} // namespace
+
+TEST(MealPlanner, Candidates)
+{
+  // Without protein in the random foods, chicken is its purest source
+  MealPlanner const planner(make_catalogue(10000, 0));
+  auto const targets = dinner_targets();
+
+  MealLimits limits;
+  auto const rows = planner.candidates(targets, limits);
+  EXPECT_LE(rows.size(), limits.num_candidates);
+  EXPECT_TRUE(std::is_sorted(begin(rows), end(rows)));
+  EXPECT_TRUE(std::binary_search(begin(rows), end(rows), 0))
+      << "The purest source of a target must be a candidate.";
+
+  limits.excluded_foods = {1, 2};
+  auto const without = planner.candidates(targets, limits);
+  EXPECT_EQ(without.size(), limits.num_candidates);
+  EXPECT_FALSE(std::binary_search(begin(without), end(without), 0));
+  EXPECT_FALSE(std::binary_search(begin(without), end(without), 1));
+
+  EXPECT_TRUE(planner.candidates(MacroTargets(), limits).empty());
+}
+
+TEST(MealPlanner, ExactPlan)
+{
+  MealPlanner const planner(make_catalogue(10000));
+
+  MealLimits limits;
+  limits.max_foods = 4;
+  limits.first_within_tolerance = false;
+  limits.time_limit = std::chrono::milliseconds(10000);
+
+  auto const plan = planner.plan(dinner_targets(), limits);
+  EXPECT_TRUE(plan.optimal);
+  EXPECT_TRUE(plan.within_tolerance);
+  EXPECT_NEAR(plan.deviation, 0, 1e-6)
+      << "The foods the targets were made from are a plan without deviation.";
+  expect_within_limits(plan, limits);
+}
+
+TEST(MealPlanner, WithinTolerance)
+{
+  MealPlanner const planner(make_catalogue(100000));
+  auto const targets = dinner_targets();
+
+  MealLimits limits;
+  limits.max_foods = 3;
+  limits.excluded_foods = {1};
+  limits.time_limit = std::chrono::milliseconds(10000);
+
+  auto const plan = planner.plan(targets, limits);
+  ASSERT_FALSE(plan.portions.empty());
+  EXPECT_TRUE(plan.within_tolerance);
+  expect_within_limits(plan, limits);
+
+  // The totals of the plan are what it reports
+  EXPECT_NEAR(plan.macronutrients.protein(), targets.protein,
+              targets.protein * targets.tolerance + 1e-6);
+  EXPECT_NEAR(plan.kcal, targets.kcal, targets.kcal * targets.tolerance + 1e-6);
+  EXPECT_TRUE(std::is_sorted(begin(plan.portions), end(plan.portions),
+                             [](Portion const &a, Portion const &b) {
+                               return a.food_id < b.food_id;
+                             }));
+}
+
+TEST(MealPlanner, SingleThreadMatches)
+{
+  MealPlanner const planner(make_catalogue(5000));
+
+  MacroTargets targets;
+  targets.kcal = 650;
+  targets.protein = 45;
+  targets.fat = 20;
+
+  MealLimits limits;
+  limits.max_foods = 2;
+  limits.first_within_tolerance = false;
+  limits.time_limit = std::chrono::milliseconds(10000);
+
+  limits.num_threads = 1;
+  auto const serial = planner.plan(targets, limits);
+  limits.num_threads = 4;
+  auto const parallel = planner.plan(targets, limits);
+
+  ASSERT_TRUE(serial.optimal);
+  ASSERT_TRUE(parallel.optimal);
+  EXPECT_NEAR(serial.deviation, parallel.deviation, 1e-6)
+      << "Searching in parallel must find a plan as close.";
+  expect_within_limits(parallel, limits);
+}
+
+TEST(MealPlanner, Empty)
+{
+  MealPlanner const planner{MacroTable()};
+  EXPECT_TRUE(planner.plan(dinner_targets()).portions.empty());
+
+  MealPlanner const catalogue(make_catalogue(100));
+  MealLimits limits;
+  limits.max_foods = 0;
+  EXPECT_TRUE(catalogue.plan(dinner_targets(), limits).portions.empty());
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+#include "food/MicronutrientMatrix.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+// Columns of a small nutrient list
+uint32_t const vitamin_c = 0;
+uint32_t const iron = 1;
+uint32_t const calcium = 2;
+uint32_t const lysine = 3;
+
+auto make_matrix() -> MicronutrientMatrix
+{
+  MicronutrientMatrix matrix(4);
+  matrix.push_back(2, {{iron, 2}, {vitamin_c, 10}});
+  matrix.push_back(5, {});
+  matrix.push_back(7, {{calcium, 100}, {lysine, 0}, {calcium, 20}});
+  return matrix;
+}
+
+/**
+ * @brief An entry of the food log, only what totals_of reads
+ */
+struct Eaten {
+  int id;
+  double amount;
+
+  auto food_id() const -> int
+  {
+    return id;
+  }
+
+  auto grams() const -> double
+  {
+    return amount;
+  }
+};
+
+} // namespace
+
+TEST(MicronutrientMatrix, Storage)
+{
+  auto const matrix = make_matrix();
+
+  ASSERT_EQ(matrix.size(), 3);
+  EXPECT_EQ(matrix.num_nutrients(), 4);
+  EXPECT_EQ(matrix.num_amounts(), 3) << "Zeros are not stored";
+
+  EXPECT_EQ(matrix.row_offsets(), (std::vector<uint32_t>{0, 2, 2, 3}));
+  EXPECT_EQ(matrix.nutrients(), (std::vector<uint32_t>{vitamin_c, iron,
+                                                       calcium}));
+
+  EXPECT_FLOAT_EQ(matrix.amount(2, vitamin_c), 10);
+  EXPECT_FLOAT_EQ(matrix.amount(2, iron), 2);
+  EXPECT_FLOAT_EQ(matrix.amount(2, calcium), 0);
+  EXPECT_FLOAT_EQ(matrix.amount(7, calcium), 120)
+      << "Amounts of the same nutrient are added";
+  EXPECT_FLOAT_EQ(matrix.amount(3, iron), 0) << "Unknown foods have nothing";
+
+  EXPECT_EQ(matrix.row(5), 1);
+  EXPECT_EQ(matrix.row(6), matrix.size());
+}
+
+TEST(MicronutrientMatrix, Totals)
+{
+  auto const matrix = make_matrix();
+
+  auto const totals = matrix.totals(std::vector<double>{50, 1000, 200});
+  ASSERT_EQ(totals.size(), 4);
+  EXPECT_DOUBLE_EQ(totals[vitamin_c], 5);
+  EXPECT_DOUBLE_EQ(totals[iron], 1);
+  EXPECT_DOUBLE_EQ(totals[calcium], 240);
+  EXPECT_DOUBLE_EQ(totals[lysine], 0);
+
+  auto const day = matrix.totals(
+      std::vector<Portion>{{7, 50}, {2, 100}, {4, 300}, {2, 50}});
+  EXPECT_DOUBLE_EQ(day[vitamin_c], 15);
+  EXPECT_DOUBLE_EQ(day[iron], 3);
+  EXPECT_DOUBLE_EQ(day[calcium], 60);
+
+  std::vector<Eaten> const entries = {{7, 50}, {2, 150}};
+  EXPECT_EQ(matrix.totals_of(entries), day);
+}
+
+TEST(MicronutrientMatrix, Errors)
+{
+  auto matrix = make_matrix();
+
+  EXPECT_THROW(matrix.push_back(7, {}), std::runtime_error)
+      << "Ids must increase";
+  EXPECT_THROW(matrix.push_back(8, {{4, 1}}), std::runtime_error)
+      << "Nutrient out of range";
+  EXPECT_EQ(matrix.size(), 3);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
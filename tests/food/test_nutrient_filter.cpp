@@ -0,0 +1,214 @@
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/NutrientFilter.hpp"
+#include "food/NutrientIndex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+class Filter : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Food>();
+  }
+};
+
+auto macros(double fat, double carbohydrate, double fiber, double protein)
+    -> Macronutrients
+{
+  return Macronutrients(Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)),
+                        Protein(protein));
+}
+
+auto value(Macronutrients const &macros, Nutrient nutrient) -> double
+{
+  switch (nutrient) {
+  case Nutrient::FAT: return macros.fat();
+  case Nutrient::CARBOHYDRATE: return macros.carbohydrate();
+  case Nutrient::FIBER: return macros.fiber();
+  case Nutrient::PROTEIN: return macros.protein();
+  case Nutrient::KCAL: return macros.kcal();
+  }
+  return 0;
+}
+
+/**
+ * @return The ids of the foods within every range, by looking at every one
+ */
+auto brute_force(std::unordered_map<int, Macronutrients> const &foods,
+                 std::vector<NutrientRange> const &ranges) -> std::vector<int>
+{
+  std::vector<int> food_ids;
+  for (auto const &[food_id, macros] : foods) {
+    bool const within =
+        std::all_of(begin(ranges), end(ranges), [&](auto const &range) {
+          double const amount = value(macros, range.nutrient);
+          return amount >= range.min && amount <= range.max;
+        });
+    if (within) { food_ids.push_back(food_id); }
+  }
+
+  std::sort(begin(food_ids), end(food_ids));
+  return food_ids;
+}
+
+auto sorted(std::vector<int> food_ids) -> std::vector<int>
+{
+  std::sort(begin(food_ids), end(food_ids));
+  return food_ids;
+}
+
+} // namespace
+
+TEST(NutrientIndex, MatchesBruteForce)
+{
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<int> grams(0, 40);
+  auto const random_macros = [&] {
+    // Whole grams, so many foods have a value on the edge of a range
+    double const carbohydrate = grams(generator);
+    return macros(grams(generator), carbohydrate,
+                  std::floor(carbohydrate * grams(generator) / 80),
+                  grams(generator));
+  };
+
+  std::unordered_map<int, Macronutrients> foods;
+  std::vector<int> food_ids;
+  std::vector<Macronutrients> built;
+  for (int food_id = 1; food_id <= 20000; ++food_id) {
+    food_ids.push_back(food_id);
+    built.push_back(random_macros());
+    foods.emplace(food_id, built.back());
+  }
+
+  NutrientIndex index;
+  index.build(food_ids, built);
+
+  std::uniform_int_distribution<int> random_nutrient(0, 4);
+  std::uniform_int_distribution<int> random_bound(-5, 45);
+  auto const random_ranges = [&] {
+    std::vector<NutrientRange> ranges;
+    size_t const num_ranges = generator() % 4;
+    for (size_t i = 0; i < num_ranges; ++i) {
+      NutrientRange range;
+      range.nutrient = static_cast<Nutrient>(random_nutrient(generator));
+
+      // Energy goes up to 9 * 40 + 4 * 40 + 4 * 40
+      double const scale = range.nutrient == Nutrient::KCAL ? 15 : 1;
+      switch (generator() % 4) {
+      case 0: range.min = scale * random_bound(generator); break;
+      case 1: range.max = scale * random_bound(generator); break;
+      case 2:
+        range.min = scale * random_bound(generator);
+        range.max = range.min;
+        break;
+      default:
+        range.min = scale * random_bound(generator);
+        range.max = range.min + scale * random_bound(generator);
+      }
+      ranges.push_back(range);
+    }
+    return ranges;
+  };
+
+  // Changes past the points the tail is merged and the dead rows dropped
+  std::uniform_int_distribution<int> random_id(1, 30000);
+  for (size_t i = 0; i < 60000; ++i) {
+    int const food_id = random_id(generator);
+    if (i % 2 == 0 || (i > 30000 && i % 5 != 0)) {
+      EXPECT_EQ(index.erase(food_id), foods.erase(food_id) == 1);
+    } else {
+      auto const food_macros = random_macros();
+      index.insert(food_id, food_macros);
+      foods.insert_or_assign(food_id, food_macros);
+    }
+
+    if (i % 600 == 0) {
+      ASSERT_EQ(index.size(), foods.size());
+
+      auto const ranges = random_ranges();
+      ASSERT_EQ(sorted(index.filter(ranges)), brute_force(foods, ranges));
+    }
+  }
+}
+
+TEST(NutrientIndex, Bounds)
+{
+  NutrientIndex index;
+  index.insert(1, macros(5, 0, 0, 25));
+  index.insert(2, macros(5.5, 0, 0, 30));
+  index.insert(3, macros(0, 10, 3, 24.5));
+
+  EXPECT_EQ(sorted(index.filter({{Nutrient::PROTEIN, 25}})),
+            (std::vector<int>{1, 2}))
+      << "The least value must be included.";
+  EXPECT_EQ(sorted(index.filter({{Nutrient::FAT, 0, 5}})),
+            (std::vector<int>{1, 3}))
+      << "The most value must be included.";
+  EXPECT_EQ(index.filter({{Nutrient::PROTEIN, 25}, {Nutrient::FIBER, 3}}),
+            std::vector<int>{});
+  EXPECT_EQ(index.filter({{Nutrient::PROTEIN, 30, 25}}), std::vector<int>{});
+  EXPECT_EQ(index.filter({{Nutrient::KCAL, 145, 145}}),
+            std::vector<int>{1});
+  EXPECT_EQ(sorted(index.filter({})), (std::vector<int>{1, 2, 3}));
+
+  index.insert(2, macros(1, 0, 0, 10));
+  EXPECT_EQ(index.filter({{Nutrient::PROTEIN, 25}}), std::vector<int>{1})
+      << "A changed food must only be found by its new nutrients.";
+  EXPECT_TRUE(index.erase(1));
+  EXPECT_FALSE(index.erase(1));
+  EXPECT_EQ(sorted(index.filter({{Nutrient::FAT, 0, 5}})),
+            (std::vector<int>{2, 3}));
+  EXPECT_EQ(index.size(), 2u);
+}
+
+TEST_F(Filter, FollowsFoodTable)
+{
+  int const chicken = utils::make<Food>("chicken", macros(4, 0, 0, 31)).id();
+  int const salmon = utils::make<Food>("salmon", macros(13, 0, 0, 25)).id();
+  int const beans = utils::make<Food>("beans", macros(1, 47, 16, 21)).id();
+
+  NutrientFilter filter;
+  std::vector<NutrientRange> const lean = {{Nutrient::PROTEIN, 25},
+                                           {Nutrient::FAT, 0, 5}};
+  EXPECT_EQ(filter.filter(lean), std::vector<int>{chicken});
+  EXPECT_EQ(filter.filter({{Nutrient::FIBER, 3}}), std::vector<int>{beans});
+
+  int const tuna = utils::make<Food>("tuna", macros(1, 0, 0, 29)).id();
+  EXPECT_EQ(filter.filter(lean), (std::vector<int>{chicken, tuna}))
+      << "Made food is missing from the index.";
+
+  auto &all_food = utils::retrieve_all<Food>();
+  auto const compare = [](Food const &food, int id) { return food.id() < id; };
+  std::lower_bound(begin(all_food), end(all_food), salmon, compare)
+      ->set_macronutrients(macros(4, 0, 0, 25));
+  EXPECT_EQ(filter.filter(lean), (std::vector<int>{chicken, salmon, tuna}))
+      << "Updated food is not changed in the index.";
+
+  utils::delete_storable(
+      *std::lower_bound(begin(all_food), end(all_food), chicken, compare));
+  EXPECT_EQ(filter.filter(lean), (std::vector<int>{salmon, tuna}))
+      << "Deleted food is still in the index.";
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
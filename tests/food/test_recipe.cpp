@@ -0,0 +1,152 @@
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/Recipe.hpp"
+#include "food/RecipeGraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+class Recipes : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Recipe>();
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Recipe>();
+    utils::drop_table<Food>();
+  }
+};
+
+/**
+ * @brief Foods are looked up by id, a reference into the cache does not
+ *        survive the next make
+ */
+auto food_with(int id) -> Food &
+{
+  auto &all_food = utils::retrieve_all<Food>();
+  auto const compare = [](Food const &food, int id) { return food.id() < id; };
+  return *std::lower_bound(begin(all_food), end(all_food), id, compare);
+}
+
+auto carbs(int carbohydrate) -> Macronutrients
+{
+  return Macronutrients(Fat(0), Carbohydrate(carbohydrate, Fiber(0)),
+                        Protein(0));
+}
+
+} // namespace
+
+TEST_F(Recipes, Macronutrients)
+{
+  int const rice = utils::make<Food>("rice", carbs(80)).id();
+  int const beans = utils::make<Food>("beans", carbs(20)).id();
+
+  auto &bowl = make_recipe("bowl", {{rice, 100}, {beans, 300}});
+  EXPECT_EQ(bowl.name(), "bowl");
+  EXPECT_DOUBLE_EQ(bowl.grams(), 400);
+
+  // (80 + 60) carbohydrates in 400g
+  EXPECT_DOUBLE_EQ(food_with(bowl.food_id()).macronutrients().carbohydrate(),
+                   35);
+
+  bowl.set_ingredients({});
+  EXPECT_DOUBLE_EQ(food_with(bowl.food_id()).macronutrients().carbohydrate(),
+                   0)
+      << "A recipe without ingredients must have no macronutrients.";
+}
+
+TEST_F(Recipes, StoresIngredients)
+{
+  int const rice = utils::make<Food>("rice", carbs(80)).id();
+  int const beans = utils::make<Food>("beans", carbs(20)).id();
+
+  std::vector<Ingredient> const ingredients = {{rice, 100}, {beans, 12.5f}};
+  int const bowl = make_recipe("bowl", ingredients).id();
+  int const empty = make_recipe("empty", {}).id();
+
+  utils::clear_cache<Recipe>();
+
+  auto const &recipes = utils::retrieve_all<Recipe>();
+  ASSERT_EQ(recipes.size(), 2u);
+  EXPECT_EQ(recipes[0].id(), bowl);
+  ASSERT_EQ(recipes[0].ingredients().size(), ingredients.size());
+  for (size_t i = 0; i < ingredients.size(); ++i) {
+    EXPECT_EQ(recipes[0].ingredients()[i].food_id, ingredients[i].food_id);
+    EXPECT_EQ(recipes[0].ingredients()[i].grams, ingredients[i].grams);
+  }
+
+  EXPECT_EQ(recipes[1].id(), empty);
+  EXPECT_TRUE(recipes[1].ingredients().empty());
+}
+
+TEST_F(Recipes, RejectsCycles)
+{
+  int const rice = utils::make<Food>("rice", carbs(80)).id();
+
+  int const bowl_food = make_recipe("bowl", {{rice, 100}}).food_id();
+  int const meal = make_recipe("meal", {{bowl_food, 300}}).food_id();
+
+  auto &recipes = utils::retrieve_all<Recipe>();
+  EXPECT_THROW(recipes[0].set_ingredients({{meal, 100}}), std::runtime_error);
+  EXPECT_THROW(recipes[0].set_ingredients({{bowl_food, 100}}),
+               std::runtime_error);
+  EXPECT_THROW(make_recipe("nothing", {{-1, 100}}), std::runtime_error);
+
+  EXPECT_EQ(recipes[0].ingredients().size(), 1u)
+      << "A rejected change must leave the ingredients as they were.";
+}
+
+TEST_F(Recipes, RecomputesDependents)
+{
+  int const rice = utils::make<Food>("rice", carbs(80)).id();
+  int const beans = utils::make<Food>("beans", carbs(20)).id();
+  int const salsa = utils::make<Food>("salsa", carbs(10)).id();
+
+  int const bowl = make_recipe("bowl", {{rice, 100}, {beans, 100}}).food_id();
+  int const meal = make_recipe("meal", {{bowl, 200}, {rice, 200}}).food_id();
+  int const dip = make_recipe("dip", {{salsa, 100}}).food_id();
+
+  RecipeGraph graph;
+  EXPECT_EQ(graph.dependents(rice).size(), 2u);
+
+  food_with(beans).set_macronutrients(carbs(60));
+
+  // The bowl goes to 70, the meal has to see the new bowl
+  EXPECT_DOUBLE_EQ(food_with(bowl).macronutrients().carbohydrate(), 70);
+  EXPECT_DOUBLE_EQ(food_with(meal).macronutrients().carbohydrate(), 75);
+  EXPECT_DOUBLE_EQ(food_with(dip).macronutrients().carbohydrate(), 10);
+  EXPECT_EQ(graph.recomputations(), 2u)
+      << "Only the recipes made from the food must be recomputed.";
+
+  food_with(rice).set_macronutrients(carbs(40));
+  EXPECT_DOUBLE_EQ(food_with(bowl).macronutrients().carbohydrate(), 50);
+  EXPECT_DOUBLE_EQ(food_with(meal).macronutrients().carbohydrate(), 45);
+  EXPECT_EQ(graph.recomputations(), 4u)
+      << "A recipe reached twice must be recomputed once.";
+
+  utils::clear_cache<Food>();
+  EXPECT_DOUBLE_EQ(food_with(meal).macronutrients().carbohydrate(), 45)
+      << "Recomputed recipes must be written to the database.";
+
+  utils::delete_storable(food_with(beans));
+  EXPECT_DOUBLE_EQ(food_with(bowl).macronutrients().carbohydrate(), 20)
+      << "A deleted ingredient must count as nothing.";
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
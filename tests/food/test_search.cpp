@@ -0,0 +1,100 @@
+#include "food/Search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace food;
+
+namespace {
+
+auto make_names() -> std::vector<std::string>
+{
+  std::vector<std::string> names = {"Chicken Breast", "Chickpeas",
+                                    "Roast chicken thigh", "Cheddar",
+                                    "Rice"};
+  for (auto &name : names) {
+    name = fold_case(name);
+  }
+  return names;
+}
+
+auto never_cancelled() -> bool
+{
+  return false;
+}
+
+} // namespace
+
+TEST(Search, FoldCase)
+{
+  EXPECT_EQ(fold_case("Chicken BREAST 2%"), "chicken breast 2%");
+}
+
+TEST(Search, MatchesEveryWord)
+{
+  auto const names = make_names();
+
+  auto const result = search(names, "CHICK", nullptr, never_cancelled);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->query, "chick");
+  EXPECT_EQ(result->matches, (std::vector<size_t>{0, 1, 2}));
+
+  auto const both = search(names, "thigh  chicken", nullptr, never_cancelled);
+  ASSERT_TRUE(both);
+  EXPECT_EQ(both->matches, (std::vector<size_t>{2}));
+
+  auto const everything = search(names, "", nullptr, never_cancelled);
+  ASSERT_TRUE(everything);
+  EXPECT_EQ(everything->matches.size(), names.size());
+}
+
+TEST(Search, Refine)
+{
+  auto const names = make_names();
+  auto const first = search(names, "ch", nullptr, never_cancelled);
+  ASSERT_TRUE(first);
+
+  // Only the earlier matches are candidates, so a previous result that
+  // left a name out keeps it out
+  SearchResult previous = *first;
+  previous.matches = {1, 2};
+
+  auto const refined = search(names, "chicken", &previous, never_cancelled);
+  ASSERT_TRUE(refined);
+  EXPECT_EQ(refined->matches, (std::vector<size_t>{2}));
+
+  // A query that does not extend the previous one searches every name
+  auto const fresh = search(names, "rice", &previous, never_cancelled);
+  ASSERT_TRUE(fresh);
+  EXPECT_EQ(fresh->matches, (std::vector<size_t>{4}));
+}
+
+TEST(Search, Cancel)
+{
+  auto const names = make_names();
+  auto const result = search(names, "chick", nullptr, [] { return true; });
+  EXPECT_FALSE(result);
+}
+
+TEST(Search, Rank)
+{
+  auto const names = make_names();
+  auto const result = search(names, "chicken", nullptr, never_cancelled);
+  ASSERT_TRUE(result);
+
+  // Names starting with the first word come first
+  auto const ranked = rank(names, *result);
+  EXPECT_EQ(ranked, (std::vector<size_t>{0, 2}));
+
+  auto const later = search(names, "c", nullptr, never_cancelled);
+  ASSERT_TRUE(later);
+  EXPECT_EQ(rank(names, *later), (std::vector<size_t>{0, 1, 3, 2, 4}));
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,199 @@
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "food/ProfileTree.hpp"
+#include "food/SimilarFoods.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+class Similar : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Food>();
+  }
+};
+
+auto macros(double fat, double carbohydrate, double fiber, double protein)
+    -> Macronutrients
+{
+  return Macronutrients(Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)),
+                        Protein(protein));
+}
+
+/**
+ * @return The distances to the k closest profiles, by looking at every one
+ */
+auto brute_force(std::unordered_map<int, Profile> const &profiles,
+                 Profile const &query, size_t k) -> std::vector<float>
+{
+  std::vector<float> distances;
+  for (auto const &[food_id, profile] : profiles) {
+    float distance = 0;
+    for (size_t axis = 0; axis < profile.size(); ++axis) {
+      distance += (profile[axis] - query[axis]) * (profile[axis] - query[axis]);
+    }
+    distances.push_back(std::sqrt(distance));
+  }
+
+  std::sort(begin(distances), end(distances));
+  distances.resize(std::min(k, distances.size()));
+  return distances;
+}
+
+} // namespace
+
+TEST(ProfileTree, Profile)
+{
+  // Fiber is part of the carbohydrate
+  auto const bean = profile(macros(20, 60, 20, 20));
+  EXPECT_FLOAT_EQ(bean[0], 0.2f);
+  EXPECT_FLOAT_EQ(bean[1], 0.4f);
+  EXPECT_FLOAT_EQ(bean[2], 0.2f);
+  EXPECT_FLOAT_EQ(bean[3], 0.2f);
+
+  EXPECT_EQ(profile(Macronutrients()), Profile{})
+      << "A food without macronutrients must not divide by 0.";
+}
+
+TEST(ProfileTree, MatchesBruteForce)
+{
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<float> random(0, 1);
+  auto const random_profile = [&] {
+    Profile profile;
+    for (auto &value : profile) {
+      // Rounded so many profiles are equal on some macronutrient
+      value = std::round(random(generator) * 20) / 20;
+    }
+    return profile;
+  };
+
+  std::unordered_map<int, Profile> profiles;
+  std::vector<int> food_ids;
+  std::vector<Profile> built;
+  for (int food_id = 1; food_id <= 3000; ++food_id) {
+    food_ids.push_back(food_id);
+    built.push_back(random_profile());
+    profiles[food_id] = built.back();
+  }
+
+  ProfileTree tree;
+  tree.build(food_ids, built);
+
+  // Insertions, moves and removals, past the point the tree is rebalanced
+  std::uniform_int_distribution<int> random_id(1, 6000);
+  for (size_t i = 0; i < 8000; ++i) {
+    int const food_id = random_id(generator);
+    if (i % 3 == 0) {
+      EXPECT_EQ(tree.erase(food_id), profiles.erase(food_id) == 1);
+    } else {
+      auto const profile = random_profile();
+      tree.insert(food_id, profile);
+      profiles[food_id] = profile;
+    }
+  }
+  ASSERT_EQ(tree.size(), profiles.size());
+
+  for (size_t i = 0; i < 200; ++i) {
+    auto const query = random_profile();
+    size_t const k = 1 + i % 25;
+
+    auto const found = tree.nearest(query, k);
+    auto const expected = brute_force(profiles, query, k);
+    ASSERT_EQ(found.size(), expected.size());
+
+    for (size_t j = 0; j < found.size(); ++j) {
+      EXPECT_NEAR(found[j].distance, expected[j], 1e-5);
+
+      auto const stored = tree.find(found[j].food_id);
+      ASSERT_TRUE(stored.has_value());
+      EXPECT_EQ(*stored, profiles.at(found[j].food_id));
+    }
+  }
+
+  EXPECT_FALSE(tree.find(-1).has_value());
+}
+
+TEST(ProfileTree, EqualProfiles)
+{
+  ProfileTree tree;
+
+  // Can not be split, they share a bucket past its capacity
+  for (int food_id = 1; food_id <= 500; ++food_id) {
+    tree.insert(food_id, profile(macros(100, 0, 0, 0)));
+  }
+  tree.insert(501, profile(macros(0, 0, 0, 100)));
+
+  auto const found = tree.nearest(profile(macros(90, 0, 0, 10)), 3, 1);
+  ASSERT_EQ(found.size(), 3u);
+  EXPECT_EQ(found[0].food_id, 2) << "Ties must go to the smaller id.";
+  EXPECT_EQ(found[1].food_id, 3);
+  EXPECT_EQ(found[2].food_id, 4);
+
+  auto const protein = tree.nearest(profile(macros(0, 0, 0, 1)), 1);
+  ASSERT_EQ(protein.size(), 1u);
+  EXPECT_EQ(protein[0].food_id, 501);
+  EXPECT_FLOAT_EQ(protein[0].distance, 0);
+}
+
+TEST_F(Similar, FollowsFoodTable)
+{
+  int const chicken = utils::make<Food>("chicken", macros(4, 0, 0, 31)).id();
+  int const turkey = utils::make<Food>("turkey", macros(2, 0, 0, 29)).id();
+  int const rice = utils::make<Food>("rice", macros(0, 28, 0, 3)).id();
+
+  SimilarFoods similar;
+
+  auto found = similar.similar(chicken, 5);
+  ASSERT_EQ(found.size(), 2u) << "The food itself must not be similar.";
+  EXPECT_EQ(found[0].food_id, turkey);
+  EXPECT_EQ(found[1].food_id, rice);
+
+  int const tuna = utils::make<Food>("tuna", macros(4, 0, 0, 30)).id();
+  found = similar.similar(chicken, 1);
+  ASSERT_EQ(found.size(), 1u);
+  EXPECT_EQ(found[0].food_id, tuna) << "Made food is missing from the index.";
+
+  auto &all_food = utils::retrieve_all<Food>();
+  auto const compare = [](Food const &food, int id) { return food.id() < id; };
+  auto tuna_food =
+      std::lower_bound(begin(all_food), end(all_food), tuna, compare);
+  tuna_food->set_macronutrients(macros(0, 30, 2, 2));
+  EXPECT_EQ(similar.similar(chicken, 1)[0].food_id, turkey)
+      << "Updated food is not moved in the index.";
+  EXPECT_EQ(similar.similar(rice, 1)[0].food_id, tuna);
+
+  auto turkey_food =
+      std::lower_bound(begin(all_food), end(all_food), turkey, compare);
+  utils::delete_storable(*turkey_food);
+  found = similar.similar(chicken, 5);
+  EXPECT_EQ(found.size(), 2u);
+  EXPECT_TRUE(std::none_of(begin(found), end(found), [&](auto const &other) {
+    return other.food_id == turkey;
+  })) << "Deleted food is still in the index.";
+  EXPECT_TRUE(similar.similar(turkey, 1).empty());
+
+  EXPECT_EQ(similar.similar(macros(3, 0, 0, 30), 1)[0].food_id, chicken);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,152 @@
+#include "body/Date.hpp"
+#include "body/WeightEntry.hpp"
+#include "database/utils.hpp"
+#include "food/Entry.hpp"
+#include "food/Food.hpp"
+#include "food/IntakeRollup.hpp"
+#include "gui/plugins/chart/ChartModel.hpp"
+
+#include <QCoreApplication>
+
+#include <gtest/gtest.h>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+using gui::ChartModel;
+
+class Chart : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<body::WeightEntry>();
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<body::WeightEntry>();
+    utils::drop_table<Entry>();
+    utils::drop_table<Food>();
+  }
+};
+
+// 2019-04-01T00:00:00Z
+constexpr std::time_t april_first = 1554076800;
+
+/**
+ * @return The kcal in grams of food
+ */
+auto kcal(Food const &food, double grams) -> double
+{
+  return food.macronutrients().kcal() * grams / 100;
+}
+
+} // namespace
+
+TEST_F(Chart, ShowsWeighIns)
+{
+  int const first_day = body::to_epoch_day({2019, 4, 1});
+  utils::make<body::WeightEntry>(first_day + 2, 79.0f);
+  utils::make<body::WeightEntry>(first_day, 80.0f);
+  auto &weight = utils::make<body::WeightEntry>(first_day + 1, 79.5f);
+
+  ChartModel model;
+  model.setPixels(800);
+  model.setSeries("weight");
+
+  ASSERT_EQ(model.count(), 3);
+  EXPECT_DOUBLE_EQ(model.at(0).x(), first_day) << "Points must be by day.";
+  EXPECT_FLOAT_EQ(model.at(0).y(), 80.0f);
+  EXPECT_DOUBLE_EQ(
+      model.data(model.index(2), ChartModel::XRole).toDouble(), first_day + 2);
+  EXPECT_FLOAT_EQ(model.data(model.index(2), ChartModel::YRole).toFloat(),
+                  79.0f);
+  EXPECT_LT(model.xMin(), first_day);
+  EXPECT_GT(model.xMax(), first_day + 2);
+  EXPECT_FLOAT_EQ(model.yMin(), 79.0f);
+  EXPECT_FLOAT_EQ(model.yMax(), 80.0f);
+
+  weight.set_kg(81.0f);
+  EXPECT_FLOAT_EQ(model.at(1).y(), 81.0f) << "Changed weigh-in is stale.";
+
+  utils::make<body::WeightEntry>(first_day + 3, 78.5f);
+  ASSERT_EQ(model.count(), 4) << "New weigh-in is missing.";
+  EXPECT_FLOAT_EQ(model.at(3).y(), 78.5f);
+
+  model.setSeries("");
+  EXPECT_EQ(model.count(), 0);
+}
+
+TEST_F(Chart, AtMostOnePointPerPixel)
+{
+  int const first_day = body::to_epoch_day({2019, 4, 1});
+  utils::batch([&] {
+    for (int day = 0; day < 1000; ++day) {
+      utils::make<body::WeightEntry>(first_day + day,
+                                     80.0f + (day % 7) * 0.2f);
+    }
+  });
+
+  ChartModel model;
+  model.setPixels(100);
+  model.setSeries("weight");
+
+  // Plus the closest points outside the edges
+  EXPECT_GT(model.count(), 0);
+  EXPECT_LE(model.count(), 100 + 2);
+
+  model.setRange(first_day + 100, first_day + 149);
+  EXPECT_EQ(model.count(), 52) << "Few visible points must all be shown.";
+}
+
+TEST_F(Chart, IntakeFollowsDiary)
+{
+  auto &rice = utils::make<Food>(
+      "rice", Macronutrients(Fat(0), Carbohydrate(80, Fiber(0)), Protein(10)));
+  utils::make<Entry>(rice.id(), 200.0, april_first, Meal::LUNCH);
+  auto &dinner =
+      utils::make<Entry>(rice.id(), 100.0, april_first + 86400, Meal::DINNER);
+
+  long long const first_day = IntakeRollup().day_of(april_first);
+
+  ChartModel model;
+  model.setPixels(800);
+  model.setSeries("intake");
+
+  ASSERT_EQ(model.count(), 2);
+  EXPECT_DOUBLE_EQ(model.at(0).x(), first_day);
+  EXPECT_NEAR(model.at(0).y(), kcal(rice, 200), 1e-6);
+  EXPECT_NEAR(model.at(1).y(), kcal(rice, 100), 1e-6);
+
+  rice.set_macronutrients(
+      Macronutrients(Fat(0), Carbohydrate(40, Fiber(0)), Protein(10)));
+  EXPECT_NEAR(model.at(0).y(), kcal(rice, 200), 1e-6)
+      << "Days the changed food was eaten on were not updated.";
+  EXPECT_NEAR(model.at(1).y(), kcal(rice, 100), 1e-6);
+
+  utils::delete_storable(dinner);
+  ASSERT_EQ(model.count(), 1) << "Day without entries is still shown.";
+  EXPECT_DOUBLE_EQ(model.at(0).x(), first_day);
+
+  utils::make<Entry>(rice.id(), 50.0, april_first + 3600, Meal::SNACK);
+  EXPECT_NEAR(model.at(0).y(), kcal(rice, 250), 1e-6)
+      << "Day of a new entry was not updated.";
+
+  // The diary is no longer followed once another series is shown
+  model.setSeries("weight");
+  utils::make<Entry>(rice.id(), 100.0, april_first + 86400, Meal::DINNER);
+  EXPECT_EQ(model.count(), 0) << "Intake was shown in the weight series.";
+}
+
+auto main(int argc, char **argv) -> int
+{
+  // Qt models expect an application to exist
+  QCoreApplication application(argc, argv);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
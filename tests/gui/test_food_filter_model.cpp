@@ -0,0 +1,198 @@
+#include "gui/plugins/food/FoodFilterModel.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringListModel>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Runs the event loop until the filter published the result of every
+ *        change made so far
+ */
+void settle(gui::FoodFilterModel const &filter)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  // Changes of the source are searched 100 ms after them
+  while (timer.elapsed() < 200 || filter.searching()) {
+    ASSERT_LT(timer.elapsed(), 5000) << "Search did not finish.";
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    QThread::msleep(1);
+  }
+}
+
+/**
+ * @return The names shown by the filter, sorted
+ */
+auto shown_names(gui::FoodFilterModel const &filter)
+    -> std::vector<std::string>
+{
+  std::vector<std::string> names;
+  for (int row = 0; row < filter.rowCount(); ++row) {
+    names.push_back(filter.data(filter.index(row)).toString().toStdString());
+  }
+
+  std::sort(begin(names), end(names));
+  return names;
+}
+
+class Filter : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    source.setStringList(
+        {"chicken breast", "beef", "chicken thigh", "chickpea"});
+    filter.setSourceModel(&source);
+  }
+
+  /**
+   * @brief Replaces the query and waits for its result
+   */
+  void search(QString const &query)
+  {
+    filter.setQuery(query);
+    settle(filter);
+  }
+
+  QStringListModel source;
+  gui::FoodFilterModel filter;
+};
+
+} // namespace
+
+TEST_F(Filter, MatchesEveryWord)
+{
+  this->search("chicken");
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken thigh"}));
+
+  this->search("thigh chicken");
+  EXPECT_EQ(shown_names(filter), std::vector<std::string>{"chicken thigh"});
+
+  this->search("");
+  EXPECT_EQ(filter.rowCount(), source.rowCount())
+      << "An empty query must show every row.";
+}
+
+TEST_F(Filter, FirstWordStartsNameFirst)
+{
+  source.setStringList({"roast chicken", "chicken thigh"});
+  this->search("chicken");
+
+  ASSERT_EQ(filter.rowCount(), 2);
+  EXPECT_EQ(filter.data(filter.index(0)).toString(), "chicken thigh");
+  EXPECT_EQ(filter.sourceRow(0), 1);
+  EXPECT_EQ(filter.sourceRow(2), -1);
+}
+
+TEST_F(Filter, RefinesLastQuery)
+{
+  this->search("chi");
+  EXPECT_EQ(filter.rowCount(), 3);
+
+  this->search("chick");
+  EXPECT_EQ(filter.rowCount(), 3);
+
+  this->search("chicke");
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken thigh"}));
+
+  // The names changed since the last result, it must not be refined
+  source.insertRows(0, 1);
+  source.setData(source.index(0), "chicken wing");
+  this->search("chicken w");
+  EXPECT_EQ(shown_names(filter), std::vector<std::string>{"chicken wing"});
+}
+
+TEST_F(Filter, NewQueryCancelsOldOne)
+{
+  bool showed_beef = false;
+  QObject::connect(&filter, &QAbstractItemModel::modelReset, [&] {
+    auto const names = shown_names(filter);
+    if (std::find(begin(names), end(names), "beef") != end(names)) {
+      showed_beef = true;
+    }
+  });
+
+  filter.setQuery("e");
+  filter.setQuery("chicken");
+  settle(filter);
+
+  EXPECT_FALSE(showed_beef) << "Result of a cancelled query was shown.";
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken thigh"}));
+}
+
+TEST_F(Filter, InsertedRowsKeepShownFoods)
+{
+  this->search("chicken");
+
+  source.insertRows(0, 2);
+  source.setData(source.index(0), "chicken wing");
+  source.setData(source.index(1), "pork");
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken thigh"}))
+      << "Shown rows must keep showing the same foods until the next result.";
+
+  settle(filter);
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken thigh",
+                                      "chicken wing"}));
+}
+
+TEST_F(Filter, RemovedRowsLeaveRightAway)
+{
+  this->search("chicken");
+
+  source.removeRows(0, 2);
+  EXPECT_EQ(shown_names(filter), std::vector<std::string>{"chicken thigh"})
+      << "Removed rows must leave before the next result.";
+
+  settle(filter);
+  EXPECT_EQ(shown_names(filter), std::vector<std::string>{"chicken thigh"});
+}
+
+TEST_F(Filter, RenamedRowsAreSearched)
+{
+  this->search("chicken");
+
+  source.setData(source.index(1), "chicken liver");
+  settle(filter);
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken breast", "chicken liver",
+                                      "chicken thigh"}));
+
+  source.setData(source.index(0), "duck breast");
+  settle(filter);
+  EXPECT_EQ(shown_names(filter),
+            (std::vector<std::string>{"chicken liver", "chicken thigh"}));
+}
+
+TEST_F(Filter, SourceResetReadsEveryName)
+{
+  this->search("chicken");
+
+  source.setStringList({"chicken wing", "beef"});
+  EXPECT_EQ(filter.rowCount(), 0) << "Rows of the old source were kept.";
+
+  settle(filter);
+  EXPECT_EQ(shown_names(filter), std::vector<std::string>{"chicken wing"});
+}
+
+auto main(int argc, char **argv) -> int
+{
+  // Results are published through the event loop
+  QCoreApplication application(argc, argv);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
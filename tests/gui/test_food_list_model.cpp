@@ -0,0 +1,213 @@
+#include "database/utils.hpp"
+#include "food/Food.hpp"
+#include "gui/plugins/food/FoodListModel.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace food;
+namespace utils = database::utils;
+
+namespace {
+
+using gui::FoodListModel;
+
+class FoodList : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    utils::drop_table<Food>();
+  }
+
+  void TearDown() override
+  {
+    utils::drop_table<Food>();
+  }
+};
+
+auto macros(double fat, double carbohydrate, double fiber, double protein)
+    -> Macronutrients
+{
+  return Macronutrients(Fat(fat), Carbohydrate(carbohydrate, Fiber(fiber)),
+                        Protein(protein));
+}
+
+/**
+ * @brief Runs the event loop until the model read every food
+ */
+void wait_until_loaded(FoodListModel const &model)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  while (!model.loaded()) {
+    ASSERT_LT(timer.elapsed(), 10000) << "Foods were not loaded.";
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    QThread::msleep(1);
+  }
+}
+
+auto name_at(FoodListModel const &model, int row) -> std::string
+{
+  return model.data(model.index(row), FoodListModel::NameRole)
+      .toString()
+      .toStdString();
+}
+
+} // namespace
+
+TEST_F(FoodList, ShowsCachedFoods)
+{
+  utils::make<Food>("taco", macros(10, 20, 5, 15));
+  utils::make<Food>("burrito", macros(12, 40, 8, 20));
+
+  FoodListModel model;
+  EXPECT_TRUE(model.loaded()) << "Cached foods must not be read again.";
+  EXPECT_DOUBLE_EQ(model.progress(), 1);
+  ASSERT_EQ(model.rowCount(), 2);
+
+  auto const burrito = model.index(1);
+  EXPECT_EQ(name_at(model, 1), "burrito");
+  EXPECT_EQ(model.data(burrito, FoodListModel::KeyRole).toInt(), 2);
+  EXPECT_DOUBLE_EQ(model.data(burrito, FoodListModel::FatRole).toDouble(), 12);
+  EXPECT_DOUBLE_EQ(
+      model.data(burrito, FoodListModel::CarbohydrateRole).toDouble(), 40);
+  EXPECT_DOUBLE_EQ(model.data(burrito, FoodListModel::FiberRole).toDouble(),
+                   8);
+  EXPECT_DOUBLE_EQ(model.data(burrito, FoodListModel::ProteinRole).toDouble(),
+                   20);
+  EXPECT_FALSE(model.data(model.index(2), FoodListModel::NameRole).isValid());
+}
+
+TEST_F(FoodList, LoadsInChunks)
+{
+  // More than the first chunk, so rows arrive in more than one insert
+  int const num_foods = 1000;
+  utils::batch([&] {
+    for (int i = 0; i < num_foods; ++i) {
+      utils::make<Food>("food " + std::to_string(i), Macronutrients());
+    }
+  });
+  utils::clear_cache<Food>();
+
+  FoodListModel model;
+  EXPECT_FALSE(model.loaded());
+
+  int num_inserts = 0;
+  int num_inserted = 0;
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                   [&](QModelIndex const &, int first, int last) {
+                     EXPECT_EQ(first, num_inserted)
+                         << "Chunks must be appended in order.";
+                     ++num_inserts;
+                     num_inserted += last - first + 1;
+
+                     EXPECT_FALSE(model.flags(model.index(first)) &
+                                  Qt::ItemIsEditable)
+                         << "Foods must not be edited while they are read.";
+                   });
+
+  wait_until_loaded(model);
+
+  EXPECT_GT(num_inserts, 1);
+  ASSERT_EQ(model.rowCount(), num_foods);
+  EXPECT_DOUBLE_EQ(model.progress(), 1);
+  EXPECT_TRUE(utils::is_cached<Food>());
+  EXPECT_EQ(name_at(model, num_foods - 1),
+            "food " + std::to_string(num_foods - 1));
+}
+
+TEST_F(FoodList, UnfinishedLoadIsNotCached)
+{
+  utils::batch([&] {
+    for (int i = 0; i < 1000; ++i) {
+      utils::make<Food>("food " + std::to_string(i), Macronutrients());
+    }
+  });
+  utils::clear_cache<Food>();
+
+  {
+    FoodListModel model;
+  }
+
+  EXPECT_FALSE(utils::is_cached<Food>())
+      << "A partly read table must not pass for the whole table.";
+  EXPECT_EQ(utils::retrieve_all<Food>().size(), 1000);
+}
+
+TEST_F(FoodList, ReportsChangedFoods)
+{
+  utils::make<Food>("taco", Macronutrients());
+  utils::make<Food>("burrito", Macronutrients());
+
+  FoodListModel model;
+
+  int inserted_row = -1;
+  int changed_row = -1;
+  int removed_row = -1;
+  QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                   [&](QModelIndex const &, int first, int) {
+                     inserted_row = first;
+                   });
+  QObject::connect(&model, &QAbstractItemModel::dataChanged,
+                   [&](QModelIndex const &top_left, QModelIndex const &) {
+                     changed_row = top_left.row();
+                   });
+  QObject::connect(&model, &QAbstractItemModel::rowsRemoved,
+                   [&](QModelIndex const &, int first, int) {
+                     removed_row = first;
+                   });
+
+  auto &quesadilla = utils::make<Food>("quesadilla", Macronutrients());
+  EXPECT_EQ(inserted_row, 2);
+  ASSERT_EQ(model.rowCount(), 3);
+  EXPECT_EQ(name_at(model, 2), "quesadilla");
+
+  quesadilla.set_name("cheese quesadilla");
+  EXPECT_EQ(changed_row, 2);
+  EXPECT_EQ(name_at(model, 2), "cheese quesadilla");
+
+  utils::delete_storable(utils::retrieve_all<Food>()[1]);
+  EXPECT_EQ(removed_row, 1);
+  ASSERT_EQ(model.rowCount(), 2);
+  EXPECT_EQ(name_at(model, 0), "taco");
+  EXPECT_EQ(name_at(model, 1), "cheese quesadilla");
+}
+
+TEST_F(FoodList, SetDataEditsFoods)
+{
+  utils::make<Food>("taco", macros(10, 20, 5, 15));
+
+  FoodListModel model;
+  auto const taco = model.index(0);
+  EXPECT_TRUE(model.flags(taco) & Qt::ItemIsEditable);
+
+  EXPECT_TRUE(model.setData(taco, "fish taco", FoodListModel::NameRole));
+  EXPECT_TRUE(model.setData(taco, 11.5, FoodListModel::FatRole));
+  EXPECT_TRUE(model.setData(taco, 6, FoodListModel::FiberRole));
+  EXPECT_FALSE(model.setData(taco, "lots", FoodListModel::ProteinRole))
+      << "Quantities must be numbers.";
+  EXPECT_FALSE(model.setData(model.index(1), "nothing"));
+
+  utils::clear_cache<Food>();
+  auto const &all_food = utils::retrieve_all<Food>();
+  ASSERT_EQ(all_food.size(), 1);
+  EXPECT_EQ(all_food.front().name(), "fish taco");
+  EXPECT_DOUBLE_EQ(all_food.front().macronutrients().fat(), 11.5);
+  EXPECT_DOUBLE_EQ(all_food.front().macronutrients().fiber(), 6);
+  EXPECT_DOUBLE_EQ(all_food.front().macronutrients().protein(), 15);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  // Chunks are handed to the model through the event loop
+  QCoreApplication application(argc, argv);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include "tdee/Estimator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace tdee;
+
+namespace {
+
+/**
+ * @brief Someone with a known TDEE eating a fixed deficit, weighed with
+ *        +-1kg of water weight every day
+ */
+auto simulate(double real_tdee, double intake, size_t num_days)
+    -> std::vector<Day>
+{
+  std::mt19937 generator(7);
+  std::normal_distribution<double> water(0, 0.5);
+  std::normal_distribution<double> logging(0, 150);
+
+  std::vector<Day> days;
+  double weight = 90;
+
+  for (size_t i = 0; i < num_days; ++i) {
+    weight += (intake - real_tdee) / 7700;
+    days.push_back({intake + logging(generator), weight + water(generator)});
+  }
+
+  return days;
+}
+
+} // namespace
+
+TEST(Estimator, ConvergesToRealTdee)
+{
+  auto const days = simulate(2600, 2100, 180);
+
+  Estimator estimator;
+  auto const estimates = estimator.backfill(days);
+
+  ASSERT_EQ(estimates.size(), days.size());
+  EXPECT_EQ(estimator.days(), days.size());
+  EXPECT_NEAR(estimator.estimate().tdee, 2600, 150)
+      << "Estimate did not converge to the real TDEE.";
+  EXPECT_LT(estimator.estimate().variance, Settings().initial_variance)
+      << "Data must make the estimate more certain.";
+}
+
+TEST(Estimator, BackfillMatchesUpdate)
+{
+  auto const days = simulate(2300, 2500, 60);
+
+  Estimator incremental;
+  for (auto const &day : days) {
+    incremental.update(day);
+  }
+
+  auto const estimates = Estimator().backfill(days);
+  EXPECT_DOUBLE_EQ(estimates.back().tdee, incremental.estimate().tdee);
+  EXPECT_DOUBLE_EQ(estimates.back().trend_weight,
+                   incremental.estimate().trend_weight);
+}
+
+TEST(Estimator, MissingDays)
+{
+  auto days = simulate(2600, 2100, 180);
+
+  // Weigh-ins only twice a week, and a week that was not logged
+  for (size_t i = 0; i < days.size(); ++i) {
+    if (i % 7 != 0 && i % 7 != 3) { days[i].weight.reset(); }
+    if (i >= 50 && i < 57) { days[i].intake.reset(); }
+  }
+
+  Estimator estimator;
+  estimator.backfill(days);
+
+  EXPECT_NEAR(estimator.estimate().tdee, 2600, 200)
+      << "Estimate did not converge with sparse weigh-ins.";
+}
+
+TEST(Estimator, NoDataKeepsPrior)
+{
+  Estimator estimator;
+  estimator.update({2000.0, std::nullopt});
+  estimator.update({std::nullopt, 80.0});
+
+  EXPECT_DOUBLE_EQ(estimator.estimate().tdee, Settings().initial_tdee)
+      << "A single weigh-in carries no energy balance.";
+  EXPECT_DOUBLE_EQ(estimator.estimate().trend_weight, 80);
+}
+
+auto main(int argc, char **argv) -> int
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
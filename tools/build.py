@@ -102,12 +102,21 @@ if __name__ == "__main__":
         "the build directory type in 'make test'.",
     )
 
+    parser.add_argument(
+        "-b",
+        "--enable-benchmarks",
+        action="store_true",
+        help="Build tracker with benchmarks enabled.\nIn "
+        "the build directory type in 'make run_benchmarks'.",
+    )
+
     options = parser.parse_args()
     options.build_folder += options.profile
 
     build_path = os.path.join(PROJECT_PATH, options.build_folder)
 
-    if options.enable_tests or options.enable_documentation:
+    if (options.enable_tests or options.enable_documentation
+            or options.enable_benchmarks):
         options.configure = True
 
     if should_configure(options):
@@ -137,6 +146,12 @@ if __name__ == "__main__":
                 "enable_tests=" + str(options.enable_tests),
             ]
 
+        if options.enable_benchmarks:
+            command = command + [
+                "--options",
+                "enable_benchmarks=" + str(options.enable_benchmarks),
+            ]
+
         execute_command(command)
 
     command = ["conan", "build", PROJECT_PATH, "--build-folder", build_path]